@@ -832,13 +832,19 @@ void ChCollisionModelBullet::GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const
 void ChCollisionModelBullet::SyncPosition() {
     ChCoordsys<> mcsys = mcontactable->GetCsysForCollisionModel();
 
-    bt_collision_object->getWorldTransform().setOrigin(
-        cbtVector3((cbtScalar)mcsys.pos.x(), (cbtScalar)mcsys.pos.y(), (cbtScalar)mcsys.pos.z()));
     const ChMatrix33<>& rA(mcsys.rot);
     cbtMatrix3x3 basisA((cbtScalar)rA(0, 0), (cbtScalar)rA(0, 1), (cbtScalar)rA(0, 2), (cbtScalar)rA(1, 0),
                         (cbtScalar)rA(1, 1), (cbtScalar)rA(1, 2), (cbtScalar)rA(2, 0), (cbtScalar)rA(2, 1),
                         (cbtScalar)rA(2, 2));
-    bt_collision_object->getWorldTransform().setBasis(basisA);
+    cbtTransform transform(basisA,
+                           cbtVector3((cbtScalar)mcsys.pos.x(), (cbtScalar)mcsys.pos.y(), (cbtScalar)mcsys.pos.z()));
+    bool moved = !(transform == bt_collision_object->getWorldTransform());
+    bt_collision_object->setWorldTransform(transform);
+
+    // Let Bullet skip the AABB update and the narrowphase between pairs of inactive (fixed or sleeping) objects.
+    // An inactive object that was moved is flagged as active, so that the collision system refreshes its AABB.
+    bool active = mcontactable->IsContactActive() || moved;
+    bt_collision_object->setActivationState(active ? ACTIVE_TAG : ISLAND_SLEEPING);
 }
 
 bool ChCollisionModelBullet::SetSphereRadius(double coll_radius, double out_envelope) {
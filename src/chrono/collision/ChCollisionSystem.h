@@ -213,6 +213,14 @@ class ChApi ChCollisionSystem {
         /*int version =*/ marchive.VersionRead<ChCollisionSystem>();
     }
 
+    /// Write the collision detection data carried over from one step to the next (e.g., persistent contact data).
+    /// Used in writing a checkpoint of the system state (see ChSystem::CheckpointOUT).
+    virtual void CheckpointOUT(ChArchiveOut& marchive) {}
+
+    /// Read the collision detection data carried over from one step to the next.
+    /// Used in restoring the system state from a checkpoint (see ChSystem::CheckpointIN).
+    virtual void CheckpointIN(ChArchiveIn& marchive) {}
+
     /// Set associated Chrono system
     void SetSystem(ChSystem* sys) { m_system = sys; }
 
@@ -44,6 +44,10 @@ ChCollisionSystemBullet::ChCollisionSystemBullet() : m_debug_drawer(nullptr) {
     bt_broadphase = new cbtDbvtBroadphase();
     bt_collision_world = new cbtCollisionWorld(bt_dispatcher, bt_broadphase, bt_collision_configuration);
 
+    // Only refresh the AABBs of active objects at each run. Inactive (fixed or sleeping) objects are flagged as active
+    // when their position changes (see ChCollisionModelBullet::SyncPosition).
+    bt_collision_world->setForceUpdateAllAabbs(false);
+
     // custom collision for cylinder-sphere case, for improved precision
     ////cbtCollisionAlgorithmCreateFunc* m_collision_sph_cyl = new cbtSphereCylinderCollisionAlgorithm::CreateFunc;
     ////cbtCollisionAlgorithmCreateFunc* m_collision_cyl_sph = new cbtSphereCylinderCollisionAlgorithm::CreateFunc;
@@ -153,6 +157,42 @@ void ChCollisionSystemBullet::Run() {
         bt_collision_world->performDiscreteCollisionDetection();
     }
 
+    // After a restart from a checkpoint, transfer the restored reaction caches to the new contact points
+    if (!m_restart_reactions.empty()) {
+        int numManifolds = bt_dispatcher->getNumManifolds();
+        for (int i = 0; i < numManifolds; i++) {
+            cbtPersistentManifold* contactManifold = bt_dispatcher->getManifoldByIndexInternal(i);
+            int idA = contactManifold->getBody0()->getWorldArrayIndex();
+            int idB = contactManifold->getBody1()->getWorldArrayIndex();
+            cbtScalar threshold = contactManifold->getContactBreakingThreshold();
+            for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+                cbtManifoldPoint& pt = contactManifold->getContactPoint(j);
+                // Nearest restored point of the same pair, as in cbtPersistentManifold::getCacheEntry
+                cbtScalar shortestDist = threshold * threshold;
+                int nearestPoint = -1;
+                for (size_t k = 0; k < m_restart_pairs.size() / 2; k++) {
+                    if (m_restart_pairs[2 * k] != idA || m_restart_pairs[2 * k + 1] != idB)
+                        continue;
+                    cbtVector3 localA((cbtScalar)m_restart_points[3 * k + 0], (cbtScalar)m_restart_points[3 * k + 1],
+                                      (cbtScalar)m_restart_points[3 * k + 2]);
+                    cbtVector3 diffA = localA - pt.m_localPointA;
+                    cbtScalar distToManiPoint = diffA.dot(diffA);
+                    if (distToManiPoint < shortestDist) {
+                        shortestDist = distToManiPoint;
+                        nearestPoint = (int)k;
+                    }
+                }
+                if (nearestPoint >= 0) {
+                    for (int r = 0; r < 6; r++)
+                        pt.reactions_cache[r] = m_restart_reactions[6 * nearestPoint + r];
+                }
+            }
+        }
+        m_restart_pairs.clear();
+        m_restart_points.clear();
+        m_restart_reactions.clear();
+    }
+
     // int numPairs = bt_collision_world->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
     // GetLog() << "tot pairs: " << numPairs << "\n";
 }
@@ -375,6 +415,39 @@ void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (cbtScalar)threshold;
 }
 
+void ChCollisionSystemBullet::CheckpointOUT(ChArchiveOut& marchive) {
+    marchive.VersionWrite<ChCollisionSystemBullet>();
+
+    // Current contact points: pair of collision objects, local point on the first object and reaction cache.
+    std::vector<int> pairs;
+    std::vector<double> points;
+    std::vector<float> reactions;
+    int numManifolds = bt_dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; i++) {
+        cbtPersistentManifold* contactManifold = bt_dispatcher->getManifoldByIndexInternal(i);
+        for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+            const cbtManifoldPoint& pt = contactManifold->getContactPoint(j);
+            pairs.push_back(contactManifold->getBody0()->getWorldArrayIndex());
+            pairs.push_back(contactManifold->getBody1()->getWorldArrayIndex());
+            points.push_back(pt.m_localPointA.getX());
+            points.push_back(pt.m_localPointA.getY());
+            points.push_back(pt.m_localPointA.getZ());
+            reactions.insert(reactions.end(), pt.reactions_cache, pt.reactions_cache + 6);
+        }
+    }
+    marchive << CHNVP(pairs);
+    marchive << CHNVP(points);
+    marchive << CHNVP(reactions);
+}
+
+void ChCollisionSystemBullet::CheckpointIN(ChArchiveIn& marchive) {
+    /*int version =*/marchive.VersionRead<ChCollisionSystemBullet>();
+
+    marchive >> CHNVP(m_restart_pairs, "pairs");
+    marchive >> CHNVP(m_restart_points, "points");
+    marchive >> CHNVP(m_restart_reactions, "reactions");
+}
+
 class ChDebugDrawer : public cbtIDebugDraw {
   public:
     explicit ChDebugDrawer(ChCollisionSystem::VisualizationCallback* vis) : m_debugMode(0), m_vis(vis) {}
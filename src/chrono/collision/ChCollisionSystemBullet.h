@@ -114,6 +114,18 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     // Call this function only once, before running the simulation.
     static void SetContactBreakingThreshold(double threshold);
 
+    /// Write the reaction caches of the current contact points (used for warm starting the solver).
+    /// Used in writing a checkpoint of the system state (see ChSystem::CheckpointOUT).
+    virtual void CheckpointOUT(ChArchiveOut& marchive) override;
+
+    /// Read the reaction caches of the contact points. Since the Bullet persistent manifolds are not restored, these
+    /// are transferred at the next Run() to the new contact points, matched as Bullet matches the points of a
+    /// persistent manifold from one pass to the next (same pair of collision objects, nearest local point on the
+    /// first object within the contact breaking threshold). This reproduces the warm start of contacts that persist
+    /// across the checkpoint, but not the history of manifolds with multiple points from different passes.
+    /// Used in restoring the system state from a checkpoint (see ChSystem::CheckpointIN).
+    virtual void CheckpointIN(ChArchiveIn& marchive) override;
+
   private:
     /// Perform a ray-hit test with all collision models. This version allows specifying the Bullet
     /// collision filter group and mask (see cbtBroadphaseProxy::CollisionFilterGroups).
@@ -149,6 +161,10 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     cbtCollisionAlgorithmCreateFunc* m_emptyCreateFunc;
 
     cbtIDebugDraw* m_debug_drawer;
+
+    std::vector<int> m_restart_pairs;         ///< collision object indices of restored contact points (2 per point)
+    std::vector<double> m_restart_points;     ///< local points on the first object of restored contacts (3 per point)
+    std::vector<float> m_restart_reactions;  ///< reaction caches of restored contact points (6 per point)
 };
 
 /// @} collision_bullet
@@ -17,14 +17,23 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChSystem.h"
 #include "chrono/collision/ChCollisionSystemChrono.h"
 #include "chrono/collision/chrono/ChRayTest.h"
+#include "chrono/utils/ChProfiler.h"
 
 namespace chrono {
 namespace collision {
 
-ChCollisionSystemChrono::ChCollisionSystemChrono() : use_aabb_active(false) {
+ChCollisionSystemChrono::ChCollisionSystemChrono()
+    : use_aabb_active(false),
+      use_persistence(false),
+      persistence_tol(0.01),
+      num_persistent_contacts(0),
+      m_nthreads_broad(0),
+      m_nthreads_narrow(0) {
     // Create the shared data structure with own state data
     cd_data = chrono_types::make_shared<ChCollisionData>(true);
     cd_data->collision_envelope = ChCollisionModel::GetDefaultSuggestedEnvelope();
@@ -39,6 +48,7 @@ ChCollisionSystemChrono::~ChCollisionSystemChrono() {}
 
 void ChCollisionSystemChrono::SetEnvelope(double envelope) {
     cd_data->collision_envelope = real(envelope);
+    narrowphase.ClearCoherenceCache();
 }
 
 void ChCollisionSystemChrono::SetBroadphaseGridResolution(const ChVector<int>& num_bins) {
@@ -56,8 +66,45 @@ void ChCollisionSystemChrono::SetBroadphaseGridDensity(double density) {
     broadphase.grid_type = ChBroadphase::GridType::FIXED_DENSITY;
 }
 
+void ChCollisionSystemChrono::SetBroadphaseMethod(ChBroadphase::Method method) {
+    broadphase.method = method;
+}
+
+void ChCollisionSystemChrono::SetBroadphaseTreeMargin(double margin) {
+    broadphase.tree.SetMargin(real(margin));
+}
+
 void ChCollisionSystemChrono::SetNarrowphaseAlgorithm(ChNarrowphase::Algorithm algorithm) {
     narrowphase.algorithm = algorithm;
+    narrowphase.ClearCoherenceCache();
+}
+
+void ChCollisionSystemChrono::EnableNarrowphaseCoherence(bool val) {
+    narrowphase.EnableCoherence(val);
+}
+
+void ChCollisionSystemChrono::SetNarrowphaseCoherenceTolerances(double pos_tol, double rot_tol) {
+    narrowphase.SetCoherenceTolerances(real(pos_tol), real(rot_tol));
+}
+
+unsigned int ChCollisionSystemChrono::GetNumNarrowphaseReusedPairs() const {
+    return narrowphase.GetNumReusedPairs();
+}
+
+void ChCollisionSystemChrono::Clear() {
+    narrowphase.ClearCoherenceCache();
+
+    // Discard persistent contacts (keep the reaction caches, as these may still be referenced by contacts)
+    persist_keys.clear();
+    persist_order.clear();
+}
+
+void ChCollisionSystemChrono::EnableContactPersistence(bool val) {
+    use_persistence = val;
+}
+
+void ChCollisionSystemChrono::SetContactPersistenceTolerance(double tol) {
+    persistence_tol = real(tol);
 }
 
 void ChCollisionSystemChrono::EnableActiveBoundingBox(const ChVector<>& aabb_min, const ChVector<>& aabb_max) {
@@ -73,6 +120,11 @@ void ChCollisionSystemChrono::SetNumThreads(int nthreads) {
 #endif
 }
 
+void ChCollisionSystemChrono::SetPhaseNumThreads(int nthreads_broad, int nthreads_narrow) {
+    m_nthreads_broad = nthreads_broad;
+    m_nthreads_narrow = nthreads_narrow;
+}
+
 // -----------------------------------------------------------------------------
 
 bool ChCollisionSystemChrono::GetActiveBoundingBox(ChVector<>& aabb_min, ChVector<>& aabb_max) const {
@@ -349,6 +401,16 @@ void ChCollisionSystemChrono::PostProcess() {
 void ChCollisionSystemChrono::Run() {
     ResetTimers();
 
+#ifdef _OPENMP
+    // Number of OpenMP threads in effect at entry (restored on exit, if changed for the broadphase or narrowphase)
+    int nthreads = omp_get_max_threads();
+#endif
+
+    // In deterministic mode, report the contacts in canonical order (independent of the number of threads)
+    bool deterministic = m_system && m_system->IsDeterministicModeEnabled();
+    broadphase.deterministic = deterministic;
+    broadphase.tree.SetDeterministic(deterministic);
+
     if (use_aabb_active) {
         std::vector<char>& active = *cd_data->state_data.active_rigid;
         const std::vector<char>& collide = *cd_data->state_data.collide_rigid;
@@ -367,15 +429,134 @@ void ChCollisionSystemChrono::Run() {
     }
 
     // Broadphase
-    m_timer_broad.start();
-    GenerateAABB();
-    broadphase.Process();
-    m_timer_broad.stop();
+    {
+        CH_PROFILE_ZONE("Collision_broadphase");
+#ifdef _OPENMP
+        if (m_nthreads_broad > 0)
+            omp_set_num_threads(m_nthreads_broad);
+#endif
+        m_timer_broad.start();
+        GenerateAABB();
+        broadphase.Process();
+        m_timer_broad.stop();
+    }
 
     // Narrowphase
-    m_timer_narrow.start();
-    narrowphase.Process();
-    m_timer_narrow.stop();
+    {
+        CH_PROFILE_ZONE("Collision_narrowphase");
+#ifdef _OPENMP
+        if (m_nthreads_narrow > 0)
+            omp_set_num_threads(m_nthreads_narrow);
+#endif
+        m_timer_narrow.start();
+        narrowphase.Process();
+        if (use_persistence)
+            UpdateContactPersistence();
+        m_timer_narrow.stop();
+    }
+
+#ifdef _OPENMP
+    if (m_nthreads_broad > 0 || m_nthreads_narrow > 0)
+        omp_set_num_threads(nthreads);
+#endif
+}
+
+void ChCollisionSystemChrono::UpdateContactPersistence() {
+    const uint num_contacts = cd_data->num_rigid_contacts;
+    const auto& sids = cd_data->contact_shapeIDs;
+    const auto& ptA = cd_data->cpta_rigid_rigid;
+    const auto& shape_pos = cd_data->shape_data.obj_data_A_global;
+    const auto& shape_rot = cd_data->shape_data.obj_data_R_global;
+
+    // Contacts from the last pass become the reference for matching.
+    // Note that contacts reported at the last pass still point to the (now previous) reaction cache.
+    persist_keys_prev.swap(persist_keys);
+    persist_order_prev.swap(persist_order);
+    persist_points_prev.swap(persist_points);
+    persist_reactions_prev.swap(persist_reactions);
+
+    persist_points.resize(num_contacts);
+    persist_reactions.assign(6 * num_contacts, 0.0f);
+
+    const real tol2 = persistence_tol * persistence_tol;
+    uint num_matched = 0;
+
+#pragma omp parallel for reduction(+ : num_matched)
+    for (int i = 0; i < (signed)num_contacts; i++) {
+        // Contact point, expressed in the frame of the first shape
+        long long key = sids[i];
+        int s1 = int(key >> 32);
+        real3 point = RotateT(ptA[i] - shape_pos[s1], shape_rot[s1]);
+        persist_points[i] = point;
+
+        // Find the closest previous contact between the same shapes
+        auto range = std::equal_range(persist_keys_prev.begin(), persist_keys_prev.end(), key);
+        int match = -1;
+        real min_dist2 = tol2;
+        for (auto it = range.first; it != range.second; ++it) {
+            uint j = persist_order_prev[it - persist_keys_prev.begin()];
+            real dist2 = Length2(point - persist_points_prev[j]);
+            if (dist2 <= min_dist2) {
+                min_dist2 = dist2;
+                match = (int)j;
+            }
+        }
+
+        if (match >= 0) {
+            std::copy_n(&persist_reactions_prev[6 * match], 6, &persist_reactions[6 * i]);
+            num_matched++;
+        }
+    }
+
+    num_persistent_contacts = num_matched;
+
+    // Sort the current contacts by shape pair IDs for matching at the next pass
+    persist_keys.assign(sids.begin(), sids.begin() + num_contacts);
+    persist_order.resize(num_contacts);
+    Thrust_Sequence(persist_order);
+    if (m_system && m_system->IsDeterministicModeEnabled())
+        thrust::stable_sort_by_key(THRUST_PAR persist_keys.begin(), persist_keys.end(), persist_order.begin());
+    else
+        Thrust_Sort_By_Key(persist_keys, persist_order);
+}
+
+void ChCollisionSystemChrono::CheckpointOUT(ChArchiveOut& marchive) {
+    marchive.VersionWrite<ChCollisionSystemChrono>();
+
+    // Contacts from the last pass (reference for matching at the next pass) and their current reactions.
+    std::vector<unsigned long long> keys(persist_keys.begin(), persist_keys.end());
+    std::vector<unsigned int> order(persist_order.begin(), persist_order.end());
+    std::vector<double> points(3 * persist_points.size());
+    for (size_t i = 0; i < persist_points.size(); i++) {
+        points[3 * i + 0] = persist_points[i].x;
+        points[3 * i + 1] = persist_points[i].y;
+        points[3 * i + 2] = persist_points[i].z;
+    }
+    marchive << CHNVP(keys);
+    marchive << CHNVP(order);
+    marchive << CHNVP(points);
+    marchive << CHNVP(persist_reactions, "reactions");
+}
+
+void ChCollisionSystemChrono::CheckpointIN(ChArchiveIn& marchive) {
+    /*int version =*/marchive.VersionRead<ChCollisionSystemChrono>();
+
+    std::vector<unsigned long long> keys;
+    std::vector<unsigned int> order;
+    std::vector<double> points;
+    marchive >> CHNVP(keys);
+    marchive >> CHNVP(order);
+    marchive >> CHNVP(points);
+    marchive >> CHNVP(persist_reactions, "reactions");
+
+    persist_keys.assign(keys.begin(), keys.end());
+    persist_order.assign(order.begin(), order.end());
+    persist_points.resize(points.size() / 3);
+    for (size_t i = 0; i < persist_points.size(); i++)
+        persist_points[i] = real3(real(points[3 * i + 0]), real(points[3 * i + 1]), real(points[3 * i + 2]));
+
+    // Discard the narrowphase cache
+    narrowphase.ClearCoherenceCache();
 }
 
 // -----------------------------------------------------------------------------
@@ -392,9 +573,12 @@ void ChCollisionSystemChrono::ReportContacts(ChContactContainer* container) {
     const auto& sids = cd_data->contact_shapeIDs;          // global IDs of shapes in contact
     const auto& sindex = cd_data->shape_data.local_rigid;  // collision model indexes of shapes in contact
 
-    // Loop over all current contacts, create the cinfo structure and add contact to the container.
-    // Note that inclusions in the contact container cannot be done in parallel.
-    for (uint i = 0; i < cd_data->num_rigid_contacts; i++) {
+    // Loop over all current contacts and create the cinfo structures.
+    // The contacts are then added to the container as a batch (which the container may process in parallel).
+    contact_info.resize(cd_data->num_rigid_contacts);
+
+#pragma omp parallel for num_threads(m_system->GetNumthreadsCollision())
+    for (int i = 0; i < (int)cd_data->num_rigid_contacts; i++) {
         auto b1 = bids[i].x;                  // global IDs of bodies in contact
         auto b2 = bids[i].y;                  //
         auto s1 = int(sids[i] >> 32);         // global IDs of shapes in contact
@@ -402,7 +586,7 @@ void ChCollisionSystemChrono::ReportContacts(ChContactContainer* container) {
         auto s1_index = sindex[s1];           // collision model indexes of shapes in contact
         auto s2_index = sindex[s2];           //
 
-        ChCollisionInfo cinfo;
+        ChCollisionInfo& cinfo = contact_info[i];
         cinfo.modelA = blist[b1]->GetCollisionModel().get();
         cinfo.modelB = blist[b2]->GetCollisionModel().get();
         cinfo.shapeA = cinfo.modelA->GetShape(s1_index).get();
@@ -412,16 +596,21 @@ void ChCollisionSystemChrono::ReportContacts(ChContactContainer* container) {
         cinfo.vpB = ToChVector(cd_data->cptb_rigid_rigid[i]);
         cinfo.distance = cd_data->dpth_rigid_rigid[i];
         cinfo.eff_radius = cd_data->erad_rigid_rigid[i];
+        cinfo.reaction_cache = use_persistence ? &persist_reactions[6 * i] : nullptr;
+    }
 
-        // Execute user custom callback, if any
-        bool add_contact = true;
-        if (this->narrow_callback)
-            add_contact = this->narrow_callback->OnNarrowphase(cinfo);
-
-        if (add_contact)
-            container->AddContact(cinfo);
+    // Execute user custom callback, if any (sequentially, since the callback may not be thread safe)
+    if (this->narrow_callback) {
+        size_t num_added = 0;
+        for (size_t i = 0; i < contact_info.size(); i++) {
+            if (this->narrow_callback->OnNarrowphase(contact_info[i]))
+                contact_info[num_added++] = contact_info[i];
+        }
+        contact_info.resize(num_added);
     }
 
+    container->AddContacts(contact_info);
+
     container->EndAddContact();
 }
 
@@ -67,12 +67,50 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     /// By default, a fixed number of bins is used (see SetBroadphaseGridResolution).
     void SetBroadphaseGridDensity(double density);
 
+    /// Set the broadphase method (default: ChBroadphase::Method::GRID).
+    /// The grid broadphase bins shape AABBs in a uniform grid, rebuilt at each step. For scenes with widely varying
+    /// shape sizes (e.g., large terrain meshes and many small particles), use ChBroadphase::Method::AABB_TREE which
+    /// maintains a dynamic AABB tree across steps. Note that, with the AABB tree broadphase, ray tests do not benefit
+    /// from a spatial subdivision and check all collision shapes.
+    void SetBroadphaseMethod(ChBroadphase::Method method);
+
+    /// Set the margin of the broadphase AABB tree, as a fraction of the shape size (default: 0.2).
+    /// Larger values reduce the number of tree updates as shapes move, at the cost of more overlap tests.
+    /// Only used with ChBroadphase::Method::AABB_TREE.
+    void SetBroadphaseTreeMargin(double margin);
+
     /// Set the narrowphase algorithm (default: ChNarrowphase::Algorithm::HYBRID).
     /// The Chrono collision detection system provides several analytical collision detection algorithms, for particular
     /// pairs of shapes (see ChNarrowphasePRIMS). For general convex shapes, the collision system relies on the
     /// Minkovski Portal Refinement algorithm (see ChNarrowphaseMPR).
     void SetNarrowphaseAlgorithm(ChNarrowphase::Algorithm algorithm);
 
+    /// Enable reuse of narrowphase results across steps (default: false).
+    /// If enabled, contacts of shape pairs whose relative pose did not change (within the tolerances set with
+    /// SetNarrowphaseCoherenceTolerances) are taken from a cache instead of being recalculated. This is beneficial for
+    /// scenes in which most shapes are in resting contact.
+    void EnableNarrowphaseCoherence(bool val);
+
+    /// Set the tolerances on relative displacement and rotation (in radians) of a shape pair for reusing its cached
+    /// contacts (default: 1e-6, 1e-5).
+    void SetNarrowphaseCoherenceTolerances(double pos_tol, double rot_tol);
+
+    /// Return the number of shape pairs for which cached contacts were reused during the last collision detection.
+    unsigned int GetNumNarrowphaseReusedPairs() const;
+
+    /// Enable persistence of contacts across steps (default: false).
+    /// If enabled, each new contact is matched to a contact from the previous collision detection pass, between the
+    /// same pair of shapes and with the contact point (relative to the first shape) within the specified tolerance. The
+    /// contact reactions computed at the previous step are then used to initialize the reactions of the new contact.
+    /// Note that, for NSC contacts, this is effective only if the solver uses warm starting.
+    void EnableContactPersistence(bool val);
+
+    /// Set the tolerance for matching contact points with those from the previous step (default: 0.01).
+    void SetContactPersistenceTolerance(double tol);
+
+    /// Return the number of contacts matched to a contact from the previous collision detection pass.
+    unsigned int GetNumPersistentContacts() const { return num_persistent_contacts; }
+
     /// Enable monitoring of shapes outside active bounding box (default: false).
     /// If enabled, objects whose collision shapes exit the active bounding box are deactivated (frozen).
     /// The size of the bounding box is specified by its min and max extents.
@@ -83,7 +121,9 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     bool GetActiveBoundingBox(ChVector<>& aabb_min, ChVector<>& aabb_max) const;
 
     /// Clear all data instanced by this algorithm if any (like persistent contact manifolds).
-    virtual void Clear(void) override {}
+    /// This discards the narrowphase cache (see EnableNarrowphaseCoherence) and the persistent contacts (see
+    /// EnableContactPersistence).
+    virtual void Clear(void) override;
 
     /// Add a collision model to the collision engine.
     virtual void Add(ChCollisionModel* model) override;
@@ -95,6 +135,11 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     /// Set the number of OpenMP threads for collision detection.
     virtual void SetNumThreads(int nthreads) override;
 
+    /// Set separate numbers of OpenMP threads for the broadphase and narrowphase stages of Run().
+    /// A value of 0 (default) leaves the current number of threads unchanged for that stage. The number of threads in
+    /// effect when Run() is called is restored on exit.
+    void SetPhaseNumThreads(int nthreads_broad, int nthreads_narrow);
+
     /// Synchronization operations, invoked before running the collision detection.
     /// This function copies contactable state information in the collision system's data structures.
     virtual void PreProcess() override;
@@ -142,6 +187,14 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     /// visualization callback was not specified with RegisterVisualizationCallback().
     virtual void Visualize(int flags) override;
 
+    /// Write the persistent contact data (see EnableContactPersistence) to a checkpoint.
+    virtual void CheckpointOUT(ChArchiveOut& marchive) override;
+
+    /// Read the persistent contact data from a checkpoint.
+    /// Note that the narrowphase cache (see EnableNarrowphaseCoherence) is not part of the checkpoint; it is discarded
+    /// and rebuilt at the next collision detection pass.
+    virtual void CheckpointIN(ChArchiveIn& marchive) override;
+
     /// Return the pairs of IDs for overlapping contact shapes.
     virtual std::vector<vec2> GetOverlappingPairs();
 
@@ -152,6 +205,9 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     /// Generate the current axis-aligned bounding boxes of collision shapes.
     void GenerateAABB();
 
+    /// Match current contacts to those from the previous pass and carry over their cached reactions.
+    void UpdateContactPersistence();
+
     /// Visualize collision shapes (wireframe).
     void VisualizeShapes();
 
@@ -172,8 +228,25 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     real3 active_aabb_min;  ///< lower corner of active bounding box
     real3 active_aabb_max;  ///< upper corner of active bounding box
 
+    bool use_persistence;                       ///< enable contact persistence
+    real persistence_tol;                       ///< tolerance for matching contact points
+    std::vector<long long> persist_keys;        ///< shape pair IDs of current contacts, sorted
+    std::vector<uint> persist_order;            ///< current contact for each sorted shape pair ID
+    std::vector<real3> persist_points;          ///< contact points, relative to first shape
+    std::vector<float> persist_reactions;       ///< reaction cache of current contacts (6 per contact)
+    std::vector<long long> persist_keys_prev;   ///< shape pair IDs of previous contacts, sorted
+    std::vector<uint> persist_order_prev;       ///< previous contact for each sorted shape pair ID
+    std::vector<real3> persist_points_prev;     ///< previous contact points, relative to first shape
+    std::vector<float> persist_reactions_prev;  ///< reaction cache of previous contacts
+    uint num_persistent_contacts;               ///< number of contacts matched at last pass
+
+    std::vector<ChCollisionInfo> contact_info;  ///< collision information passed to the contact container
+
     ChTimer<> m_timer_broad;
     ChTimer<> m_timer_narrow;
+
+    int m_nthreads_broad;   ///< number of threads for broadphase (0: unchanged)
+    int m_nthreads_narrow;  ///< number of threads for narrowphase (0: unchanged)
 };
 
 /// @} collision_mc
@@ -0,0 +1,424 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/collision/chrono/ChAABBTree.h"
+
+namespace chrono {
+namespace collision {
+
+// Status of a shape during a tree update.
+enum LeafStatus : char { UNCHANGED, MOVED, INSERTED, REMOVED };
+
+// Surface area of an AABB.
+static inline real Area(const real3& amin, const real3& amax) {
+    real3 d = amax - amin;
+    return 2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+ChAABBTree::ChAABBTree()
+    : m_root(-1),
+      m_num_leaves(0),
+      m_levels_valid(true),
+      m_margin(0.2),
+      m_reinsert_fraction(0.05),
+      m_rebuild_ratio(2),
+      m_build_area(0),
+      m_deterministic(false),
+      m_num_rebuilds(0),
+      m_num_refits(0),
+      m_num_reinserted(0) {}
+
+void ChAABBTree::Clear() {
+    m_nodes.clear();
+    m_free.clear();
+    m_leaf.clear();
+    m_levels.clear();
+    m_root = -1;
+    m_num_leaves = 0;
+    m_levels_valid = true;
+}
+
+void ChAABBTree::SetFatAABB(Node& node, const real3& amin, const real3& amax) const {
+    real3 size = amax - amin;
+    real3 margin(m_margin * Max(size));
+    node.min = amin - margin;
+    node.max = amax + margin;
+}
+
+int ChAABBTree::AllocateNode() {
+    if (!m_free.empty()) {
+        int node = m_free.back();
+        m_free.pop_back();
+        return node;
+    }
+    m_nodes.push_back(Node());
+    return (int)m_nodes.size() - 1;
+}
+
+void ChAABBTree::FreeNode(int node) {
+    m_free.push_back(node);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChAABBTree::Update(const std::vector<real3>& aabb_min,
+                        const std::vector<real3>& aabb_max,
+                        const std::vector<char>& enabled) {
+    int num_shapes = (int)aabb_min.size();
+    m_num_reinserted = 0;
+
+    // Shapes are only appended to the collision system; anything else invalidates the tree
+    if (num_shapes < (int)m_leaf.size())
+        Clear();
+    m_leaf.resize(num_shapes, -1);
+    m_status.resize(num_shapes);
+
+    // Classify shapes and update the fat AABBs of leaves whose shapes escaped them.
+    // Each shape only touches its own leaf, so this can be done in parallel.
+    int num_moved = 0;
+    int num_changed = 0;
+#pragma omp parallel for reduction(+ : num_moved, num_changed)
+    for (int i = 0; i < num_shapes; i++) {
+        int leaf = m_leaf[i];
+        char status = UNCHANGED;
+        if (enabled[i]) {
+            if (leaf < 0) {
+                status = INSERTED;
+                num_changed++;
+            } else {
+                Node& node = m_nodes[leaf];
+                const real3& amin = aabb_min[i];
+                const real3& amax = aabb_max[i];
+                if (amin.x < node.min.x || amin.y < node.min.y || amin.z < node.min.z ||  //
+                    amax.x > node.max.x || amax.y > node.max.y || amax.z > node.max.z) {
+                    SetFatAABB(node, amin, amax);
+                    status = MOVED;
+                    num_moved++;
+                }
+            }
+        } else if (leaf >= 0) {
+            status = REMOVED;
+            num_changed++;
+        }
+        m_status[i] = status;
+    }
+
+    real limit = Max(m_reinsert_fraction * m_num_leaves, real(1));
+
+    // Rebuild from scratch if the tree is empty or if many shapes were added or removed
+    if (m_root < 0 || num_changed > limit) {
+        Rebuild(aabb_min, aabb_max, enabled);
+        return;
+    }
+
+    if (num_changed > 0) {
+        for (int i = 0; i < num_shapes; i++) {
+            if (m_status[i] == REMOVED) {
+                RemoveLeaf(m_leaf[i]);
+                FreeNode(m_leaf[i]);
+                m_leaf[i] = -1;
+                m_num_leaves--;
+            } else if (m_status[i] == INSERTED) {
+                int leaf = AllocateNode();
+                Node& node = m_nodes[leaf];
+                node.child1 = -1;
+                node.child2 = -1;
+                node.shape = i;
+                SetFatAABB(node, aabb_min[i], aabb_max[i]);
+                InsertLeaf(leaf);
+                m_leaf[i] = leaf;
+                m_num_leaves++;
+            }
+        }
+    }
+
+    if (num_moved == 0)
+        return;
+
+    // Incremental rebuild: re-insert the few leaves that escaped their fat AABBs
+    if (num_changed + num_moved <= limit) {
+        for (int i = 0; i < num_shapes; i++) {
+            if (m_status[i] == MOVED) {
+                RemoveLeaf(m_leaf[i]);
+                InsertLeaf(m_leaf[i]);
+            }
+        }
+        m_num_reinserted = num_moved;
+        return;
+    }
+
+    // Refit the tree with the new leaf AABBs and rebuild if the tree quality degraded too much
+    real area = Refit();
+    m_num_refits++;
+    if (area > m_rebuild_ratio * m_build_area)
+        Rebuild(aabb_min, aabb_max, enabled);
+}
+
+// -----------------------------------------------------------------------------
+
+// Insert the given leaf, using the surface area heuristic to select its sibling (see E. Catto, "Dynamic Bounding
+// Volume Hierarchies", GDC 2019).
+void ChAABBTree::InsertLeaf(int leaf) {
+    m_levels_valid = false;
+
+    if (m_root < 0) {
+        m_root = leaf;
+        m_nodes[leaf].parent = -1;
+        return;
+    }
+
+    const real3 lmin = m_nodes[leaf].min;
+    const real3 lmax = m_nodes[leaf].max;
+
+    // Descend the tree, looking for the best sibling
+    int index = m_root;
+    while (m_nodes[index].child1 >= 0) {
+        const Node& node = m_nodes[index];
+        real area = Area(node.min, node.max);
+        real combined = Area(Min(node.min, lmin), Max(node.max, lmax));
+
+        // Cost of creating a new parent for this node and the new leaf
+        real cost = 2 * combined;
+        // Minimum cost of pushing the leaf further down the tree
+        real inheritance = 2 * (combined - area);
+
+        real child_cost[2];
+        int children[2] = {node.child1, node.child2};
+        for (int k = 0; k < 2; k++) {
+            const Node& child = m_nodes[children[k]];
+            real enlarged = Area(Min(child.min, lmin), Max(child.max, lmax));
+            if (child.child1 < 0)
+                child_cost[k] = enlarged + inheritance;
+            else
+                child_cost[k] = enlarged - Area(child.min, child.max) + inheritance;
+        }
+
+        if (cost < child_cost[0] && cost < child_cost[1])
+            break;
+
+        index = child_cost[0] < child_cost[1] ? children[0] : children[1];
+    }
+
+    // Create a new parent for the sibling and the new leaf
+    int sibling = index;
+    int old_parent = m_nodes[sibling].parent;
+    int new_parent = AllocateNode();
+    Node& pnode = m_nodes[new_parent];
+    pnode.parent = old_parent;
+    pnode.child1 = sibling;
+    pnode.child2 = leaf;
+    pnode.shape = -1;
+    pnode.min = Min(m_nodes[sibling].min, lmin);
+    pnode.max = Max(m_nodes[sibling].max, lmax);
+
+    if (old_parent >= 0) {
+        if (m_nodes[old_parent].child1 == sibling)
+            m_nodes[old_parent].child1 = new_parent;
+        else
+            m_nodes[old_parent].child2 = new_parent;
+    } else {
+        m_root = new_parent;
+    }
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    RefitAncestors(old_parent);
+}
+
+// Remove the given leaf from the tree (the leaf node itself is not freed).
+void ChAABBTree::RemoveLeaf(int leaf) {
+    m_levels_valid = false;
+
+    if (leaf == m_root) {
+        m_root = -1;
+        return;
+    }
+
+    int parent = m_nodes[leaf].parent;
+    int grand_parent = m_nodes[parent].parent;
+    int sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grand_parent >= 0) {
+        if (m_nodes[grand_parent].child1 == parent)
+            m_nodes[grand_parent].child1 = sibling;
+        else
+            m_nodes[grand_parent].child2 = sibling;
+        m_nodes[sibling].parent = grand_parent;
+        RefitAncestors(grand_parent);
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = -1;
+    }
+
+    FreeNode(parent);
+}
+
+void ChAABBTree::RefitAncestors(int node) {
+    while (node >= 0) {
+        Node& n = m_nodes[node];
+        n.min = Min(m_nodes[n.child1].min, m_nodes[n.child2].min);
+        n.max = Max(m_nodes[n.child1].max, m_nodes[n.child2].max);
+        node = n.parent;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChAABBTree::Rebuild(const std::vector<real3>& aabb_min,
+                         const std::vector<real3>& aabb_max,
+                         const std::vector<char>& enabled) {
+    int num_shapes = (int)aabb_min.size();
+
+    m_nodes.clear();
+    m_free.clear();
+    m_root = -1;
+    m_num_rebuilds++;
+
+    // Create the leaves
+    std::vector<int> leaves;
+    leaves.reserve(num_shapes);
+    for (int i = 0; i < num_shapes; i++) {
+        if (!enabled[i]) {
+            m_leaf[i] = -1;
+            continue;
+        }
+        m_leaf[i] = (int)leaves.size();
+        leaves.push_back(m_leaf[i]);
+    }
+
+    m_num_leaves = (int)leaves.size();
+    m_nodes.resize(m_num_leaves);
+    m_nodes.reserve(2 * m_num_leaves);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        int leaf = m_leaf[i];
+        if (leaf < 0)
+            continue;
+        Node& node = m_nodes[leaf];
+        node.child1 = -1;
+        node.child2 = -1;
+        node.shape = i;
+        SetFatAABB(node, aabb_min[i], aabb_max[i]);
+    }
+
+    // Build the internal nodes top-down
+    if (m_num_leaves > 0)
+        m_root = BuildRange(leaves.data(), leaves.data() + m_num_leaves, -1);
+
+    ComputeLevels();
+
+    m_build_area = 0;
+    for (const auto& level : m_levels) {
+        for (auto node : level)
+            m_build_area += Area(m_nodes[node].min, m_nodes[node].max);
+    }
+}
+
+// Recursively build the subtree over the specified range of leaves, splitting at the median of the leaf centers along
+// the longest axis. Return the root of the subtree.
+int ChAABBTree::BuildRange(int* first, int* last, int parent) {
+    if (last - first == 1) {
+        m_nodes[*first].parent = parent;
+        return *first;
+    }
+
+    // Bounds of leaf centers (scaled by 2)
+    real3 cmin(C_REAL_MAX);
+    real3 cmax(-C_REAL_MAX);
+    for (int* leaf = first; leaf != last; ++leaf) {
+        real3 c = m_nodes[*leaf].min + m_nodes[*leaf].max;
+        cmin = Min(cmin, c);
+        cmax = Max(cmax, c);
+    }
+    real3 d = cmax - cmin;
+    int axis = (d.x > d.y) ? (d.x > d.z ? 0 : 2) : (d.y > d.z ? 1 : 2);
+
+    int* mid = first + (last - first) / 2;
+    std::nth_element(first, mid, last, [this, axis](int a, int b) {
+        return m_nodes[a].min[axis] + m_nodes[a].max[axis] < m_nodes[b].min[axis] + m_nodes[b].max[axis];
+    });
+
+    int node = AllocateNode();
+    int child1 = BuildRange(first, mid, node);
+    int child2 = BuildRange(mid, last, node);
+
+    Node& n = m_nodes[node];
+    n.parent = parent;
+    n.child1 = child1;
+    n.child2 = child2;
+    n.shape = -1;
+    n.min = Min(m_nodes[child1].min, m_nodes[child2].min);
+    n.max = Max(m_nodes[child1].max, m_nodes[child2].max);
+
+    return node;
+}
+
+// Group the internal nodes by their depth in the tree.
+void ChAABBTree::ComputeLevels() {
+    m_levels.clear();
+    m_levels_valid = true;
+
+    if (m_root < 0 || m_nodes[m_root].child1 < 0)
+        return;
+
+    std::vector<int> level(1, m_root);
+    while (!level.empty()) {
+        std::vector<int> next;
+        for (auto node : level) {
+            for (auto child : {m_nodes[node].child1, m_nodes[node].child2}) {
+                if (m_nodes[child].child1 >= 0)
+                    next.push_back(child);
+            }
+        }
+        m_levels.push_back(std::move(level));
+        level = std::move(next);
+    }
+}
+
+// Recompute the AABBs of all internal nodes, bottom-up. Nodes at the same depth are processed in parallel.
+// Return the total surface area of the internal nodes.
+real ChAABBTree::Refit() {
+    if (!m_levels_valid)
+        ComputeLevels();
+
+    real area = 0;
+    for (int l = (int)m_levels.size() - 1; l >= 0; l--) {
+        const std::vector<int>& level = m_levels[l];
+        int num_nodes = (int)level.size();
+#pragma omp parallel for reduction(+ : area)
+        for (int i = 0; i < num_nodes; i++) {
+            Node& n = m_nodes[level[i]];
+            n.min = Min(m_nodes[n.child1].min, m_nodes[n.child2].min);
+            n.max = Max(m_nodes[n.child1].max, m_nodes[n.child2].max);
+            area += Area(n.min, n.max);
+        }
+    }
+
+    // The result of the parallel reduction depends on the number of threads. If needed, recompute it serially.
+    if (m_deterministic) {
+        area = 0;
+        for (int l = (int)m_levels.size() - 1; l >= 0; l--) {
+            for (auto node : m_levels[l])
+                area += Area(m_nodes[node].min, m_nodes[node].max);
+        }
+    }
+
+    return area;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Dynamic AABB tree (bounding volume hierarchy) used for broadphase collision
+// detection. The tree persists across collision detection passes.
+//
+// =============================================================================
+
+#pragma once
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/multicore_math/ChMulticoreMath.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup collision_mc
+/// @{
+
+/// Dynamic AABB tree over the collision shapes.
+/// Leaves store "fat" AABBs (shape AABBs inflated by a margin proportional to the shape size), so that a leaf must be
+/// updated only when its shape moved outside the fat AABB. At each update, escaped leaves are either removed and
+/// re-inserted in the tree (incremental rebuild, when only a few leaves moved) or refitted in place, with a parallel
+/// bottom-up pass over the tree levels. The tree is rebuilt from scratch (top-down, median split) when the refitted
+/// tree quality degrades or when the set of shapes in the tree changes significantly.
+class ChApi ChAABBTree {
+  public:
+    ChAABBTree();
+
+    /// Remove all shapes from the tree.
+    void Clear();
+
+    /// Set the margin for fat leaf AABBs, as a fraction of the largest shape AABB dimension (default: 0.2).
+    void SetMargin(real margin) { m_margin = margin; }
+
+    /// Set the fraction of leaves below which escaped leaves are re-inserted in the tree (default: 0.05).
+    /// If more leaves escaped their fat AABBs, the tree is refitted instead.
+    void SetReinsertFraction(real fraction) { m_reinsert_fraction = fraction; }
+
+    /// Set the allowed degradation of a refitted tree before a full rebuild (default: 2).
+    /// The tree quality is measured as the total surface area of the internal nodes, relative to that of the tree
+    /// obtained at the last full rebuild.
+    void SetRebuildRatio(real ratio) { m_rebuild_ratio = ratio; }
+
+    /// Enable/disable deterministic mode (default: false).
+    /// If enabled, the tree quality measure is accumulated in a fixed order, so that the decisions to rebuild the tree
+    /// (and hence the tree structure) do not depend on the number of threads.
+    void SetDeterministic(bool val) { m_deterministic = val; }
+
+    /// Update the tree to the current shape AABBs.
+    /// Only shapes flagged in `enabled` are included in the tree.
+    void Update(const std::vector<real3>& aabb_min,  ///< lower corners of shape AABBs
+                const std::vector<real3>& aabb_max,  ///< upper corners of shape AABBs
+                const std::vector<char>& enabled     ///< flags for shapes included in the tree
+    );
+
+    /// Invoke `func(shape)` for each shape whose fat AABB overlaps the specified box.
+    /// The provided stack is used as scratch space for the tree traversal (reuse it across queries from the same
+    /// thread to avoid memory allocations). This function can be called concurrently from different threads.
+    template <typename Func>
+    void Query(const real3& qmin, const real3& qmax, std::vector<int>& stack, Func func) const;
+
+    /// Return the number of shapes in the tree.
+    int GetNumLeaves() const { return m_num_leaves; }
+
+    /// Return the number of full rebuilds so far.
+    int GetNumRebuilds() const { return m_num_rebuilds; }
+
+    /// Return the number of refits so far.
+    int GetNumRefits() const { return m_num_refits; }
+
+    /// Return the number of leaf re-insertions during the last update.
+    int GetNumReinserted() const { return m_num_reinserted; }
+
+  private:
+    struct Node {
+        real3 min;   ///< lower corner of (fat) AABB
+        real3 max;   ///< upper corner of (fat) AABB
+        int parent;  ///< parent node (-1 for the root)
+        int child1;  ///< first child (-1 for leaves)
+        int child2;  ///< second child (-1 for leaves)
+        int shape;   ///< shape index (leaves only)
+    };
+
+    int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    void RefitAncestors(int node);
+    void Rebuild(const std::vector<real3>& aabb_min,
+                 const std::vector<real3>& aabb_max,
+                 const std::vector<char>& enabled);
+    int BuildRange(int* first, int* last, int parent);
+    void ComputeLevels();
+    real Refit();
+    void SetFatAABB(Node& node, const real3& amin, const real3& amax) const;
+
+    std::vector<Node> m_nodes;               ///< node pool
+    std::vector<int> m_free;                 ///< indices of free nodes in the pool
+    std::vector<int> m_leaf;                 ///< leaf node of each shape (-1 if not in tree)
+    std::vector<char> m_status;              ///< per-shape status during an update
+    std::vector<std::vector<int>> m_levels;  ///< internal nodes, grouped by depth
+    int m_root;                              ///< root node (-1 if empty tree)
+    int m_num_leaves;                        ///< number of shapes in the tree
+    bool m_levels_valid;                     ///< true if the level lists match the tree topology
+
+    real m_margin;             ///< fat AABB margin, relative to shape size
+    real m_reinsert_fraction;  ///< fraction of leaves below which escaped leaves are re-inserted
+    real m_rebuild_ratio;      ///< allowed tree degradation before full rebuild
+    real m_build_area;         ///< total area of internal nodes at last rebuild
+    bool m_deterministic;      ///< accumulate the tree area in a fixed order
+
+    int m_num_rebuilds;
+    int m_num_refits;
+    int m_num_reinserted;
+};
+
+/// @} collision_mc
+
+// -----------------------------------------------------------------------------
+
+template <typename Func>
+void ChAABBTree::Query(const real3& qmin, const real3& qmax, std::vector<int>& stack, Func func) const {
+    if (m_root < 0)
+        return;
+
+    stack.clear();
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (qmin.x > node.max.x || qmax.x < node.min.x || qmin.y > node.max.y || qmax.y < node.min.y ||
+            qmin.z > node.max.z || qmax.z < node.min.z)
+            continue;
+
+        if (node.child1 < 0) {
+            func(node.shape);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
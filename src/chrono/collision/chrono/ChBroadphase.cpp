@@ -35,10 +35,12 @@ namespace collision {
 using namespace chrono::collision::ch_utils;
 
 ChBroadphase::ChBroadphase()
-    : grid_type(GridType::FIXED_RESOLUTION),
+    : method(Method::GRID),
+      grid_type(GridType::FIXED_RESOLUTION),
       grid_resolution(vec3(10, 10, 10)),
       bin_size(real3(1, 1, 1)),
       grid_density(5),
+      deterministic(false),
       cd_data(nullptr) {}
 
 // -----------------------------------------------------------------------------
@@ -211,8 +213,23 @@ void ChBroadphase::ComputeTopLevelResolution() {
 
 // Use spatial subdivision to detect the list of POSSIBLE collisions
 void ChBroadphase::Process() {
-    // Compute overall AABB and then offset all AABBs
+    // Compute overall AABB
     DetermineBoundingBox();
+
+    if (method == Method::AABB_TREE) {
+        // The tree persists across collision detection passes, so it works with AABBs in absolute coordinates
+        if (cd_data->num_rigid_shapes != 0) {
+            TreeBroadphase();
+            cd_data->num_rigid_contacts = cd_data->num_possible_collisions;
+            if (deterministic)
+                SortPairs();
+        }
+        OffsetAABB();
+        SingleBinGrid();
+        return;
+    }
+
+    // Offset all AABBs
     OffsetAABB();
 
     // Determine resolution of the top level grid
@@ -221,6 +238,8 @@ void ChBroadphase::Process() {
     if (cd_data->num_rigid_shapes != 0) {
         OneLevelBroadphase();
         cd_data->num_rigid_contacts = cd_data->num_possible_collisions;
+        if (deterministic)
+            SortPairs();
     }
     return;
 }
@@ -344,5 +363,129 @@ void ChBroadphase::OneLevelBroadphase() {
     }
 }
 
+// -----------------------------------------------------------------------------
+
+// Use the persistent AABB tree to detect the list of POSSIBLE collisions
+void ChBroadphase::TreeBroadphase() {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+    const std::vector<short2>& fam_data = cd_data->shape_data.fam_rigid;
+
+    const std::vector<char>& obj_active = *cd_data->state_data.active_rigid;
+    const std::vector<char>& obj_collide = *cd_data->state_data.collide_rigid;
+
+    const std::vector<real3>& aabb_min = cd_data->aabb_min;
+    const std::vector<real3>& aabb_max = cd_data->aabb_max;
+    std::vector<long long>& pair_shapeIDs = cd_data->pair_shapeIDs;
+
+    const int num_shapes = cd_data->num_rigid_shapes;
+    uint& num_possible_collisions = cd_data->num_possible_collisions;
+
+    // Only shapes associated with colliding bodies are stored in the tree
+    tree_enabled.resize(num_shapes);
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        uint body = obj_data_id[i];
+        tree_enabled[i] = (body != UINT_MAX && obj_collide[body] != 0);
+    }
+
+    // Refit or rebuild the tree for the current shape AABBs
+    tree.Update(aabb_min, aabb_max, tree_enabled);
+
+    // Check if the given shapes are in potential collision (same criteria as for the grid broadphase).
+    // Queries are only performed for shapes on active bodies, and each pair is reported only once: by the shape with
+    // lower index if both bodies are active, otherwise by the shape on the active body.
+    auto candidate = [&](int shapeA, int shapeB) {
+        if (shapeA == shapeB)
+            return false;
+        uint bodyA = obj_data_id[shapeA];
+        uint bodyB = obj_data_id[shapeB];
+        if (bodyA == bodyB)
+            return false;
+        if (obj_active[bodyB] && shapeB < shapeA)
+            return false;
+        if (!collide(fam_data[shapeA], fam_data[shapeB]))
+            return false;
+        return overlap(aabb_min[shapeA], aabb_max[shapeA], aabb_min[shapeB], aabb_max[shapeB]);
+    };
+
+    tree_num_contact.resize(num_shapes + 1);
+    tree_num_contact[num_shapes] = 0;
+
+    // Count the number of potential collisions reported by each shape -> tree_num_contact
+#pragma omp parallel
+    {
+        std::vector<int> stack;
+#pragma omp for
+        for (int i = 0; i < num_shapes; i++) {
+            uint count = 0;
+            if (tree_enabled[i] && obj_active[obj_data_id[i]]) {
+                tree.Query(aabb_min[i], aabb_max[i], stack, [&](int j) {
+                    if (candidate(i, j))
+                        count++;
+                });
+            }
+            tree_num_contact[i] = count;
+        }
+    }
+
+    Thrust_Exclusive_Scan(tree_num_contact);
+    num_possible_collisions = tree_num_contact.back();
+    pair_shapeIDs.resize(num_possible_collisions);
+
+    // Store the list of shape pairs in potential collision (i.e. with intersecting AABBs)
+#pragma omp parallel
+    {
+        std::vector<int> stack;
+#pragma omp for
+        for (int i = 0; i < num_shapes; i++) {
+            if (!tree_enabled[i] || !obj_active[obj_data_id[i]])
+                continue;
+            uint offset = tree_num_contact[i];
+            tree.Query(aabb_min[i], aabb_max[i], stack, [&](int j) {
+                if (candidate(i, j)) {
+                    long long shapeA = std::min(i, j);
+                    long long shapeB = std::max(i, j);
+                    pair_shapeIDs[offset++] = (shapeA << 32 | shapeB);
+                }
+            });
+        }
+    }
+}
+
+// Sort the list of shape pairs in potential collision.
+// The order in which pairs are generated depends on the order of shapes in each bin (grid) or on the tree structure.
+// Sorting the (unique) encoded shape IDs results in a canonical order of the contacts reported by the narrowphase.
+void ChBroadphase::SortPairs() {
+    auto& pair_shapeIDs = cd_data->pair_shapeIDs;
+    thrust::sort(THRUST_PAR pair_shapeIDs.begin(), pair_shapeIDs.begin() + cd_data->num_possible_collisions);
+}
+
+// Set up a grid with a single bin containing all shapes, for use in ray intersection tests.
+// With the AABB tree broadphase, ray tests therefore check all shapes in the system.
+void ChBroadphase::SingleBinGrid() {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+    const int num_shapes = cd_data->num_rigid_shapes;
+
+    std::vector<uint>& bin_aabb_number = cd_data->bin_aabb_number;
+    bin_aabb_number.clear();
+    for (int i = 0; i < num_shapes; i++) {
+        if (obj_data_id[i] != UINT_MAX)
+            bin_aabb_number.push_back(i);
+    }
+    uint count = (uint)bin_aabb_number.size();
+
+    cd_data->bins_per_axis = vec3(1, 1, 1);
+    cd_data->bin_size = cd_data->max_bounding_point - cd_data->global_origin;
+    cd_data->inv_bin_size = 1.0 / cd_data->bin_size;
+
+    cd_data->num_bins = 1;
+    cd_data->num_active_bins = (count > 0) ? 1 : 0;
+    cd_data->num_bin_aabb_intersections = count;
+    cd_data->bin_number.assign(count, 0);
+    cd_data->bin_active.assign(1, 0);
+    cd_data->bin_start_index = {0, count};
+    cd_data->bin_start_index_ext = {0, count};
+}
+
 }  // end namespace collision
 }  // end namespace chrono
@@ -20,6 +20,7 @@
 
 #include "chrono/collision/ChCollisionModel.h"
 #include "chrono/collision/chrono/ChCollisionData.h"
+#include "chrono/collision/chrono/ChAABBTree.h"
 
 namespace chrono {
 namespace collision {
@@ -30,6 +31,12 @@ namespace collision {
 /// Class for performing broad-phase collision detection.
 class ChApi ChBroadphase {
   public:
+    /// Broadphase collision detection method.
+    enum class Method {
+        GRID,      ///< uniform grid, rebuilt at each collision detection pass
+        AABB_TREE  ///< persistent dynamic AABB tree (see ChAABBTree)
+    };
+
     /// Method for computing grid resolution
     enum class GridType {
         FIXED_RESOLUTION,  ///< user-specified number of bins in each direction
@@ -45,6 +52,9 @@ class ChApi ChBroadphase {
 
   private:
     void OneLevelBroadphase();
+    void TreeBroadphase();
+    void SingleBinGrid();
+    void SortPairs();
     void DetermineBoundingBox();
     void OffsetAABB();
     void ComputeTopLevelResolution();
@@ -53,10 +63,16 @@ class ChApi ChBroadphase {
 
     std::shared_ptr<ChCollisionData> cd_data;
 
+    Method method;         ///< (input) broadphase method
     GridType grid_type;    ///< (input) method for setting grid resolution
     vec3 grid_resolution;  ///< (input) number of bins (used for GridType::FIXED_RESOLUTION)
     real3 bin_size;        ///< (input) desired bin dimensions (used for GridType::FIXED_BIN_SIZE)
     real grid_density;     ///< (input) collision grid density (used for GridType::FIXED_DENSITY)
+    bool deterministic;    ///< (input) if true, report the shape pairs in canonical (sorted) order
+
+    ChAABBTree tree;                     ///< AABB tree (used for Method::AABB_TREE)
+    std::vector<char> tree_enabled;      ///< flags for shapes included in the AABB tree
+    std::vector<uint> tree_num_contact;  ///< number of overlapping pairs per shape
 
     friend class ChCollisionSystemChrono;
     friend class ChCollisionSystemChronoMulticore;
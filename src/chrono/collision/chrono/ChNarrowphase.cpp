@@ -41,8 +41,30 @@ ChNarrowphase::ChNarrowphase()
       num_potential_rigid_contacts(0),
       num_potential_fluid_contacts(0),
       num_potential_rigid_fluid_contacts(0),
+      coherence(false),
+      coherence_pos_tol(1e-6),
+      coherence_rot_tol(1e-5),
+      num_reused_pairs(0),
       cd_data(nullptr) {}
 
+void ChNarrowphase::EnableCoherence(bool val) {
+    coherence = val;
+    ClearCoherenceCache();
+}
+
+void ChNarrowphase::SetCoherenceTolerances(real pos_tol, real rot_tol) {
+    coherence_pos_tol = pos_tol;
+    coherence_rot_tol = rot_tol;
+}
+
+void ChNarrowphase::ClearCoherenceCache() {
+    cache_keys.clear();
+    cache_map.clear();
+    cache_entries.clear();
+    cache_contacts.clear();
+    num_reused_pairs = 0;
+}
+
 void ChNarrowphase::ClearContacts() {
     // Return now if no potential collisions.
     if (num_potential_rigid_contacts == 0) {
@@ -248,6 +270,9 @@ void ChNarrowphase::DispatchMPR() {
     for (int index = 0; index < (signed)num_potential_rigid_contacts; index++) {
         uint ID_A, ID_B, icoll;
 
+        if (coherence && pair_cached[index] >= 0)
+            continue;
+
         Dispatch_Init(index, icoll, ID_A, ID_B, &shapeA, &shapeB);
 
         if (MPRCollision(&shapeA, &shapeB, envelope, norm[icoll], ptA[icoll], ptB[icoll], contactDepth[icoll])) {
@@ -275,6 +300,9 @@ void ChNarrowphase::DispatchPRIMS() {
 
         int nC;
 
+        if (coherence && pair_cached[index] >= 0)
+            continue;
+
         Dispatch_Init(index, icoll, ID_A, ID_B, &shapeA, &shapeB);
 
         if (PRIMSCollision(&shapeA, &shapeB, 2 * envelope, &norm[icoll], &ptA[icoll], &ptB[icoll], &contactDepth[icoll],
@@ -303,6 +331,9 @@ void ChNarrowphase::DispatchHybridMPR() {
 
         int nC;
 
+        if (coherence && pair_cached[index] >= 0)
+            continue;
+
         Dispatch_Init(index, icoll, ID_A, ID_B, &shapeA, &shapeB);
 
         if (PRIMSCollision(&shapeA, &shapeB, 2 * envelope, &norm[icoll], &ptA[icoll], &ptB[icoll], &contactDepth[icoll],
@@ -347,6 +378,11 @@ void ChNarrowphase::ProcessRigidRigid() {
     contact_rigid_active.resize(num_potentialContacts);
     thrust::fill(contact_rigid_active.begin(), contact_rigid_active.end(), false);
 
+    // Reuse cached contacts for pairs with unchanged relative pose
+    num_reused_pairs = 0;
+    if (coherence)
+        ApplyCoherenceCache();
+
     switch (algorithm) {
         case Algorithm::MPR:
             DispatchMPR();
@@ -359,6 +395,9 @@ void ChNarrowphase::ProcessRigidRigid() {
             break;
     }
 
+    if (coherence)
+        UpdateCoherenceCache();
+
     // Calculate total number of actual (active) contacts
     num_rigid_contacts = (uint)Thrust_Count(contact_rigid_active, 1);
 
@@ -384,6 +423,158 @@ void ChNarrowphase::ProcessRigidRigid() {
 
 // -----------------------------------------------------------------------------
 
+void ChNarrowphase::ApplyCoherenceCache() {
+    const std::vector<long long>& pair_shapeIDs = cd_data->pair_shapeIDs;
+    const std::vector<uint>& obj_data_ID = cd_data->shape_data.id_rigid;
+    const std::vector<real3>& obj_data_A = cd_data->shape_data.obj_data_A_global;
+    const std::vector<quaternion>& obj_data_R = cd_data->shape_data.obj_data_R_global;
+
+    real3* norm = cd_data->norm_rigid_rigid.data();
+    real3* ptA = cd_data->cpta_rigid_rigid.data();
+    real3* ptB = cd_data->cptb_rigid_rigid.data();
+    real* contactDepth = cd_data->dpth_rigid_rigid.data();
+    real* effective_radius = cd_data->erad_rigid_rigid.data();
+
+    // For small angles, 1 - |cos(angle/2)| ~ angle^2 / 8
+    const real pos_tol2 = coherence_pos_tol * coherence_pos_tol;
+    const real rot_tol2 = coherence_rot_tol * coherence_rot_tol / 8;
+
+    pair_cached.resize(num_potential_rigid_contacts);
+    pair_rel_pos.resize(num_potential_rigid_contacts);
+    pair_rel_rot.resize(num_potential_rigid_contacts);
+
+    uint num_reused = 0;
+
+#pragma omp parallel for reduction(+ : num_reused)
+    for (int index = 0; index < (signed)num_potential_rigid_contacts; index++) {
+        long long key = pair_shapeIDs[index];
+        int sA = int(key >> 32);
+        int sB = int(key & 0xffffffff);
+
+        // Pose of second shape relative to first shape
+        const real3& posA = obj_data_A[sA];
+        const quaternion& rotA = obj_data_R[sA];
+        real3 rel_pos = RotateT(obj_data_A[sB] - posA, rotA);
+        quaternion rel_rot = Mult(Inv(rotA), obj_data_R[sB]);
+        pair_rel_pos[index] = rel_pos;
+        pair_rel_rot[index] = rel_rot;
+        pair_cached[index] = -1;
+
+        // Find the cached entry for this pair, if any
+        auto it = std::lower_bound(cache_keys.begin(), cache_keys.end(), key);
+        if (it == cache_keys.end() || *it != key)
+            continue;
+        uint e = cache_map[it - cache_keys.begin()];
+        const CoherenceEntry& entry = cache_entries[e];
+
+        // Recalculate contacts if the relative pose changed too much since the cached contacts were calculated
+        if (Length2(rel_pos - entry.rel_pos) > pos_tol2)
+            continue;
+        if (1 - Abs(Dot(rel_rot, entry.rel_rot)) > rot_tol2)
+            continue;
+
+        uint icoll = contact_index[index];
+        if (entry.num_contacts > contact_index[index + 1] - icoll)
+            continue;
+
+        // Load cached contacts, expressed in the current frame of the first shape
+        for (uint i = 0; i < entry.num_contacts; i++) {
+            const CoherenceContact& c = cache_contacts[entry.start + i];
+            norm[icoll + i] = Rotate(c.norm, rotA);
+            ptA[icoll + i] = posA + Rotate(c.ptA, rotA);
+            ptB[icoll + i] = posA + Rotate(c.ptB, rotA);
+            contactDepth[icoll + i] = c.depth;
+            effective_radius[icoll + i] = c.erad;
+        }
+        Dispatch_Finalize(icoll, obj_data_ID[sA], obj_data_ID[sB], entry.num_contacts);
+
+        pair_cached[index] = e;
+        num_reused++;
+    }
+
+    num_reused_pairs = num_reused;
+}
+
+void ChNarrowphase::UpdateCoherenceCache() {
+    const std::vector<long long>& pair_shapeIDs = cd_data->pair_shapeIDs;
+    const std::vector<real3>& obj_data_A = cd_data->shape_data.obj_data_A_global;
+    const std::vector<quaternion>& obj_data_R = cd_data->shape_data.obj_data_R_global;
+
+    const std::vector<real3>& norm = cd_data->norm_rigid_rigid;
+    const std::vector<real3>& ptA = cd_data->cpta_rigid_rigid;
+    const std::vector<real3>& ptB = cd_data->cptb_rigid_rigid;
+    const std::vector<real>& contactDepth = cd_data->dpth_rigid_rigid;
+    const std::vector<real>& effective_radius = cd_data->erad_rigid_rigid;
+
+    const int num_pairs = (signed)num_potential_rigid_contacts;
+
+    // Number of contacts to cache for each pair (active contacts of a pair are stored first in its range)
+    std::vector<uint> start(num_pairs + 1);
+    start[num_pairs] = 0;
+
+#pragma omp parallel for
+    for (int index = 0; index < num_pairs; index++) {
+        if (pair_cached[index] >= 0) {
+            start[index] = cache_entries[pair_cached[index]].num_contacts;
+            continue;
+        }
+        uint count = 0;
+        for (uint i = contact_index[index]; i < contact_index[index + 1] && contact_rigid_active[i]; i++)
+            count++;
+        start[index] = count;
+    }
+
+    Thrust_Exclusive_Scan(start);
+
+    std::vector<CoherenceEntry> entries(num_pairs);
+    std::vector<CoherenceContact> contacts(start[num_pairs]);
+
+#pragma omp parallel for
+    for (int index = 0; index < num_pairs; index++) {
+        CoherenceEntry& entry = entries[index];
+        entry.start = start[index];
+        entry.num_contacts = start[index + 1] - start[index];
+
+        if (pair_cached[index] >= 0) {
+            // Keep the reference pose of reused contacts, so that slow drifts are eventually detected
+            const CoherenceEntry& cached = cache_entries[pair_cached[index]];
+            entry.rel_pos = cached.rel_pos;
+            entry.rel_rot = cached.rel_rot;
+            for (uint i = 0; i < entry.num_contacts; i++)
+                contacts[entry.start + i] = cache_contacts[cached.start + i];
+            continue;
+        }
+
+        entry.rel_pos = pair_rel_pos[index];
+        entry.rel_rot = pair_rel_rot[index];
+
+        int sA = int(pair_shapeIDs[index] >> 32);
+        const real3& posA = obj_data_A[sA];
+        const quaternion& rotA = obj_data_R[sA];
+        uint icoll = contact_index[index];
+        for (uint i = 0; i < entry.num_contacts; i++) {
+            CoherenceContact& c = contacts[entry.start + i];
+            c.norm = RotateT(norm[icoll + i], rotA);
+            c.ptA = RotateT(ptA[icoll + i] - posA, rotA);
+            c.ptB = RotateT(ptB[icoll + i] - posA, rotA);
+            c.depth = contactDepth[icoll + i];
+            c.erad = effective_radius[icoll + i];
+        }
+    }
+
+    // Sort the pair IDs for lookup at the next pass
+    cache_keys = pair_shapeIDs;
+    cache_keys.resize(num_pairs);
+    cache_map.resize(num_pairs);
+    Thrust_Sequence(cache_map);
+    Thrust_Sort_By_Key(cache_keys, cache_map);
+
+    cache_entries.swap(entries);
+    cache_contacts.swap(contacts);
+}
+
+// -----------------------------------------------------------------------------
+
 inline int GridCoord(real x, real inv_bin_edge, real minimum) {
     real l = x - minimum;
     int c = (int)Round(l * inv_bin_edge);
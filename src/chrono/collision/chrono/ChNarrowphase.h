@@ -103,6 +103,23 @@ class ChApi ChNarrowphase {
                                int& nC                    ///< [output] number of contacts found
     );
 
+    /// Enable caching of narrowphase results across collision detection passes (default: false).
+    /// If enabled, the contacts found for each candidate shape pair are cached (expressed relative to the first shape)
+    /// and reused at the next pass if the relative pose of the two shapes did not change by more than the specified
+    /// tolerances since the contacts were calculated. This avoids re-deriving identical contacts for shapes in resting
+    /// contact.
+    void EnableCoherence(bool val);
+
+    /// Set the tolerances on relative motion of a shape pair for reusing cached contacts (default: 1e-6, 1e-5).
+    /// The position tolerance is a distance; the rotation tolerance is an angle (in radians).
+    void SetCoherenceTolerances(real pos_tol, real rot_tol);
+
+    /// Discard all cached narrowphase results.
+    void ClearCoherenceCache();
+
+    /// Return the number of shape pairs for which cached contacts were reused during the last pass.
+    uint GetNumReusedPairs() const { return num_reused_pairs; }
+
     /// Set the fictitious radius of curvature used for collision with a corner or an edge.
     static void SetDefaultEdgeRadius(real radius);
 
@@ -136,6 +153,29 @@ class ChApi ChNarrowphase {
     void Dispatch_Init(uint index, uint& icoll, uint& ID_A, uint& ID_B, ConvexShape* shapeA, ConvexShape* shapeB);
     void Dispatch_Finalize(uint icoll, uint ID_A, uint ID_B, int nC);
 
+    /// Load cached contacts for candidate pairs with (almost) unchanged relative pose.
+    void ApplyCoherenceCache();
+
+    /// Cache the contacts of all current candidate pairs.
+    void UpdateCoherenceCache();
+
+    /// Cached narrowphase result for a shape pair.
+    struct CoherenceEntry {
+        real3 rel_pos;       ///< position of second shape, relative to first shape
+        quaternion rel_rot;  ///< orientation of second shape, relative to first shape
+        uint start;          ///< index of first cached contact
+        uint num_contacts;   ///< number of cached contacts
+    };
+
+    /// Cached contact, expressed in the frame of the first shape.
+    struct CoherenceContact {
+        real3 norm;  ///< contact normal
+        real3 ptA;   ///< contact point on first shape
+        real3 ptB;   ///< contact point on second shape
+        real depth;  ///< penetration depth
+        real erad;   ///< effective contact radius
+    };
+
     std::shared_ptr<ChCollisionData> cd_data;
 
     std::vector<char> contact_rigid_active;
@@ -149,6 +189,18 @@ class ChApi ChNarrowphase {
 
     Algorithm algorithm;
 
+    bool coherence;                                ///< enable caching of narrowphase results
+    real coherence_pos_tol;                        ///< tolerance on relative displacement of cached pairs
+    real coherence_rot_tol;                        ///< tolerance on relative rotation of cached pairs
+    std::vector<long long> cache_keys;             ///< sorted shape pair IDs of cached pairs
+    std::vector<uint> cache_map;                   ///< cache entry for each sorted shape pair ID
+    std::vector<CoherenceEntry> cache_entries;     ///< cached pairs
+    std::vector<CoherenceContact> cache_contacts;  ///< cached contacts
+    std::vector<int> pair_cached;                  ///< reused cache entry for each candidate pair (-1 if none)
+    std::vector<real3> pair_rel_pos;               ///< relative position for each candidate pair
+    std::vector<quaternion> pair_rel_rot;          ///< relative orientation for each candidate pair
+    uint num_reused_pairs;                         ///< number of candidate pairs with reused contacts
+
     std::vector<uint> f_bin_intersections;
     std::vector<uint> f_bin_number;
     std::vector<uint> f_bin_number_out;  //// TODO: rename to f_bin_active
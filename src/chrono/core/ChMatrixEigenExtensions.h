@@ -95,12 +95,7 @@ void ArchiveOUT(chrono::ChArchiveOut& marchive) {
 		double* foo = 0;
         chrono::ChValueSpecific< double* > specVal(foo, "data", 0);
         marchive.out_array_pre(specVal, tot_elements);
-		char idname[21]; // only for xml, xml serialization needs unique element name
-        for (size_t i = 0; i < tot_elements; i++) {
-			sprintf(idname, "%lu", (unsigned long)i);
-            marchive << chrono::CHNVP(derived()((Eigen::Index)i), idname);
-            marchive.out_array_between(specVal, tot_elements);
-        }
+        _ArchiveOUTdata(marchive, specVal, derived().eval());
         marchive.out_array_end(specVal, tot_elements);
     }
 }
@@ -120,13 +115,45 @@ void ArchiveIN(chrono::ChArchiveIn& marchive) {
     // custom input of matrix data as array
     size_t tot_elements = derived().rows() * derived().cols();
     marchive.in_array_pre("data", tot_elements);
-	char idname[20]; // only for xml, xml serialization needs unique element name
-    for (size_t i = 0; i < tot_elements; i++) {
-		sprintf(idname, "%lu", (unsigned long)i);
-        marchive >> chrono::CHNVP(derived()((Eigen::Index)i), idname);
+    _ArchiveINdata(marchive, derived());
+    marchive.in_array_end("data");
+}
+
+// Helpers for ArchiveOUT and ArchiveIN.
+// Matrices of doubles are stored contiguously and are passed to the archive as a single block.
+template <int R, int C, int O, int MR, int MC>
+static void _ArchiveOUTdata(chrono::ChArchiveOut& marchive,
+                            chrono::ChValue& specVal,
+                            const Matrix<double, R, C, O, MR, MC>& mat) {
+    marchive.out_array_data(specVal, const_cast<double*>(mat.data()), (size_t)mat.size());
+}
+
+template <typename OtherDerived>
+static void _ArchiveOUTdata(chrono::ChArchiveOut& marchive,
+                            chrono::ChValue& specVal,
+                            const MatrixBase<OtherDerived>& mat) {
+    char idname[21];  // only for xml, xml serialization needs unique element name
+    for (Eigen::Index i = 0; i < mat.size(); i++) {
+        sprintf(idname, "%lu", (unsigned long)i);
+        auto val = mat.derived().coeff(i);
+        marchive << chrono::CHNVP(val, idname);
+        marchive.out_array_between(specVal, (size_t)mat.size());
+    }
+}
+
+template <int R, int C, int O, int MR, int MC>
+static void _ArchiveINdata(chrono::ChArchiveIn& marchive, Matrix<double, R, C, O, MR, MC>& mat) {
+    marchive.in_array_data("data", mat.data(), (size_t)mat.size());
+}
+
+template <typename OtherDerived>
+static void _ArchiveINdata(chrono::ChArchiveIn& marchive, MatrixBase<OtherDerived>& mat) {
+    char idname[21];  // only for xml, xml serialization needs unique element name
+    for (Eigen::Index i = 0; i < mat.size(); i++) {
+        sprintf(idname, "%lu", (unsigned long)i);
+        marchive >> chrono::CHNVP(mat.derived()(i), idname);
         marchive.in_array_between("data");
     }
-    marchive.in_array_end("data");
 }
 
 #endif
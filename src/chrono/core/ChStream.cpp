@@ -13,6 +13,7 @@
 #include <cmath>
 #include <cstdarg>
 #include <cerrno>
+#include <algorithm>
 #include <iterator>
 
 #include "chrono/core/ChStream.h"
@@ -497,6 +498,15 @@ ChStreamOutBinary& ChStreamOutBinary::operator<<(std::string& str) {
     return *this;
 }
 
+void ChStreamOutBinary::ArrayOutput(const double* data, size_t n) {
+    if (big_endian_machine) {
+        for (size_t i = 0; i < n; i++)
+            *this << data[i];
+    } else {
+        this->Output((const char*)data, n * sizeof(double));
+    }
+}
+
 void ChStreamOutBinary::VersionWrite(int mver) {
     *this << mver;
 }
@@ -618,21 +628,25 @@ ChStreamInBinary& ChStreamInBinary::operator>>(char* str) {
 
 ChStreamInBinary& ChStreamInBinary::operator>>(std::string& str) {
     // Read string length , plus null-termination char
-    str = "";
-    char buf[2];
-    buf[1] = '\0';
     int mlength;
     *this >> mlength;
-    str.reserve(mlength);
-    for (int i = 0; i < mlength; i++) {
-        this->Input(buf, 1);
-        str.append(buf);
-    }
     // Read all bytes of string.
+    str.resize(mlength);
+    if (mlength > 0)
+        this->Input(&str[0], mlength);
 
     return *this;
 }
 
+void ChStreamInBinary::ArrayInput(double* data, size_t n) {
+    if (big_endian_machine) {
+        for (size_t i = 0; i < n; i++)
+            *this >> data[i];
+    } else {
+        this->Input((char*)data, n * sizeof(double));
+    }
+}
+
 int ChStreamInBinary::VersionRead() {
     int mres;
     *this >> mres;
@@ -648,6 +662,9 @@ ChStreamFile::ChStreamFile(const char* filename, std::ios::openmode mmode) {
     try {
         // file.exceptions(std::ios::failbit | std::ios::badbit);
         file.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+        // the buffer must be set before the file is opened
+        buffer.resize(BUFFER_SIZE);
+        file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
         file.open(filename, mmode);
     } catch (const std::exception&) {
         std::string msg = "Cannot open stream " + std::string(filename); 
@@ -727,16 +744,14 @@ ChStreamVectorWrapper::~ChStreamVectorWrapper() {
 }
 
 void ChStreamVectorWrapper::Write(const char* data, size_t n) {
-    std::copy(data, data + n, std::back_inserter(*vbuffer));
+    vbuffer->insert(vbuffer->end(), data, data + n);
 }
 void ChStreamVectorWrapper::Read(char* data, size_t n) {
     if (pos + n > vbuffer->size())
         n = vbuffer->size() - pos;
 
-    for (int i = 0; i < n; i++) {
-        data[i] = (*vbuffer)[pos];
-        pos++;
-    }
+    std::copy(vbuffer->data() + pos, vbuffer->data() + pos + n, data);
+    pos += (int)n;
 }
 bool ChStreamVectorWrapper::End_of_stream() const {
     if (pos >= vbuffer->size())
@@ -331,6 +331,11 @@ class ChApi ChStreamOutBinary : public ChStreamOut, public ChBinaryArchive {
     ChStreamOutBinary& operator<<(const char* str);
     ChStreamOutBinary& operator<<(char* str);
 
+    /// Output a contiguous array of doubles.
+    /// The data is written with the same byte ordering as operator<<(double), but, on little-endian machines,
+    /// the entire array is passed to Output() at once.
+    void ArrayOutput(const double* data, size_t n);
+
     /// Generic operator for binary streaming of generic objects.
     /// WARNING!!! raw byte streaming! If class 'T' contains double,
     /// int, long, etc, these may give problems when loading on another
@@ -447,6 +452,10 @@ class ChApi ChStreamInBinary : public ChStreamIn, public ChBinaryArchive {
     /// Specialized operator for C strings
     ChStreamInBinary& operator>>(char* str);
 
+    /// Input a contiguous array of doubles, written with ArrayOutput or with operator<<(double).
+    /// On little-endian machines, the entire array is obtained with a single call to Input().
+    void ArrayInput(double* data, size_t n);
+
     /// Generic operator for raw binary streaming of generic objects
     /// WARNING!!! raw byte streaming! If class 'T' contains double,
     /// int, long, etc, these may give problems when loading on another
@@ -548,12 +557,17 @@ class ChApi ChStreamInBinary : public ChStreamIn, public ChBinaryArchive {
 
 class ChApi ChStreamFile {
   private:
+    /// Buffer used by the file stream (larger than the default, to reduce the number of system calls)
+    std::vector<char> buffer;
     /// Handler to a C++ file
     std::fstream file;
     /// The file name
     char name[180];
 
   public:
+    /// Size of the buffer of file streams (1 MB).
+    static const size_t BUFFER_SIZE = 1 << 20;
+
     /// Creates a system file, like the C++ fstream, and opens it,
     /// given filename on disk, and the opening mode (ex: std::ios::out or
     /// std::ios::in)
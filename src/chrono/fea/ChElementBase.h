@@ -102,6 +102,8 @@ class ChApi ChElementBase {
     /// Add the internal forces (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += forces * c
+    /// Note that ChMesh calls this function (as well as EleIntLoadResidual_Mv and EleIntLoadResidual_F_gravity)
+    /// concurrently for elements that do not share any node; implementations need not use atomic updates of R.
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {}
 
     /// Add the product of element mass M by a vector w (pasted at global nodes offsets) into
@@ -18,11 +18,13 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChProfiler.h"
 
 #include "chrono/fea/ChElementTetraCorot_4.h"
 #include "chrono/fea/ChMesh.h"
@@ -47,6 +49,8 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
 
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
+
+    element_coloring_valid = false;
 }
 
 void ChMesh::SetupInitial() {
@@ -67,6 +71,69 @@ void ChMesh::SetupInitial() {
         // precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    element_coloring_valid = false;
+}
+
+void ChMesh::UpdateElementColoring() {
+    element_colors.clear();
+    element_serial.clear();
+
+    // Bit masks of the colors already used by the elements connected to each node
+    std::unordered_map<ChNodeFEAbase*, unsigned long long> node_colors;
+
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        int nnodes = velements[ie]->GetNnodes();
+
+        unsigned long long used = 0;
+        for (int in = 0; in < nnodes; in++)
+            used |= node_colors[velements[ie]->GetNodeN(in).get()];
+
+        if (~used == 0) {
+            element_serial.push_back(ie);
+            continue;
+        }
+
+        unsigned int color = 0;
+        while (used & (1ULL << color))
+            color++;
+
+        if (color >= element_colors.size())
+            element_colors.resize(color + 1);
+        element_colors[color].push_back(ie);
+
+        for (int in = 0; in < nnodes; in++)
+            node_colors[velements[ie]->GetNodeN(in).get()] |= (1ULL << color);
+    }
+
+    element_coloring_valid = true;
+}
+
+template <typename Func>
+void ChMesh::ForEachElement(Func func) {
+    int nthreads = GetSystem()->nthreads_chrono;
+
+    // In deterministic mode, always process elements color by color, so that the contributions to each node are
+    // accumulated in the same order regardless of the number of threads.
+    if (nthreads <= 1 && !GetSystem()->IsDeterministicModeEnabled()) {
+        for (unsigned int ie = 0; ie < velements.size(); ie++)
+            func(ie);
+        return;
+    }
+
+    if (!element_coloring_valid)
+        UpdateElementColoring();
+
+    //***PARALLEL FOR***, elements of the same color do not share nodes (no race condition in writing to R)
+    for (const auto& color : element_colors) {
+        int nelements = (int)color.size();
+#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
+        for (int i = 0; i < nelements; i++)
+            func(color[i]);
+    }
+
+    for (auto ie : element_serial)
+        func(ie);
 }
 
 void ChMesh::Relax() {
@@ -96,6 +163,7 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    element_coloring_valid = false;
 
     // If the mesh is already added to a system, mark the system uninitialized and out-of-date
     if (system) {
@@ -107,6 +175,7 @@ void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    element_coloring_valid = false;
 
     // If the mesh is already added to a system, mark the system out-of-date
     if (system) {
@@ -118,6 +187,7 @@ void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    element_coloring_valid = false;
 
     // If the mesh is already added to a system, mark the system out-of-date
     if (system) {
@@ -160,6 +230,8 @@ void ChMesh::Setup() {
 // Updates all time-dependant variables, if any...
 // Ex: maybe the elasticity can increase in time, etc.
 void ChMesh::Update(double m_time, bool update_assets) {
+    CH_PROFILE_ZONE("FEA_update");
+
     // Parent class update
     ChIndexedNodes::Update(m_time, update_assets);
 
@@ -294,25 +366,19 @@ void ChMesh::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, con
         }
     }
 
-    int nthreads = GetSystem()->nthreads_chrono;
-
     // elements internal forces
-    timer_internal_forces.start();
-    //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    {
+        CH_PROFILE_ZONE("FEA_internal_forces");
+        timer_internal_forces.start();
+        ForEachElement([&](unsigned int ie) { velements[ie]->EleIntLoadResidual_F(R, c); });
+        timer_internal_forces.stop();
     }
-    timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // elements gravity forces
     if (automatic_gravity_load) {
-        //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-        for (int ie = 0; ie < velements.size(); ie++) {
-            velements[ie]->EleIntLoadResidual_F_gravity(R, GetSystem()->Get_G_acc(), c);
-        }
+        const ChVector<>& G_acc = GetSystem()->Get_G_acc();
+        ForEachElement([&](unsigned int ie) { velements[ie]->EleIntLoadResidual_F_gravity(R, G_acc, c); });
     }
 
     // nodes gravity forces
@@ -374,9 +440,7 @@ void ChMesh::IntLoadResidual_Mv(const unsigned int off,      ///< offset in R re
     }
 
     // internal masses
-    for (unsigned int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_Mv(R, w, c);
-    }
+    ForEachElement([&](unsigned int ie) { velements[ie]->EleIntLoadResidual_Mv(R, w, c); });
 }
 
 void ChMesh::IntToDescriptor(const unsigned int off_v,
@@ -417,6 +481,7 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     int nthreads = GetSystem()->nthreads_chrono;
 
+    CH_PROFILE_ZONE("FEA_KRM_load");
     timer_KRMload.start();
 #pragma omp parallel for num_threads(nthreads)
     for (int ie = 0; ie < velements.size(); ie++)
@@ -57,6 +57,10 @@ class ChApi ChMesh : public ChIndexedNodes {
     int ncalls_internal_forces;
     int ncalls_KRMload;
 
+    std::vector<std::vector<unsigned int>> element_colors;  ///< element indices, per color
+    std::vector<unsigned int> element_serial;               ///< elements that could not be colored
+    bool element_coloring_valid;                            ///< false if the element coloring must be recomputed
+
   public:
     ChMesh()
         : n_dofs(0),
@@ -64,7 +68,8 @@ class ChApi ChMesh : public ChIndexedNodes {
           automatic_gravity_load(true),
           num_points_gravity(1),
           ncalls_internal_forces(0),
-          ncalls_KRMload(0) {}
+          ncalls_KRMload(0),
+          element_coloring_valid(false) {}
     ChMesh(const ChMesh& other);
     ~ChMesh() {}
 
@@ -120,6 +125,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Get cumulative time for Jacobian load calls.
     double GetTimeJacobianLoad() { return timer_KRMload(); }
 
+    /// Get the number of colors in the partition of elements used by the multithreaded element loops.
+    /// Elements of the same color do not share any node, so they can load their contributions in the global vectors
+    /// concurrently, without atomic operations. The coloring is recomputed whenever elements are added or removed.
+    int GetNumElementColors() {
+        if (!element_coloring_valid)
+            UpdateElementColoring();
+        return (int)element_colors.size();
+    }
+
     /// Add a contact surface.
     void AddContactSurface(std::shared_ptr<ChContactSurface> m_surf);
 
@@ -285,6 +299,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// </pre>
     virtual void SetupInitial() override;
 
+    /// Greedily partition the elements into sets ("colors") of elements that do not share any node.
+    /// Elements that would require more than 64 colors are collected in a separate list, processed serially.
+    void UpdateElementColoring();
+
+    /// Invoke the given function on the index of each element, using the element coloring to process elements of
+    /// the same color concurrently (if more than one thread is used).
+    template <typename Func>
+    void ForEachElement(Func func);
+
     friend class chrono::ChSystem;
     friend class chrono::ChAssembly;
     friend class chrono::modal::ChModalAssembly;
@@ -47,8 +47,8 @@ ChAssembly::ChAssembly()
       nsysvars_w(0),
       ndof(0),
       ndoc_w_C(0),
-      ndoc_w_D(0)
-       {}
+      ndoc_w_D(0),
+      parallel_threshold(1000) {}
 
 ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     nbodies = other.nbodies;
@@ -69,6 +69,7 @@ ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     ndof = other.ndof;
     nsysvars = other.nsysvars;
     nsysvars_w = other.nsysvars_w;
+    parallel_threshold = other.parallel_threshold;
 
     //// RADU
     //// TODO:  deep copy of the object lists (bodylist, shaftlist, linklist, meshlist,  otherphysicslist)
@@ -110,6 +111,7 @@ void swap(ChAssembly& first, ChAssembly& second) {
     swap(first.ndof, second.ndof);
     swap(first.nsysvars, second.nsysvars);
     swap(first.nsysvars_w, second.nsysvars_w);
+    swap(first.parallel_threshold, second.parallel_threshold);
 
     //// RADU
     //// TODO: deal with all other member variables...
@@ -460,8 +462,10 @@ void ChAssembly::SetSystem(ChSystem* m_system) {
 }
 
 void ChAssembly::SyncCollisionModels() {
+    // Sleeping bodies do not move; their collision models are synchronized when they change state.
     for (auto& body : bodylist) {
-        body->SyncCollisionModels();
+        if (!body->GetSleeping())
+            body->SyncCollisionModels();
     }
     for (auto& shaft : shaftlist) {
         shaft->SyncCollisionModels();
@@ -624,6 +628,22 @@ void ChAssembly::Setup() {
     ndof = ncoords_w - ndoc_w;
 }
 
+template <typename Func>
+void ChAssembly::ForEachItem(int nitems, Func func) {
+    int nthreads = system ? system->GetNumThreadsChrono() : 1;
+
+    if (nthreads <= 1 || nitems < parallel_threshold) {
+        for (int ip = 0; ip < nitems; ip++)
+            func(ip);
+        return;
+    }
+
+    //***PARALLEL FOR***, each item only accesses its own data (no race condition in writing to state vectors)
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (int ip = 0; ip < nitems; ip++)
+        func(ip);
+}
+
 // Update assembly's own properties first (ChTime and assets, if any).
 // Then update all contents of this assembly.
 void ChAssembly::Update(double mytime, bool update_assets) {
@@ -635,13 +655,14 @@ void ChAssembly::Update(double mytime, bool update_assets) {
 // Updates all forces (automatic, as children of bodies)
 // Updates all markers (automatic, as children of bodies).
 void ChAssembly::Update(bool update_assets) {
-    //// NOTE: do not switch these to range for loops (may want to use OMP for)
-    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
-        bodylist[ip]->Update(ChTime, update_assets);
-    }
-    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
-        shaftlist[ip]->Update(ChTime, update_assets);
-    }
+    // Bodies and shafts only update their own data (and that of their markers and forces), so they can be processed
+    // in parallel. Links are processed sequentially, as different links may share the same motion functions.
+    // Sleeping bodies are skipped, as they do not contribute to the dynamics until woken up.
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        if (!bodylist[ip]->GetSleeping())
+            bodylist[ip]->Update(ChTime, update_assets);
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) { shaftlist[ip]->Update(ChTime, update_assets); });
     for (int ip = 0; ip < (int)otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->Update(ChTime, update_assets);
     }
@@ -679,14 +700,18 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
+        double T_item;  // each item reports its time; avoid concurrent writes to T
         if (body->IsActive())
-            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T);
-    }
-    for (auto& shaft : shaftlist) {
+            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T_item);
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
+        double T_item;  // each item reports its time; avoid concurrent writes to T
         if (shaft->IsActive())
-            shaft->IntStateGather(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T);
-    }
+            shaft->IntStateGather(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T_item);
+    });
     for (auto& link : linklist) {
         if (link->IsActive())
             link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T);
@@ -718,18 +743,20 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatter(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T, full_update);
         else
             body->Update(T, full_update);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateScatter(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T, full_update);
         else
             shaft->Update(T, full_update);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->IntStateScatter(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T, full_update);
     }
@@ -749,14 +776,16 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
 void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateGatherAcceleration(displ_a + body->GetOffset_w(), a);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateGatherAcceleration(displ_a + shaft->GetOffset_w(), a);
-    }
+    });
     for (auto& link : linklist) {
         if (link->IsActive())
             link->IntStateGatherAcceleration(displ_a + link->GetOffset_w(), a);
@@ -774,14 +803,16 @@ void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDel
 void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatterAcceleration(displ_a + body->GetOffset_w(), a);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateScatterAcceleration(displ_a + shaft->GetOffset_w(), a);
-    }
+    });
     for (auto& link : linklist) {
         if (link->IsActive())
             link->IntStateScatterAcceleration(displ_a + link->GetOffset_w(), a);
@@ -799,18 +830,21 @@ void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChS
 void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateGatherReactions(displ_L + body->GetOffset_L(), L);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateGatherReactions(displ_L + shaft->GetOffset_L(), L);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateGatherReactions(displ_L + link->GetOffset_L(), L);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->IntStateGatherReactions(displ_L + mesh->GetOffset_L(), L);
     }
@@ -824,18 +858,21 @@ void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynam
 void ChAssembly::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatterReactions(displ_L + body->GetOffset_L(), L);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateScatterReactions(displ_L + shaft->GetOffset_L(), L);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateScatterReactions(displ_L + link->GetOffset_L(), L);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->IntStateScatterReactions(displ_L + mesh->GetOffset_L(), L);
     }
@@ -853,15 +890,17 @@ void ChAssembly::IntStateIncrement(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateIncrement(displ_x + body->GetOffset_x(), x_new, x, displ_v + body->GetOffset_w(), Dv);
-    }
+    });
 
-    for (auto& shaft : shaftlist) {
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateIncrement(displ_x + shaft->GetOffset_x(), x_new, x, displ_v + shaft->GetOffset_w(), Dv);
-    }
+    });
 
     for (auto& link : linklist) {
         if (link->IsActive())
@@ -886,15 +925,17 @@ void ChAssembly::IntStateGetIncrement(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateGetIncrement(displ_x + body->GetOffset_x(), x_new, x, displ_v + body->GetOffset_w(), Dv);
-    }
+    });
 
-    for (auto& shaft : shaftlist) {
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateGetIncrement(displ_x + shaft->GetOffset_x(), x_new, x, displ_v + shaft->GetOffset_w(), Dv);
-    }
+    });
 
     for (auto& link : linklist) {
         if (link->IsActive())
@@ -917,14 +958,16 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
 {
     unsigned int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_F(displ_v + body->GetOffset_w(), R, c);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadResidual_F(displ_v + shaft->GetOffset_w(), R, c);
-    }
+    });
     for (auto& link : linklist) {
         if (link->IsActive())
             link->IntLoadResidual_F(displ_v + link->GetOffset_w(), R, c);
@@ -945,14 +988,16 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
 ) {
     unsigned int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_Mv(displ_v + body->GetOffset_w(), R, w, c);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadResidual_Mv(displ_v + shaft->GetOffset_w(), R, w, c);
-    }
+    });
     for (auto& link : linklist) {
         if (link->IsActive())
             link->IntLoadResidual_Mv(displ_v + link->GetOffset_w(), R, w, c);
@@ -973,14 +1018,16 @@ void ChAssembly::IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_CqL(displ_L + body->GetOffset_L(), R, L, c);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadResidual_CqL(displ_L + shaft->GetOffset_L(), R, L, c);
-    }
+    });
     for (auto& link : linklist) {
         if (link->IsActive())
             link->IntLoadResidual_CqL(displ_L + link->GetOffset_L(), R, L, c);
@@ -1002,18 +1049,21 @@ void ChAssembly::IntLoadConstraint_C(const unsigned int off_L,  ///< offset in Q
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadConstraint_C(displ_L + body->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadConstraint_C(displ_L + shaft->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntLoadConstraint_C(displ_L + link->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->IntLoadConstraint_C(displ_L + mesh->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
     }
@@ -1029,18 +1079,21 @@ void ChAssembly::IntLoadConstraint_Ct(const unsigned int off_L,  ///< offset in
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadConstraint_Ct(displ_L + body->GetOffset_L(), Qc, c);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadConstraint_Ct(displ_L + shaft->GetOffset_L(), Qc, c);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntLoadConstraint_Ct(displ_L + link->GetOffset_L(), Qc, c);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->IntLoadConstraint_Ct(displ_L + mesh->GetOffset_L(), Qc, c);
     }
@@ -1059,20 +1112,23 @@ void ChAssembly::IntToDescriptor(const unsigned int off_v,
     unsigned int displ_L = off_L - this->offset_L;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntToDescriptor(displ_v + body->GetOffset_w(), v, R, displ_L + body->GetOffset_L(), L, Qc);
-    }
+    });
 
-    for (auto& shaft : shaftlist) {
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntToDescriptor(displ_v + shaft->GetOffset_w(), v, R, displ_L + shaft->GetOffset_L(), L, Qc);
-    }
+    });
 
-    for (auto& link : linklist) {
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntToDescriptor(displ_v + link->GetOffset_w(), v, R, displ_L + link->GetOffset_L(), L, Qc);
-    }
+    });
 
     for (auto& mesh : meshlist) {
         mesh->IntToDescriptor(displ_v + mesh->GetOffset_w(), v, R, displ_L + mesh->GetOffset_L(), L, Qc);
@@ -1091,20 +1147,23 @@ void ChAssembly::IntFromDescriptor(const unsigned int off_v,
     unsigned int displ_L = off_L - this->offset_L;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntFromDescriptor(displ_v + body->GetOffset_w(), v, displ_L + body->GetOffset_L(), L);
-    }
+    });
 
-    for (auto& shaft : shaftlist) {
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntFromDescriptor(displ_v + shaft->GetOffset_w(), v, displ_L + shaft->GetOffset_L(), L);
-    }
+    });
 
-    for (auto& link : linklist) {
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntFromDescriptor(displ_v + link->GetOffset_w(), v, displ_L + link->GetOffset_L(), L);
-    }
+    });
 
     for (auto& mesh : meshlist) {
         mesh->IntFromDescriptor(displ_v + mesh->GetOffset_w(), v, displ_L + mesh->GetOffset_L(), L);
@@ -1137,12 +1196,14 @@ void ChAssembly::InjectVariables(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::VariablesFbReset() {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->VariablesFbReset();
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->VariablesFbReset();
-    }
+    });
     for (auto& link : linklist) {
         link->VariablesFbReset();
     }
@@ -1155,12 +1216,14 @@ void ChAssembly::VariablesFbReset() {
 }
 
 void ChAssembly::VariablesFbLoadForces(double factor) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->VariablesFbLoadForces(factor);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->VariablesFbLoadForces(factor);
-    }
+    });
     for (auto& link : linklist) {
         link->VariablesFbLoadForces(factor);
     }
@@ -1173,12 +1236,14 @@ void ChAssembly::VariablesFbLoadForces(double factor) {
 }
 
 void ChAssembly::VariablesFbIncrementMq() {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->VariablesFbIncrementMq();
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->VariablesFbIncrementMq();
-    }
+    });
     for (auto& link : linklist) {
         link->VariablesFbIncrementMq();
     }
@@ -1191,12 +1256,14 @@ void ChAssembly::VariablesFbIncrementMq() {
 }
 
 void ChAssembly::VariablesQbLoadSpeed() {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->VariablesQbLoadSpeed();
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->VariablesQbLoadSpeed();
-    }
+    });
     for (auto& link : linklist) {
         link->VariablesQbLoadSpeed();
     }
@@ -1209,12 +1276,14 @@ void ChAssembly::VariablesQbLoadSpeed() {
 }
 
 void ChAssembly::VariablesQbSetSpeed(double step) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->VariablesQbSetSpeed(step);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->VariablesQbSetSpeed(step);
-    }
+    });
     for (auto& link : linklist) {
         link->VariablesQbSetSpeed(step);
     }
@@ -1227,12 +1296,14 @@ void ChAssembly::VariablesQbSetSpeed(double step) {
 }
 
 void ChAssembly::VariablesQbIncrementPosition(double dt_step) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->VariablesQbIncrementPosition(dt_step);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->VariablesQbIncrementPosition(dt_step);
-    }
+    });
     for (auto& link : linklist) {
         link->VariablesQbIncrementPosition(dt_step);
     }
@@ -1263,15 +1334,18 @@ void ChAssembly::InjectConstraints(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::ConstraintsBiReset() {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiReset();
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsBiReset();
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiReset();
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->ConstraintsBiReset();
     }
@@ -1281,15 +1355,18 @@ void ChAssembly::ConstraintsBiReset() {
 }
 
 void ChAssembly::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool do_clamp) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
@@ -1299,15 +1376,18 @@ void ChAssembly::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool
 }
 
 void ChAssembly::ConstraintsBiLoad_Ct(double factor) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiLoad_Ct(factor);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsBiLoad_Ct(factor);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiLoad_Ct(factor);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->ConstraintsBiLoad_Ct(factor);
     }
@@ -1317,15 +1397,18 @@ void ChAssembly::ConstraintsBiLoad_Ct(double factor) {
 }
 
 void ChAssembly::ConstraintsBiLoad_Qc(double factor) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiLoad_Qc(factor);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsBiLoad_Qc(factor);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiLoad_Qc(factor);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->ConstraintsBiLoad_Qc(factor);
     }
@@ -1335,12 +1418,14 @@ void ChAssembly::ConstraintsBiLoad_Qc(double factor) {
 }
 
 void ChAssembly::ConstraintsFbLoadForces(double factor) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsFbLoadForces(factor);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsFbLoadForces(factor);
-    }
+    });
     for (auto& link : linklist) {
         link->ConstraintsFbLoadForces(factor);
     }
@@ -1353,15 +1438,18 @@ void ChAssembly::ConstraintsFbLoadForces(double factor) {
 }
 
 void ChAssembly::ConstraintsLoadJacobians() {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsLoadJacobians();
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsLoadJacobians();
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->ConstraintsLoadJacobians();
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->ConstraintsLoadJacobians();
     }
@@ -1371,15 +1459,18 @@ void ChAssembly::ConstraintsLoadJacobians() {
 }
 
 void ChAssembly::ConstraintsFetch_react(double factor) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsFetch_react(factor);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->ConstraintsFetch_react(factor);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->ConstraintsFetch_react(factor);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->ConstraintsFetch_react(factor);
     }
@@ -1407,15 +1498,18 @@ void ChAssembly::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
-    for (auto& body : bodylist) {
+    ForEachItem((int)bodylist.size(), [&](int ip) {
+        auto& body = bodylist[ip];
         body->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
-    }
-    for (auto& shaft : shaftlist) {
+    });
+    ForEachItem((int)shaftlist.size(), [&](int ip) {
+        auto& shaft = shaftlist[ip];
         shaft->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
-    }
-    for (auto& link : linklist) {
+    });
+    ForEachItem((int)linklist.size(), [&](int ip) {
+        auto& link = linklist[ip];
         link->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
-    }
+    });
     for (auto& mesh : meshlist) {
         mesh->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
     }
@@ -116,6 +116,15 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// Get the list of physics items that are not in the body or link lists.
     const std::vector<std::shared_ptr<ChPhysicsItem>>& Get_otherphysicslist() const { return otherphysicslist; }
 
+    /// Set the minimum number of bodies, shafts, or links for processing them in parallel (default: 1000).
+    /// Per-item loops (state gather/scatter, residual loads, solver interface, etc.) over lists with fewer items are
+    /// executed sequentially, to avoid the threading overhead for small systems. The number of threads used is the
+    /// number of Chrono threads specified through ChSystem::SetNumThreads.
+    void SetParallelThreshold(int threshold) { parallel_threshold = threshold; }
+
+    /// Get the minimum number of items for parallel processing.
+    int GetParallelThreshold() const { return parallel_threshold; }
+
     /// Search a body by its name.
     std::shared_ptr<ChBody> SearchBody(const char* name);
     /// Search a body by its ID
@@ -321,6 +330,10 @@ class ChApi ChAssembly : public ChPhysicsItem {
   protected:
     virtual void SetupInitial() override;
 
+    /// Invoke func(ip) for all ip in [0, nitems), in parallel if nitems exceeds the parallel threshold.
+    template <typename Func>
+    void ForEachItem(int nitems, Func func);
+
     std::vector<std::shared_ptr<ChBody>> bodylist;                 ///< list of rigid bodies
     std::vector<std::shared_ptr<ChShaft>> shaftlist;               ///< list of 1-D shafts
     std::vector<std::shared_ptr<ChLinkBase>> linklist;             ///< list of joints (links)
@@ -349,6 +362,8 @@ class ChApi ChAssembly : public ChPhysicsItem {
     int ndoc_w_C;    ///< number of scalar constraints C, when using 3 rot. dof. per body (excluding unilaterals)
     int ndoc_w_D;    ///< number of scalar constraints D, when using 3 rot. dof. per body (only unilaterals)
 
+    int parallel_threshold;  ///< minimum number of items for parallel processing
+
     friend class ChSystem;
     friend class ChSystemMulticore;
     friend class ChSystemDistributed;
@@ -22,6 +22,7 @@
 
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/collision/ChCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
@@ -60,6 +61,14 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// A composite contact material is created from their material properties.
     virtual void AddContact(const collision::ChCollisionInfo& cinfo) = 0;
 
+    /// Add a batch of contacts between collision shapes, storing them into this container.
+    /// The collision info objects are assumed to contain valid pointers to the colliding shapes.
+    /// The default implementation adds the contacts one at a time; derived classes may process the batch in parallel.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& cinfo_list) {
+        for (const auto& cinfo : cinfo_list)
+            AddContact(cinfo);
+    }
+
     /// The collision system will call EndAddContact() after adding all contacts (for example with AddContact() or
     /// similar).
     virtual void EndAddContact() {}
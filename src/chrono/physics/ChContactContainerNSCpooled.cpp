@@ -0,0 +1,393 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include "chrono/physics/ChContactContainerNSCpooled.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+
+using namespace collision;
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChContactContainerNSCpooled)
+
+ChContactContainerNSCpooled::ChContactContainerNSCpooled() : n_contacts(0), n_doc(0) {}
+
+ChContactContainerNSCpooled::ChContactContainerNSCpooled(const ChContactContainerNSCpooled& other)
+    : ChContactContainerNSC(other), n_contacts(0), n_doc(0) {}
+
+void ChContactContainerNSCpooled::RemoveAllContacts() {
+    ForEachPool([](auto& pool, int stride) {
+        pool.contacts.clear();
+        pool.n_added = 0;
+    });
+    n_contacts = 0;
+    n_doc = 0;
+}
+
+void ChContactContainerNSCpooled::BeginAddContact() {
+    ForEachPool([](auto& pool, int stride) { pool.n_added = 0; });
+    n_contacts = 0;
+    n_doc = 0;
+}
+
+void ChContactContainerNSCpooled::EndAddContact() {
+    n_contacts = 0;
+    n_doc = 0;
+    ForEachPool([this](auto& pool, int stride) {
+        // Release unused contacts only if the pool is much larger than currently needed. Popping from the back of a
+        // deque never moves the contacts still in use.
+        if (pool.contacts.size() > 2 * (size_t)pool.n_added + 64) {
+            while ((int)pool.contacts.size() > pool.n_added)
+                pool.contacts.pop_back();
+        }
+        n_contacts += pool.n_added;
+        n_doc += stride * pool.n_added;
+    });
+
+    data.p1.resize(n_contacts);
+    data.p2.resize(n_contacts);
+    data.normal.resize(n_contacts);
+    data.plane.resize(n_contacts);
+    data.distance.resize(n_contacts);
+    data.eff_radius.resize(n_contacts);
+    data.force.assign(n_contacts, VNULL);
+    data.torque.assign(n_contacts, VNULL);
+    data.objA.resize(n_contacts);
+    data.objB.resize(n_contacts);
+    data.offset_L.resize(n_contacts);
+
+    int i = 0;
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, ++i) {
+            data.p1[i] = contact->GetContactP1();
+            data.p2[i] = contact->GetContactP2();
+            data.normal[i] = contact->GetContactNormal();
+            data.plane[i] = contact->GetContactPlane();
+            data.distance[i] = contact->GetContactDistance();
+            data.eff_radius[i] = contact->GetEffectiveCurvatureRadius();
+            data.objA[i] = contact->GetObjA();
+            data.objB[i] = contact->GetObjB();
+            data.offset_L[i] = coffset;
+            coffset += stride;
+        }
+    });
+}
+
+void ChContactContainerNSCpooled::InsertContact(const ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
+    auto contactableA = cinfo.modelA->GetContactable();
+    auto contactableB = cinfo.modelB->GetContactable();
+
+    // Switch among the various cases of contacts (see ChContactContainerNSC::InsertContact).
+    switch (contactableA->GetContactableType()) {
+        case ChContactable::CONTACTABLE_3: {
+            auto objA = static_cast<ChContactable_1vars<3>*>(contactableA);
+            if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
+                auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
+                // 3_3
+                pool_3_3.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
+                auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
+                // 3_6 -> 6_3
+                ChCollisionInfo swapped_cinfo(cinfo, true);
+                pool_6_3.Insert(this, objB, objA, swapped_cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
+                auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
+                // 3_333 -> 333_3
+                ChCollisionInfo swapped_cinfo(cinfo, true);
+                pool_333_3.Insert(this, objB, objA, swapped_cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
+                auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
+                // 3_666 -> 666_3
+                ChCollisionInfo swapped_cinfo(cinfo, true);
+                pool_666_3.Insert(this, objB, objA, swapped_cinfo, cmat);
+            }
+        } break;
+
+        case ChContactable::CONTACTABLE_6: {
+            auto objA = static_cast<ChContactable_1vars<6>*>(contactableA);
+            if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
+                auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
+                // 6_3
+                pool_6_3.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
+                auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
+                // 6_6 (possibly with rolling friction)
+                if (cmat.rolling_friction || cmat.spinning_friction) {
+                    pool_6_6_rolling.Insert(this, objA, objB, cinfo, cmat);
+                } else {
+                    pool_6_6.Insert(this, objA, objB, cinfo, cmat);
+                }
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
+                auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
+                // 6_333 -> 333_6
+                ChCollisionInfo swapped_cinfo(cinfo, true);
+                pool_333_6.Insert(this, objB, objA, swapped_cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
+                auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
+                // 6_666 -> 666_6
+                ChCollisionInfo swapped_cinfo(cinfo, true);
+                pool_666_6.Insert(this, objB, objA, swapped_cinfo, cmat);
+            }
+        } break;
+
+        case ChContactable::CONTACTABLE_333: {
+            auto objA = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableA);
+            if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
+                auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
+                // 333_3
+                pool_333_3.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
+                auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
+                // 333_6
+                pool_333_6.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
+                auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
+                // 333_333
+                pool_333_333.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
+                auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
+                // 333_666 -> 666_333
+                ChCollisionInfo swapped_cinfo(cinfo, true);
+                pool_666_333.Insert(this, objB, objA, swapped_cinfo, cmat);
+            }
+        } break;
+
+        case ChContactable::CONTACTABLE_666: {
+            auto objA = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableA);
+            if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
+                auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
+                // 666_3
+                pool_666_3.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
+                auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
+                // 666_6
+                pool_666_6.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
+                auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
+                // 666_333
+                pool_666_333.Insert(this, objA, objB, cinfo, cmat);
+            } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
+                auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
+                // 666_666
+                pool_666_666.Insert(this, objA, objB, cinfo, cmat);
+            }
+        } break;
+
+        default:
+            break;
+    }
+}
+
+// Contact reactions of a plain (sliding friction) contact.
+template <class Tcont>
+static void _GatherReactions(Tcont& contact, ChVector<>& force, ChVector<>& torque) {
+    force = contact.GetContactForce();
+}
+
+// Contact reactions of a rolling friction contact.
+static void _GatherReactions(ChContactContainerNSC::ChContactNSCrolling_6_6& contact,
+                             ChVector<>& force,
+                             ChVector<>& torque) {
+    force = contact.GetContactForce();
+    torque = contact.GetContactTorque();
+}
+
+void ChContactContainerNSCpooled::GatherContactReactions() {
+    int i = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, ++i)
+            _GatherReactions(*contact, data.force[i], data.torque[i]);
+    });
+}
+
+void ChContactContainerNSCpooled::ComputeContactForces() {
+    GatherContactReactions();
+
+    contact_forces.clear();
+    for (int i = 0; i < n_contacts; i++) {
+        // Contact force, expressed in global frame. Recall that -force is applied to the first object.
+        ChVector<> force = data.plane[i] * data.force[i];
+
+        ChVector<> torque1(0);
+        if (ChBody* body = dynamic_cast<ChBody*>(data.objA[i]))
+            torque1 = Vcross(data.p1[i] - body->GetPos(), -force);
+
+        ChVector<> torque2(0);
+        if (ChBody* body = dynamic_cast<ChBody*>(data.objB[i]))
+            torque2 = Vcross(data.p2[i] - body->GetPos(), force);
+
+        auto& ft1 = contact_forces[data.objA[i]];
+        ft1.force -= force;
+        ft1.torque += torque1;
+
+        auto& ft2 = contact_forces[data.objB[i]];
+        ft2.force += force;
+        ft2.torque += torque2;
+    }
+}
+
+void ChContactContainerNSCpooled::ReportAllContacts(std::shared_ptr<ReportContactCallback> callback) {
+    GatherContactReactions();
+
+    for (int i = 0; i < n_contacts; i++) {
+        bool proceed = callback->OnReportContact(data.p1[i], data.p2[i], data.plane[i], data.distance[i],
+                                                 data.eff_radius[i], data.force[i], data.torque[i], data.objA[i],
+                                                 data.objB[i]);
+        if (!proceed)
+            break;
+    }
+}
+
+void ChContactContainerNSCpooled::ReportAllContactsNSC(std::shared_ptr<ReportContactCallbackNSC> callback) {
+    GatherContactReactions();
+
+    int i = 0;
+    bool proceed = true;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added && proceed; k++, ++contact, ++i) {
+            proceed = callback->OnReportContact(data.p1[i], data.p2[i], data.plane[i], data.distance[i],
+                                                data.eff_radius[i], data.force[i], data.torque[i], data.objA[i],
+                                                data.objB[i], contact->GetConstraintNx()->GetOffset());
+        }
+    });
+}
+
+////////// STATE INTERFACE ////
+
+void ChContactContainerNSCpooled::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, coffset += stride)
+            contact->ContIntStateGatherReactions(off_L + coffset, L);
+    });
+}
+
+void ChContactContainerNSCpooled::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, coffset += stride)
+            contact->ContIntStateScatterReactions(off_L + coffset, L);
+    });
+}
+
+void ChContactContainerNSCpooled::IntLoadResidual_CqL(const unsigned int off_L,
+                                                      ChVectorDynamic<>& R,
+                                                      const ChVectorDynamic<>& L,
+                                                      const double c) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, coffset += stride)
+            contact->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+    });
+}
+
+void ChContactContainerNSCpooled::IntLoadConstraint_C(const unsigned int off,
+                                                      ChVectorDynamic<>& Qc,
+                                                      const double c,
+                                                      bool do_clamp,
+                                                      double recovery_clamp) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, coffset += stride)
+            contact->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
+    });
+}
+
+void ChContactContainerNSCpooled::IntToDescriptor(const unsigned int off_v,
+                                                  const ChStateDelta& v,
+                                                  const ChVectorDynamic<>& R,
+                                                  const unsigned int off_L,
+                                                  const ChVectorDynamic<>& L,
+                                                  const ChVectorDynamic<>& Qc) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, coffset += stride)
+            contact->ContIntToDescriptor(off_L + coffset, L, Qc);
+    });
+}
+
+void ChContactContainerNSCpooled::IntFromDescriptor(const unsigned int off_v,
+                                                    ChStateDelta& v,
+                                                    const unsigned int off_L,
+                                                    ChVectorDynamic<>& L) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact, coffset += stride)
+            contact->ContIntFromDescriptor(off_L + coffset, L);
+    });
+}
+
+// SOLVER INTERFACES
+
+void ChContactContainerNSCpooled::InjectConstraints(ChSystemDescriptor& mdescriptor) {
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact)
+            contact->InjectConstraints(mdescriptor);
+    });
+}
+
+void ChContactContainerNSCpooled::ConstraintsBiReset() {
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact)
+            contact->ConstraintsBiReset();
+    });
+}
+
+void ChContactContainerNSCpooled::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool do_clamp) {
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact)
+            contact->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
+    });
+}
+
+void ChContactContainerNSCpooled::ConstraintsFetch_react(double factor) {
+    ForEachPool([&](auto& pool, int stride) {
+        auto contact = pool.contacts.begin();
+        for (int k = 0; k < pool.n_added; k++, ++contact)
+            contact->ConstraintsFetch_react(factor);
+    });
+}
+
+void ChContactContainerNSCpooled::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChContactContainerNSCpooled>();
+    // serialize parent class
+    ChContactContainerNSC::ArchiveOUT(marchive);
+    // NO SERIALIZATION of contacts because assume they are volatile and generated when needed
+}
+
+void ChContactContainerNSCpooled::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    /*int version =*/marchive.VersionRead<ChContactContainerNSCpooled>();
+    // deserialize parent class
+    ChContactContainerNSC::ArchiveIN(marchive);
+    // NO SERIALIZATION of contacts because assume they are volatile and generated when needed
+    RemoveAllContacts();
+}
+
+}  // end namespace chrono
@@ -0,0 +1,205 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_CONTACTCONTAINER_NSC_POOLED_H
+#define CH_CONTACTCONTAINER_NSC_POOLED_H
+
+#include <deque>
+#include <vector>
+
+#include "chrono/physics/ChContactContainerNSC.h"
+
+namespace chrono {
+
+/// Class representing a container of many non-smooth contacts, using contiguous (pooled) storage.
+/// This is an alternative to ChContactContainerNSC which can be set with ChSystem::SetContactContainer.
+/// Contact objects of each type are stored by value in a pool allocated in large chunks, and are reused in place from
+/// one collision detection pass to the next (contacts are never allocated or freed individually). As such, the
+/// constraint triplets of consecutive contacts are contiguous in memory and the solver-related loops do not chase
+/// pointers through linked lists.
+/// In addition, the geometric information of all contacts (points, normals, distances) and their reactions are
+/// maintained in contiguous arrays (structure-of-arrays), in the same order as the contact reactions in the vector of
+/// Lagrange multipliers. These arrays are used for contact reporting and for computing the contact forces on the
+/// contactable objects, and can be accessed directly through GetContactData().
+class ChApi ChContactContainerNSCpooled : public ChContactContainerNSC {
+  public:
+    /// Contiguous per-contact data.
+    struct ContactData {
+        std::vector<ChVector<>> p1;           ///< contact point on object A (absolute frame)
+        std::vector<ChVector<>> p2;           ///< contact point on object B (absolute frame)
+        std::vector<ChVector<>> normal;       ///< contact normal (absolute frame)
+        std::vector<ChMatrix33<>> plane;      ///< contact plane coordinate system (column 'X' is the contact normal)
+        std::vector<double> distance;         ///< contact distance
+        std::vector<double> eff_radius;       ///< effective radius of curvature at contact
+        std::vector<ChVector<>> force;        ///< contact reaction force (in contact plane coordinates)
+        std::vector<ChVector<>> torque;       ///< contact reaction torque (rolling contacts only)
+        std::vector<ChContactable*> objA;     ///< contactable object A
+        std::vector<ChContactable*> objB;     ///< contactable object B
+        std::vector<unsigned int> offset_L;   ///< offset of the contact reactions relative to the container
+    };
+
+    ChContactContainerNSCpooled();
+    ChContactContainerNSCpooled(const ChContactContainerNSCpooled& other);
+    virtual ~ChContactContainerNSCpooled() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChContactContainerNSCpooled* Clone() const override { return new ChContactContainerNSCpooled(*this); }
+
+    /// Report the number of added contacts.
+    virtual int GetNcontacts() const override { return n_contacts; }
+
+    /// Report the number of scalar unilateral constraints.
+    virtual int GetDOC_d() override { return n_doc; }
+
+    /// Remove (delete) all contained contact data and release the memory of the contact pools.
+    virtual void RemoveAllContacts() override;
+
+    /// The collision system will call BeginAddContact() before adding all contacts.
+    /// This implementation simply rewinds the contact pools, so that existing contact objects are reused.
+    virtual void BeginAddContact() override;
+
+    /// The collision system will call EndAddContact() after adding all contacts.
+    /// This implementation fills the contiguous per-contact data arrays and releases the unused part of a contact pool
+    /// only if it is much larger than needed.
+    virtual void EndAddContact() override;
+
+    /// Access the contiguous per-contact data.
+    /// Contact geometry is valid after EndAddContact(); contact reactions are valid after ComputeContactForces().
+    const ContactData& GetContactData() const { return data; }
+
+    /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
+    /// object.
+    virtual void ReportAllContacts(std::shared_ptr<ReportContactCallback> callback) override;
+
+    /// Scan all the NSC contacts and for each contact executes the OnReportContact() function of the provided callback
+    /// object.
+    virtual void ReportAllContactsNSC(std::shared_ptr<ReportContactCallbackNSC> callback) override;
+
+    /// Compute contact forces on all contactable objects in this container.
+    virtual void ComputeContactForces() override;
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    virtual void IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) override;
+    virtual void IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) override;
+    virtual void IntLoadResidual_CqL(const unsigned int off_L,
+                                     ChVectorDynamic<>& R,
+                                     const ChVectorDynamic<>& L,
+                                     const double c) override;
+    virtual void IntLoadConstraint_C(const unsigned int off,
+                                     ChVectorDynamic<>& Qc,
+                                     const double c,
+                                     bool do_clamp,
+                                     double recovery_clamp) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SOLVER INTERFACE
+    //
+
+    virtual void InjectConstraints(ChSystemDescriptor& mdescriptor) override;
+    virtual void ConstraintsBiReset() override;
+    virtual void ConstraintsBiLoad_C(double factor = 1, double recovery_clamp = 0.1, bool do_clamp = false) override;
+    virtual void ConstraintsFetch_react(double factor = 1) override;
+
+    //
+    // SERIALIZATION
+    //
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  protected:
+    /// Pool of contacts of a given type.
+    /// Contacts are stored by value; a std::deque is used since it never relocates existing elements when growing
+    /// (contact objects hold internal pointers between their constraints and must not be moved).
+    template <class Tcont>
+    struct ContactPool {
+        std::deque<Tcont> contacts;  ///< contact objects (only the first n_added are in use)
+        int n_added = 0;             ///< number of contacts in use
+
+        template <class Ta, class Tb>
+        void Insert(ChContactContainer* container,
+                    Ta* objA,
+                    Tb* objB,
+                    const collision::ChCollisionInfo& cinfo,
+                    const ChMaterialCompositeNSC& cmat) {
+            if (n_added < (int)contacts.size())
+                contacts[n_added].Reset(objA, objB, cinfo, cmat);
+            else
+                contacts.emplace_back(container, objA, objB, cinfo, cmat);
+            n_added++;
+        }
+    };
+
+    virtual void InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) override;
+
+    /// Invoke the given function on all contact pools, in the order of the contact reactions in the vector of Lagrange
+    /// multipliers. The function is called with the pool and the number of reactions per contact.
+    template <class F>
+    void ForEachPool(F f) {
+        f(pool_6_6, 3);
+        f(pool_6_3, 3);
+        f(pool_3_3, 3);
+        f(pool_333_3, 3);
+        f(pool_333_6, 3);
+        f(pool_333_333, 3);
+        f(pool_666_3, 3);
+        f(pool_666_6, 3);
+        f(pool_666_333, 3);
+        f(pool_666_666, 3);
+        f(pool_6_6_rolling, 6);
+    }
+
+    /// Copy the current contact reactions into the contiguous per-contact data arrays.
+    void GatherContactReactions();
+
+    ContactPool<ChContactNSC_6_6> pool_6_6;
+    ContactPool<ChContactNSC_6_3> pool_6_3;
+    ContactPool<ChContactNSC_3_3> pool_3_3;
+    ContactPool<ChContactNSC_333_3> pool_333_3;
+    ContactPool<ChContactNSC_333_6> pool_333_6;
+    ContactPool<ChContactNSC_333_333> pool_333_333;
+    ContactPool<ChContactNSC_666_3> pool_666_3;
+    ContactPool<ChContactNSC_666_6> pool_666_6;
+    ContactPool<ChContactNSC_666_333> pool_666_333;
+    ContactPool<ChContactNSC_666_666> pool_666_666;
+
+    ContactPool<ChContactNSCrolling_6_6> pool_6_6_rolling;
+
+    int n_contacts;  ///< total number of contacts in use
+    int n_doc;       ///< total number of scalar constraints
+
+    ContactData data;  ///< contiguous per-contact data
+};
+
+CH_CLASS_VERSION(ChContactContainerNSCpooled, 0)
+
+}  // end namespace chrono
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "chrono/physics/ChContactContainerSMC.h"
 #include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChOpenMP.h"
 
 namespace chrono {
 
@@ -368,6 +369,196 @@ void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinf
     }  // switch(contactableA->GetContactableType())
 }
 
+// Rank of a contactable type, in the order used for the contact lists (-1 if not supported).
+// A pair of contactables with ranks (hi, lo), hi >= lo, is stored in the list with index hi * (hi + 1) / 2 + lo.
+static int _ContactableRank(ChContactable::eChContactableType type) {
+    switch (type) {
+        case ChContactable::CONTACTABLE_3:
+            return 0;
+        case ChContactable::CONTACTABLE_6:
+            return 1;
+        case ChContactable::CONTACTABLE_333:
+            return 2;
+        case ChContactable::CONTACTABLE_666:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+template <class Tcont, class Titer>
+void* _ReserveContact(std::list<Tcont*>& contactlist,  // contact list
+                      Titer& lastcontact,              // last contact acquired
+                      int& n_added                     // number of contacts inserted
+) {
+    Tcont** slot;
+    if (lastcontact != contactlist.end()) {
+        // reuse old contacts
+        slot = &(*lastcontact);
+        lastcontact++;
+    } else {
+        // placeholder for new contact
+        contactlist.push_back(nullptr);
+        slot = &contactlist.back();
+        lastcontact = contactlist.end();
+    }
+    n_added++;
+    return slot;
+}
+
+template <class Ta, class Tb>
+void _ResetContact(void* slot,                               // list entry for the contact object
+                   ChContactContainer* container,            // contact container
+                   ChContactable* contactableA,              // collidable object A
+                   ChContactable* contactableB,              // collidable object B
+                   const collision::ChCollisionInfo& cinfo,  // collision information
+                   const ChMaterialCompositeSMC& cmat        // composite material
+) {
+    auto& contact = *static_cast<ChContactSMC<Ta, Tb>**>(slot);
+    auto objA = static_cast<Ta*>(contactableA);
+    auto objB = static_cast<Tb*>(contactableB);
+    if (contact)
+        contact->Reset(objA, objB, cinfo, cmat);
+    else
+        contact = new ChContactSMC<Ta, Tb>(container, objA, objB, cinfo, cmat);
+}
+
+void ChContactContainerSMC::AddContacts(const std::vector<collision::ChCollisionInfo>& cinfo_list) {
+    int nthreads = GetSystem()->GetNumThreadsChrono();
+
+    // A user callback may modify the composite materials, so process contacts one at a time.
+    if (nthreads <= 1 || GetAddContactCallback()) {
+        ChContactContainer::AddContacts(cinfo_list);
+        return;
+    }
+
+    // Filter contacts and reserve entries in the appropriate contact lists.
+    // This must be done sequentially, but does not involve any contact force calculation.
+    pending_contacts.clear();
+    for (const auto& cinfo : cinfo_list) {
+        assert(cinfo.modelA->GetContactable());
+        assert(cinfo.modelB->GetContactable());
+
+        // Do nothing if the shapes are separated
+        if (cinfo.distance >= 0)
+            continue;
+
+        auto contactableA = cinfo.modelA->GetContactable();
+        auto contactableB = cinfo.modelB->GetContactable();
+
+        // Do nothing if any of the contactables is not contact-active
+        if (!contactableA->IsContactActive() && !contactableB->IsContactActive())
+            continue;
+
+        // Check that the two collision models are compatible with penalty contact.
+        if (cinfo.shapeA->GetContactMethod() != ChContactMethod::SMC ||
+            cinfo.shapeB->GetContactMethod() != ChContactMethod::SMC) {
+            continue;
+        }
+
+        int rankA = _ContactableRank(contactableA->GetContactableType());
+        int rankB = _ContactableRank(contactableB->GetContactableType());
+        if (rankA < 0 || rankB < 0)
+            continue;
+
+        int hi = std::max(rankA, rankB);
+        int lo = std::min(rankA, rankB);
+        int type = hi * (hi + 1) / 2 + lo;
+
+        void* slot = nullptr;
+        switch (type) {
+            case 0:
+                slot = _ReserveContact(contactlist_3_3, lastcontact_3_3, n_added_3_3);
+                break;
+            case 1:
+                slot = _ReserveContact(contactlist_6_3, lastcontact_6_3, n_added_6_3);
+                break;
+            case 2:
+                slot = _ReserveContact(contactlist_6_6, lastcontact_6_6, n_added_6_6);
+                break;
+            case 3:
+                slot = _ReserveContact(contactlist_333_3, lastcontact_333_3, n_added_333_3);
+                break;
+            case 4:
+                slot = _ReserveContact(contactlist_333_6, lastcontact_333_6, n_added_333_6);
+                break;
+            case 5:
+                slot = _ReserveContact(contactlist_333_333, lastcontact_333_333, n_added_333_333);
+                break;
+            case 6:
+                slot = _ReserveContact(contactlist_666_3, lastcontact_666_3, n_added_666_3);
+                break;
+            case 7:
+                slot = _ReserveContact(contactlist_666_6, lastcontact_666_6, n_added_666_6);
+                break;
+            case 8:
+                slot = _ReserveContact(contactlist_666_333, lastcontact_666_333, n_added_666_333);
+                break;
+            case 9:
+                slot = _ReserveContact(contactlist_666_666, lastcontact_666_666, n_added_666_666);
+                break;
+        }
+
+        pending_contacts.push_back({type, slot, &cinfo, rankA < rankB});
+    }
+
+    //***PARALLEL FOR***, each pending contact writes only to its own list entry
+    int npending = (int)pending_contacts.size();
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < npending; i++)
+        ResetContact(pending_contacts[i]);
+}
+
+void ChContactContainerSMC::ResetContact(const PendingContact& pending) {
+    // Create the composite material
+    ChMaterialCompositeSMC cmat(GetSystem()->composition_strategy.get(),
+                                std::static_pointer_cast<ChMaterialSurfaceSMC>(pending.cinfo->shapeA->GetMaterial()),
+                                std::static_pointer_cast<ChMaterialSurfaceSMC>(pending.cinfo->shapeB->GetMaterial()));
+
+    // Initialize the contact (this calculates the contact force and, if needed, the contact Jacobians)
+    collision::ChCollisionInfo cinfo(*pending.cinfo, pending.swap);
+    auto contactableA = cinfo.modelA->GetContactable();
+    auto contactableB = cinfo.modelB->GetContactable();
+
+    typedef ChContactable_1vars<3> C_3;
+    typedef ChContactable_1vars<6> C_6;
+    typedef ChContactable_3vars<3, 3, 3> C_333;
+    typedef ChContactable_3vars<6, 6, 6> C_666;
+
+    switch (pending.type) {
+        case 0:
+            _ResetContact<C_3, C_3>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 1:
+            _ResetContact<C_6, C_3>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 2:
+            _ResetContact<C_6, C_6>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 3:
+            _ResetContact<C_333, C_3>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 4:
+            _ResetContact<C_333, C_6>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 5:
+            _ResetContact<C_333, C_333>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 6:
+            _ResetContact<C_666, C_3>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 7:
+            _ResetContact<C_666, C_6>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 8:
+            _ResetContact<C_666, C_333>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+        case 9:
+            _ResetContact<C_666, C_666>(pending.slot, this, contactableA, contactableB, cinfo, cmat);
+            break;
+    }
+}
+
 void ChContactContainerSMC::ComputeContactForces() {
     contact_forces.clear();
     SumAllContactForces(contactlist_3_3, contact_forces);
@@ -437,17 +628,78 @@ void _IntLoadResidual_F(std::list<Tcont*>& contactlist, ChVectorDynamic<>& R, co
     }
 }
 
+// Load the residual terms of a share of the given contacts into the per-thread vector R_thread.
+// Must be called from within a parallel region (no implied barrier).
+template <class Tcont>
+void _IntLoadResidual_F_thread(const std::vector<Tcont*>& contacts, ChVectorDynamic<>& R_thread, const double c) {
+    int ncontacts = (int)contacts.size();
+#pragma omp for schedule(static) nowait
+    for (int i = 0; i < ncontacts; i++)
+        contacts[i]->ContIntLoadResidual_F(R_thread, c);
+}
+
 void ChContactContainerSMC::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
-    _IntLoadResidual_F(contactlist_3_3, R, c);
-    _IntLoadResidual_F(contactlist_6_3, R, c);
-    _IntLoadResidual_F(contactlist_6_6, R, c);
-    _IntLoadResidual_F(contactlist_333_3, R, c);
-    _IntLoadResidual_F(contactlist_333_6, R, c);
-    _IntLoadResidual_F(contactlist_333_333, R, c);
-    _IntLoadResidual_F(contactlist_666_3, R, c);
-    _IntLoadResidual_F(contactlist_666_6, R, c);
-    _IntLoadResidual_F(contactlist_666_333, R, c);
-    _IntLoadResidual_F(contactlist_666_666, R, c);
+    // Contacts write to the entries of R corresponding to their objects. Use per-thread copies of R (reduction)
+    // only if there are sufficiently many contacts to amortize the cost of the copies. In deterministic mode,
+    // accumulate the contact forces in list order (the partition of the contacts among threads would depend on the
+    // number of threads).
+    int nthreads = GetSystem()->IsDeterministicModeEnabled() ? 1 : GetSystem()->GetNumThreadsChrono();
+    if (nthreads <= 1 || 2 * (size_t)GetNcontacts() < (size_t)R.size()) {
+        _IntLoadResidual_F(contactlist_3_3, R, c);
+        _IntLoadResidual_F(contactlist_6_3, R, c);
+        _IntLoadResidual_F(contactlist_6_6, R, c);
+        _IntLoadResidual_F(contactlist_333_3, R, c);
+        _IntLoadResidual_F(contactlist_333_6, R, c);
+        _IntLoadResidual_F(contactlist_333_333, R, c);
+        _IntLoadResidual_F(contactlist_666_3, R, c);
+        _IntLoadResidual_F(contactlist_666_6, R, c);
+        _IntLoadResidual_F(contactlist_666_333, R, c);
+        _IntLoadResidual_F(contactlist_666_666, R, c);
+        return;
+    }
+
+    std::vector<ChContactSMC_3_3*> contacts_3_3(contactlist_3_3.begin(), contactlist_3_3.end());
+    std::vector<ChContactSMC_6_3*> contacts_6_3(contactlist_6_3.begin(), contactlist_6_3.end());
+    std::vector<ChContactSMC_6_6*> contacts_6_6(contactlist_6_6.begin(), contactlist_6_6.end());
+    std::vector<ChContactSMC_333_3*> contacts_333_3(contactlist_333_3.begin(), contactlist_333_3.end());
+    std::vector<ChContactSMC_333_6*> contacts_333_6(contactlist_333_6.begin(), contactlist_333_6.end());
+    std::vector<ChContactSMC_333_333*> contacts_333_333(contactlist_333_333.begin(), contactlist_333_333.end());
+    std::vector<ChContactSMC_666_3*> contacts_666_3(contactlist_666_3.begin(), contactlist_666_3.end());
+    std::vector<ChContactSMC_666_6*> contacts_666_6(contactlist_666_6.begin(), contactlist_666_6.end());
+    std::vector<ChContactSMC_666_333*> contacts_666_333(contactlist_666_333.begin(), contactlist_666_333.end());
+    std::vector<ChContactSMC_666_666*> contacts_666_666(contactlist_666_666.begin(), contactlist_666_666.end());
+
+    // One copy of R per thread, shared by all contact lists. The copies are then summed into R in thread order, with
+    // the entries of R split among threads.
+    std::vector<ChVectorDynamic<>> R_thread(nthreads);
+    int n = (int)R.size();
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        auto& R_t = R_thread[ChOMP::GetThreadNum()];
+        R_t.setZero(n);
+
+        _IntLoadResidual_F_thread(contacts_3_3, R_t, c);
+        _IntLoadResidual_F_thread(contacts_6_3, R_t, c);
+        _IntLoadResidual_F_thread(contacts_6_6, R_t, c);
+        _IntLoadResidual_F_thread(contacts_333_3, R_t, c);
+        _IntLoadResidual_F_thread(contacts_333_6, R_t, c);
+        _IntLoadResidual_F_thread(contacts_333_333, R_t, c);
+        _IntLoadResidual_F_thread(contacts_666_3, R_t, c);
+        _IntLoadResidual_F_thread(contacts_666_6, R_t, c);
+        _IntLoadResidual_F_thread(contacts_666_333, R_t, c);
+        _IntLoadResidual_F_thread(contacts_666_666, R_t, c);
+
+#pragma omp barrier
+
+#pragma omp for schedule(static)
+        for (int i = 0; i < n; i++) {
+            double sum = 0;
+            for (int t = 0; t < nthreads; t++)
+                sum += R_thread[t][i];
+            R[i] += sum;
+        }
+    }
 }
 
 template <class Tcont>
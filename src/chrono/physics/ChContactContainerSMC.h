@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cmath>
 #include <list>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChContactSMC.h"
@@ -111,6 +112,12 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     /// A composite contact material is created from their material properties.
     virtual void AddContact(const collision::ChCollisionInfo& cinfo) override;
 
+    /// Add a batch of contacts between collision shapes, storing them into this container.
+    /// If the containing system uses more than one thread, the composite materials, contact forces, and contact
+    /// Jacobians (for stiff contact) are evaluated in parallel. The contacts are added one at a time if a callback for
+    /// modifying the composite materials was registered (such callbacks are not assumed to be thread safe).
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& cinfo_list) override;
+
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
     /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
     virtual void EndAddContact() override;
@@ -135,6 +142,8 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     // STATE FUNCTIONS
 
+    /// Load contact forces in the residual R += c * F.
+    /// With multiple threads, contact forces are accumulated in per-thread copies of R which are then summed up.
     virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
     virtual void InjectKRMmatrices(ChSystemDescriptor& mdescriptor) override;
@@ -152,7 +161,18 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
 
   private:
+    /// Contact slot reserved during a bulk insertion.
+    struct PendingContact {
+        int type;                                  ///< contact list type
+        void* slot;                                ///< list entry for the contact object (holds null if new contact)
+        const collision::ChCollisionInfo* cinfo;  ///< collision information
+        bool swap;                                 ///< swap objects (and collision information)
+    };
+
     void InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeSMC& cmat);
+    void ResetContact(const PendingContact& pending);
+
+    std::vector<PendingContact> pending_contacts;  ///< contacts reserved during bulk insertion
 };
 
 CH_CLASS_VERSION(ChContactContainerSMC, 0)
@@ -13,6 +13,8 @@
 // =============================================================================
 
 #include <algorithm>
+#include <typeinfo>
+#include <unordered_map>
 
 #include "chrono/collision/ChCollisionSystemBullet.h"
 #ifdef CHRONO_COLLISION
@@ -21,6 +23,7 @@
 #include "chrono/assets/ChVisualSystem.h"
 #include "chrono/physics/ChProximityContainer.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChDescriptorCapture.h"
 #include "chrono/solver/ChSolverAPGD.h"
 #include "chrono/solver/ChSolverBB.h"
 #include "chrono/solver/ChSolverPJacobi.h"
@@ -58,18 +61,22 @@ ChSystem::ChSystem()
       tol_force(-1),
       maxiter(6),
       use_sleeping(false),
+      use_islands(false),
+      num_islands(0),
       min_bounce_speed(0.15),
       max_penetration_recovery_speed(0.6),
       stepcount(0),
       setupcount(0),
       solvecount(0),
       write_matrix(false),
+      capture_problem(false),
       ncontacts(0),
       composition_strategy(new ChMaterialCompositionStrategy),
       visual_system(nullptr),
       nthreads_chrono(ChOMP::GetNumProcs()),
       nthreads_eigen(1),
       nthreads_collision(1),
+      deterministic(false),
       last_err(false),
       applied_forces_current(false) {
     assembly.system = this;
@@ -105,11 +112,14 @@ ChSystem::ChSystem(const ChSystem& other) {
     setupcount = other.setupcount;
     write_matrix = other.write_matrix;
     output_dir = other.output_dir;
+    capture_problem = other.capture_problem;
+    capture_output_dir = other.capture_output_dir;
     SetTimestepperType(other.GetTimestepperType());
     tol_force = other.tol_force;
     nthreads_chrono = other.nthreads_chrono;
     nthreads_eigen = other.nthreads_eigen;
     nthreads_collision = other.nthreads_collision;
+    deterministic = other.deterministic;
     is_initialized = false;
     is_updated = false;
     applied_forces_current = false;
@@ -123,6 +133,8 @@ ChSystem::ChSystem(const ChSystem& other) {
     max_penetration_recovery_speed = other.max_penetration_recovery_speed;
     SetSolverType(other.GetSolverType());
     use_sleeping = other.use_sleeping;
+    use_islands = other.use_islands;
+    num_islands = 0;
 
     ncontacts = other.ncontacts;
 
@@ -313,6 +325,11 @@ void ChSystem::EnableSolverMatrixWrite(bool val, const std::string& out_dir) {
     output_dir = out_dir;
 }
 
+void ChSystem::EnableSolverProblemCapture(bool val, const std::string& out_dir) {
+    capture_problem = val;
+    capture_output_dir = out_dir;
+}
+
 // -----------------------------------------------------------------------------
 
 void ChSystem::RegisterCustomCollisionCallback(std::shared_ptr<CustomCollisionCallback> callback) {
@@ -331,6 +348,8 @@ void ChSystem::UnregisterCustomCollisionCallback(std::shared_ptr<CustomCollision
 void ChSystem::SetSystemDescriptor(std::shared_ptr<ChSystemDescriptor> newdescriptor) {
     assert(newdescriptor);
     descriptor = newdescriptor;
+    descriptor->SetNumThreads(nthreads_chrono);
+    descriptor->EnableDeterministicMode(deterministic);
 }
 void ChSystem::SetSolver(std::shared_ptr<ChSolver> newsolver) {
     assert(newsolver);
@@ -390,6 +409,14 @@ void ChSystem::SetNumThreads(int num_threads_chrono, int num_threads_collision,
     nthreads_eigen = (num_threads_eigen <= 0) ? num_threads_chrono : num_threads_eigen;
 
     collision_system->SetNumThreads(nthreads_collision);
+    if (descriptor)
+        descriptor->SetNumThreads(nthreads_chrono);
+}
+
+void ChSystem::EnableDeterministicMode(bool val) {
+    deterministic = val;
+    if (descriptor)
+        descriptor->EnableDeterministicMode(deterministic);
 }
 
 // -----------------------------------------------------------------------------
@@ -415,6 +442,12 @@ void ChSystem::SetupInitial() {
         collision_system->SetNumThreads(nthreads_collision);
     }
 
+    // Set num threads available to the solver
+    if (descriptor) {
+        descriptor->SetNumThreads(nthreads_chrono);
+        descriptor->EnableDeterministicMode(deterministic);
+    }
+
     assembly.SetupInitial();
     is_initialized = true;
 }
@@ -506,134 +539,213 @@ void ChSystem::SetTimestepperType(ChTimestepper::Type type) {
     }
 }
 
+// Create a copy of the given solver, for concurrent use on a separate system descriptor.
+// Only iterative VI solvers which do not share state with their copies are supported.
+static std::shared_ptr<ChIterativeSolverVI> CopyIterativeSolverVI(ChSolver* solver) {
+    if (typeid(*solver) == typeid(ChSolverPSOR))
+        return chrono_types::make_shared<ChSolverPSOR>(*static_cast<ChSolverPSOR*>(solver));
+    if (typeid(*solver) == typeid(ChSolverPSSOR))
+        return chrono_types::make_shared<ChSolverPSSOR>(*static_cast<ChSolverPSSOR*>(solver));
+    if (typeid(*solver) == typeid(ChSolverPJacobi))
+        return chrono_types::make_shared<ChSolverPJacobi>(*static_cast<ChSolverPJacobi*>(solver));
+    if (typeid(*solver) == typeid(ChSolverPMINRES))
+        return chrono_types::make_shared<ChSolverPMINRES>(*static_cast<ChSolverPMINRES*>(solver));
+    if (typeid(*solver) == typeid(ChSolverBB))
+        return chrono_types::make_shared<ChSolverBB>(*static_cast<ChSolverBB*>(solver));
+    if (typeid(*solver) == typeid(ChSolverAPGD))
+        return chrono_types::make_shared<ChSolverAPGD>(*static_cast<ChSolverAPGD*>(solver));
+    return nullptr;
+}
+
+bool ChSystem::SolveIslands() {
+    num_islands = 0;
+
+    // Matrix output is not supported for individual islands
+    if (write_matrix)
+        return false;
+
+    auto master = CopyIterativeSolverVI(solver.get());
+    if (!master)
+        return false;
+
+    if (!island_decomposition.Update(*descriptor) || island_decomposition.GetNumIslands() < 2)
+        return false;
+
+    num_islands = island_decomposition.GetNumIslands();
+
+    // One copy of the solver per thread (solver parameters may have changed since the last call)
+    int nthreads = std::max(1, std::min(nthreads_chrono, num_islands));
+    island_solvers.resize(nthreads);
+    island_solvers[0] = master;
+    for (int i = 1; i < nthreads; i++)
+        island_solvers[i] = CopyIterativeSolverVI(solver.get());
+
+    std::vector<int> iterations(num_islands);
+
+    // Solve islands, largest first
+    //***PARALLEL FOR***
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (int i = 0; i < num_islands; i++) {
+        CH_PROFILE_ZONE("Solver_island");
+        auto& island = island_decomposition.GetIsland(i);
+        island.EndInsertion();
+        auto& island_solver = island_solvers[ChOMP::GetThreadNum()];
+        island_solver->Solve(island);
+        iterations[i] = island_solver->GetIterations();
+    }
+
+    // Restore offsets of variables and constraints in the global system descriptor
+    descriptor->UpdateCountsAndOffsets();
+
+    // Report the largest number of iterations over all islands
+    if (auto vi_solver = std::dynamic_pointer_cast<ChIterativeSolverVI>(solver))
+        vi_solver->SetIterations(*std::max_element(iterations.begin(), iterations.end()));
+
+    return true;
+}
+
 bool ChSystem::ManageSleepingBodies() {
     if (!GetUseSleeping())
-        return 0;
+        return false;
 
-    // STEP 1:
-    // See if some body could change from no sleep-> sleep
+    // Sleeping is decided per island: bodies coupled through links or contacts (directly or indirectly) fall asleep
+    // together, and wake up together. Fixed bodies do not couple islands.
+    std::vector<std::shared_ptr<ChBody>>& bodies = assembly.bodylist;
+    auto nbodies = (int)bodies.size();
 
-    for (auto& body : assembly.bodylist) {
-        // mark as 'could sleep' candidate
-        body->TrySleeping();
+    std::unordered_map<ChBody*, int> body_index;
+    body_index.reserve(nbodies);
+    std::vector<int> parent(nbodies);
+
+    // STEP 1:
+    // Mark all bodies that could fall asleep. Bodies with user-applied forces are kept awake.
+    for (int i = 0; i < nbodies; i++) {
+        auto& body = bodies[i];
+        body_index[body.get()] = i;
+        parent[i] = i;
+        if (body->TrySleeping() &&
+            (body->Get_accumulated_force() != VNULL || body->Get_accumulated_torque() != VNULL)) {
+            body->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
+        }
     }
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one,
-    // if so, set to no sleep.
+    // Find the islands of bodies (union-find over bodies coupled by links and contacts).
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto merge_index = [&](int i1, int i2) {
+        int r1 = find(i1);
+        int r2 = find(i2);
+        if (r1 != r2)
+            parent[std::max(r1, r2)] = std::min(r1, r2);
+    };
+    auto merge = [&](ChBody* b1, ChBody* b2) {
+        if (!b1 || !b2 || b1->GetBodyFixed() || b2->GetBodyFixed())
+            return;
+        auto i1 = body_index.find(b1);
+        auto i2 = body_index.find(b2);
+        if (i1 == body_index.end() || i2 == body_index.end())
+            return;
+        merge_index(i1->second, i2->second);
+    };
+
+    // No contacts are generated between sleeping bodies, so sleeping islands are kept as recorded when they fell
+    // asleep. This way, a sleeping island wakes up as a whole as soon as one of its bodies is disturbed.
+    std::unordered_map<int, int> island_first;  // recorded island -> index of its first sleeping body
+    for (int i = 0; i < nbodies; i++) {
+        if (!bodies[i]->GetSleeping())
+            continue;
+        auto island = sleep_islands.find(bodies[i].get());
+        if (island == sleep_islands.end())
+            continue;
+        auto first = island_first.emplace(island->second, i);
+        if (!first.second)
+            merge_index(first.first->second, i);
+    }
 
-    // Make this class for iterating through contacts
+    for (auto& link : assembly.linklist) {
+        if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(link)) {
+            if (Lpointer->IsRequiringWaking())
+                merge(dynamic_cast<ChBody*>(Lpointer->GetBody1()), dynamic_cast<ChBody*>(Lpointer->GetBody2()));
+        }
+    }
 
-    class _wakeup_reporter_class : public ChContactContainer::ReportContactCallback {
+    // Collect the body-body contacts. Note that the contact container only includes contacts with at least one
+    // active object, so sleeping bodies are coupled here only to the awake bodies they touch.
+    class _contact_reporter_class : public ChContactContainer::ReportContactCallback {
       public:
-        // Callback, used to report contact points already added to the container.
-        // If returns false, the contact scanning will be stopped.
-        virtual bool OnReportContact(
-            const ChVector<>& pA,             // get contact pA
-            const ChVector<>& pB,             // get contact pB
-            const ChMatrix33<>& plane_coord,  // get contact plane coordsystem (A column 'X' is contact normal)
-            const double& distance,           // get contact distance
-            const double& eff_radius,         // effective radius of curvature at contact
-            const ChVector<>& react_forces,   // get react.forces (if already computed). In coordsystem 'plane_coord'
-            const ChVector<>& react_torques,  // get react.torques, if rolling friction (if already computed).
-            ChContactable* contactobjA,  // get model A (note: some containers may not support it and could be zero!)
-            ChContactable* contactobjB   // get model B (note: some containers may not support it and could be zero!)
-            ) override {
-            if (!(contactobjA && contactobjB))
-                return true;
+        virtual bool OnReportContact(const ChVector<>& pA,
+                                     const ChVector<>& pB,
+                                     const ChMatrix33<>& plane_coord,
+                                     const double& distance,
+                                     const double& eff_radius,
+                                     const ChVector<>& react_forces,
+                                     const ChVector<>& react_torques,
+                                     ChContactable* contactobjA,
+                                     ChContactable* contactobjB) override {
             ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
             ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            if (could_sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            someone_sleeps = sleep1 | sleep2 | someone_sleeps;
-
+            if (b1 && b2)
+                pairs.push_back(std::make_pair(b1, b2));
             return true;  // to continue scanning contacts
         }
 
-        // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
+        std::vector<std::pair<ChBody*, ChBody*>> pairs;
     };
 
-    auto my_waker = chrono_types::make_shared<_wakeup_reporter_class>();
-    my_waker->need_Setup_A = false;
-
-    bool need_Setup_L = false;
+    auto reporter = chrono_types::make_shared<_contact_reporter_class>();
+    contact_container->ReportAllContacts(reporter);
+    for (const auto& pair : reporter->pairs)
+        merge(pair.first, pair.second);
+
+    // STEP 3:
+    // An island is kept awake if it contains at least one awake body which cannot fall asleep, or a sleeping body
+    // with user-applied forces. Otherwise, all bodies in the island fall asleep.
+    std::vector<char> awake(nbodies, 0);
+    for (int i = 0; i < nbodies; i++) {
+        auto& body = bodies[i];
+        if (body->GetBodyFixed())
+            continue;
+        bool forced = body->Get_accumulated_force() != VNULL || body->Get_accumulated_torque() != VNULL;
+        if (forced || (!body->GetSleeping() && !body->BFlagGet(ChBody::BodyFlag::COULDSLEEP)))
+            awake[find(i)] = 1;
+    }
 
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker->someone_sleeps = false;
-
-        // scan all links and wake connected bodies
-        for (auto& link : assembly.linklist) {
-            if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(link)) {
-                if (Lpointer->IsRequiringWaking()) {
-                    ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                    ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                    if (b1 && b2) {
-                        bool sleep1 = b1->GetSleeping();
-                        bool sleep2 = b2->GetSleeping();
-                        bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        if (sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (could_sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                        if (could_sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                    }
-                }
+    // Change the sleep state of bodies as needed. Collision models of sleeping bodies are not synchronized at each
+    // step (see ChAssembly::SyncCollisionModels), so do it here to let the collision system know of the new state.
+    bool changed = false;
+    for (int i = 0; i < nbodies; i++) {
+        auto& body = bodies[i];
+        if (body->GetBodyFixed())
+            continue;
+        if (awake[find(i)]) {
+            if (body->GetSleeping()) {
+                body->SetSleeping(false);
+                body->SyncCollisionModels();
+                changed = true;
             }
+        } else if (body->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
+            body->SetSleeping(true);
+            body->SyncCollisionModels();
+            changed = true;
         }
-
-        // scan all contacts and wake neighboring bodies
-        contact_container->ReportAllContacts(my_waker);
-
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker->someone_sleeps)
-            break;
     }
 
-    /// If some body still must change from no sleep-> sleep, do it
-    int need_Setup_B = 0;
-    for (auto& body : assembly.bodylist) {
-        if (body->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
-            body->SetSleeping(true);
-            ++need_Setup_B;
-        }
+    // Record the island of each sleeping body
+    sleep_islands.clear();
+    for (int i = 0; i < nbodies; i++) {
+        if (bodies[i]->GetSleeping())
+            sleep_islands[bodies[i].get()] = find(i);
     }
 
     // if some body has been activated/deactivated because of sleep state changes,
     // the offsets and DOF counts must be updated:
-    if (my_waker->need_Setup_A || need_Setup_B || need_Setup_L) {
+    if (changed) {
         Setup();
         return true;
     }
@@ -1079,24 +1191,26 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
     // R and Qc vectors  --> solver sparse solver structures  (also sets L and Dv to warmstart)
     IntToDescriptor(0, Dv, R, 0, L, Qc);
 
-    // If the solver's Setup() must be called or if the solver's Solve() requires it,
-    // fill the sparse system structures with information in G and Cq.
-    if (force_setup || GetSolver()->SolveRequiresMatrix()) {
-        timer_jacobian.start();
+    timer_jacobian.start();
 
-        // Cq  matrix
-        ConstraintsLoadJacobians();
+    // Cq  matrix
+    // Always loaded, even if the solver's Setup() is not called, since the constraint jacobians are also used in the
+    // evaluation of the residuals (e.g., Cq'*L) at subsequent Newton iterations.
+    ConstraintsLoadJacobians();
 
+    // If the solver's Setup() must be called or if the solver's Solve() requires it,
+    // fill the sparse system structures with information in G.
+    if (force_setup || GetSolver()->SolveRequiresMatrix()) {
         // G matrix: M, K, R components
         if (c_a || c_v || c_x)
             KRMmatricesLoad(-c_x, -c_v, c_a);
 
         // For ChVariable objects without a ChKblock, just use the 'a' coefficient
         descriptor->SetMassFactor(c_a);
-
-        timer_jacobian.stop();
     }
 
+    timer_jacobian.stop();
+
     // Diagnostics:
     if (write_matrix) {
         const char* numformat = "%.12g";
@@ -1118,11 +1232,19 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
         StreamOUTdenseMatlabFormat(v, file_v);
     }
 
+    if (capture_problem) {
+        ChDescriptorCapture capture;
+        capture.Capture(*descriptor);
+        capture.Write(capture_output_dir + "/problem_" + std::to_string(stepcount) + "_" + std::to_string(solvecount) +
+                      ".dat");
+    }
+
     GetSolver()->EnableWrite(write_matrix, std::to_string(stepcount) + "_" + std::to_string(solvecount), output_dir);
 
     // If indicated, first perform a solver setup.
     // Return 'false' if the setup phase fails.
     if (force_setup) {
+        CH_PROFILE_ZONE("Solver_setup");
         timer_ls_setup.start();
         bool success = GetSolver()->Setup(*descriptor);
         timer_ls_setup.stop();
@@ -1133,9 +1255,13 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
 
     // Solve the problem
     // The solution is scattered in the provided system descriptor
-    timer_ls_solve.start();
-    GetSolver()->Solve(*descriptor);
-    timer_ls_solve.stop();
+    {
+        CH_PROFILE_ZONE("Solver_solve");
+        timer_ls_solve.start();
+        if (!use_islands || !SolveIslands())
+            GetSolver()->Solve(*descriptor);
+        timer_ls_solve.stop();
+    }
 
     // Dv and L vectors  <-- sparse solver structures
     IntFromDescriptor(0, Dv, 0, L);
@@ -1420,6 +1546,8 @@ void ChSystem::DumpSystemMatrices(bool save_M, bool save_K, bool save_R, bool sa
 // -----------------------------------------------------------------------------
 
 int ChSystem::DoStepDynamics(double step_size) {
+    CH_PROFILE_ZONE("System_step");
+
     if (!is_initialized)
         SetupInitial();
 
@@ -2077,6 +2205,151 @@ void ChSystem::ArchiveIN(ChArchiveIn& marchive) {
     Setup();
 }
 
+void ChSystem::CheckpointOUT(ChArchiveOut& marchive) {
+    // The counts and offsets of the state vectors are those from the last setup of the system (e.g., at the last step)
+    if (!is_initialized)
+        throw ChException("ChSystem::CheckpointOUT: the system was not set up");
+
+    // version number
+    marchive.VersionWrite<ChSystem>();
+
+    // Sleep state of bodies (this determines the size of the state vectors)
+    std::vector<int> sleeping;
+    std::vector<double> sleep_start;
+    for (const auto& body : assembly.bodylist) {
+        sleeping.push_back(body->GetSleeping());
+        sleep_start.push_back(body->sleep_starttime);
+    }
+    marchive << CHNVP(sleeping);
+    marchive << CHNVP(sleep_start);
+
+    // Sizes, used for consistency checks
+    int nitems = (int)(assembly.bodylist.size() + assembly.shaftlist.size() + assembly.linklist.size() +
+                       assembly.meshlist.size() + assembly.otherphysicslist.size());
+    int nx = GetNcoords_x();
+    int nv = GetNcoords_v();
+    int nL = assembly.ndoc_w;
+    int ttype = static_cast<int>(timestepper->GetType());
+    marchive << CHNVP(nitems);
+    marchive << CHNVP(nx);
+    marchive << CHNVP(nv);
+    marchive << CHNVP(nL);
+    marchive << CHNVP(ttype);
+
+    marchive << CHNVP(ch_time);
+    marchive << CHNVP(stepcount);
+
+    // State of all physics items. Only the Lagrange multipliers of the assembly (links, etc.) are stored, since
+    // contacts are regenerated at the beginning of the next step; their reactions (used for warm starting) are
+    // stored by the collision system.
+    ChState x(nx, this);
+    ChStateDelta v(nv, this);
+    ChStateDelta a(nv, this);
+    ChVectorDynamic<> L(nL);
+    double T;
+    StateGather(x, v, T);
+    StateGatherAcceleration(a);
+    assembly.IntStateGatherReactions(0, L);
+    marchive << CHNVP(x);
+    marchive << CHNVP(v);
+    marchive << CHNVP(a);
+    marchive << CHNVP(L);
+
+    // Body rotation derivatives (not exactly recovered from the angular velocities and accelerations)
+    std::vector<double> rot_dt;
+    std::vector<double> rot_dtdt;
+    for (const auto& body : assembly.bodylist) {
+        for (int i = 0; i < 4; i++) {
+            rot_dt.push_back(body->GetRot_dt()[i]);
+            rot_dtdt.push_back(body->GetRot_dtdt()[i]);
+        }
+    }
+    marchive << CHNVP(rot_dt);
+    marchive << CHNVP(rot_dtdt);
+
+    // Data carried over from one step to the next
+    timestepper->CheckpointOUT(marchive);
+    collision_system->CheckpointOUT(marchive);
+}
+
+void ChSystem::CheckpointIN(ChArchiveIn& marchive) {
+    // version number
+    /*int version =*/marchive.VersionRead<ChSystem>();
+
+    // Make sure the system is initialized, so that the restored state is not overwritten later
+    if (!is_initialized)
+        SetupInitial();
+
+    std::vector<int> sleeping;
+    std::vector<double> sleep_start;
+    marchive >> CHNVP(sleeping);
+    marchive >> CHNVP(sleep_start);
+    if (sleeping.size() != assembly.bodylist.size())
+        throw ChException("ChSystem::CheckpointIN: inconsistent number of bodies");
+    for (size_t i = 0; i < sleeping.size(); i++) {
+        assembly.bodylist[i]->SetSleeping(sleeping[i] != 0);
+        assembly.bodylist[i]->sleep_starttime = float(sleep_start[i]);
+    }
+
+    Setup();
+
+    int nitems, nx, nv, nL, ttype;
+    marchive >> CHNVP(nitems);
+    marchive >> CHNVP(nx);
+    marchive >> CHNVP(nv);
+    marchive >> CHNVP(nL);
+    marchive >> CHNVP(ttype);
+    if (nitems != (int)(assembly.bodylist.size() + assembly.shaftlist.size() + assembly.linklist.size() +
+                        assembly.meshlist.size() + assembly.otherphysicslist.size()))
+        throw ChException("ChSystem::CheckpointIN: inconsistent number of physics items");
+    if (nx != GetNcoords_x() || nv != GetNcoords_v() || nL != assembly.ndoc_w)
+        throw ChException("ChSystem::CheckpointIN: inconsistent number of states or constraints");
+    if (ttype != static_cast<int>(timestepper->GetType()))
+        throw ChException("ChSystem::CheckpointIN: inconsistent timestepper type");
+
+    marchive >> CHNVP(ch_time);
+    marchive >> CHNVP(stepcount);
+
+    ChState x(nx, this);
+    ChStateDelta v(nv, this);
+    ChStateDelta a(nv, this);
+    ChVectorDynamic<> L(nL);
+    marchive >> CHNVP(x);
+    marchive >> CHNVP(v);
+    marchive >> CHNVP(a);
+    marchive >> CHNVP(L);
+    StateScatter(x, v, ch_time, true);
+    StateScatterAcceleration(a);
+    assembly.IntStateScatterReactions(0, L);
+
+    // The system descriptor (variable offsets) and the constraint Jacobians are otherwise only set up when solving;
+    // they are needed at the beginning of the next step (e.g., for the residual Cq'*L at the current time). A
+    // timestepper that uses Jacobians evaluated at another state re-evaluates them there (see ChTimestepperHHT).
+    DescriptorPrepareInject(*descriptor);
+    ConstraintsLoadJacobians();
+
+    std::vector<double> rot_dt;
+    std::vector<double> rot_dtdt;
+    marchive >> CHNVP(rot_dt);
+    marchive >> CHNVP(rot_dtdt);
+    for (size_t ib = 0; ib < assembly.bodylist.size(); ib++) {
+        const double* q = &rot_dt[4 * ib];
+        const double* qq = &rot_dtdt[4 * ib];
+        assembly.bodylist[ib]->SetRot_dt(ChQuaternion<>(q[0], q[1], q[2], q[3]));
+        assembly.bodylist[ib]->SetRot_dtdt(ChQuaternion<>(qq[0], qq[1], qq[2], qq[3]));
+    }
+
+    timestepper->CheckpointIN(marchive);
+    collision_system->CheckpointIN(marchive);
+
+    // Synchronize collision models of all bodies, including sleeping ones
+    for (auto& body : assembly.bodylist)
+        body->SyncCollisionModels();
+
+    is_updated = true;
+    applied_forces_current = false;
+}
+
 #define CH_CHUNK_START "Chrono binary file start"
 #define CH_CHUNK_END "Chrono binary file end"
 
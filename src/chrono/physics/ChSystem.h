@@ -22,6 +22,7 @@
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <unordered_map>
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/core/ChLog.h"
@@ -33,6 +34,8 @@
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChSolver.h"
+#include "chrono/solver/ChIterativeSolverVI.h"
+#include "chrono/solver/ChIslandDecomposition.h"
 #include "chrono/timestepper/ChAssemblyAnalysis.h"
 #include "chrono/timestepper/ChIntegrable.h"
 #include "chrono/timestepper/ChTimestepper.h"
@@ -197,6 +200,20 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Get the current value of the force-level tolerance (used with iterative solvers only).
     double GetSolverForceTolerance() const { return tol_force; }
 
+    /// Enable/disable solving independent islands separately (default: false).
+    /// If enabled, the system descriptor is partitioned into islands of objects coupled through links, contacts, or
+    /// stiffness blocks (see ChIslandDecomposition). Each island is solved, to its own convergence, by a copy of the
+    /// current solver; islands are distributed over the Chrono threads (see SetNumThreads). This is supported only for
+    /// the PSOR, PSSOR, PJACOBI, PMINRES, BARZILAIBORWEIN, and APGD solvers; in all other cases (or if the system
+    /// consists of a single island), the descriptor is solved as a whole.
+    void EnableIslandSolver(bool val) { use_islands = val; }
+
+    /// Return true if independent islands are solved separately.
+    bool IsIslandSolverEnabled() const { return use_islands; }
+
+    /// Return the number of islands found during the last solve (0 if the island solver was not used).
+    int GetNumIslands() const { return num_islands; }
+
     /// Instead of using the default 'system descriptor', you can create your own custom descriptor
     /// (inherited from ChSystemDescriptor) and plug it into the system using this function.
     void SetSystemDescriptor(std::shared_ptr<ChSystemDescriptor> newdescriptor);
@@ -238,6 +255,16 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     int GetNumthreadsCollision() const { return nthreads_collision; }
     int GetNumthreadsEigen() const { return nthreads_eigen; }
 
+    /// Enable/disable deterministic mode (default: false).
+    /// If enabled, the multithreaded code paths which support it use a canonical ordering of contacts and fixed-order
+    /// reductions, so that simulation results are bit-for-bit reproducible regardless of the number of threads. This
+    /// covers the Chrono collision system, the FEA mesh loads, SMC contact forces, the multithreaded PSOR and PJacobi
+    /// solvers, and the SCM deformable terrain. It may come at a performance cost.
+    void EnableDeterministicMode(bool val);
+
+    /// Return true if deterministic mode is enabled.
+    bool IsDeterministicModeEnabled() const { return deterministic; }
+
     //
     // DATABASE HANDLING
     //
@@ -644,6 +671,9 @@ class ChApi ChSystem : public ChIntegrableIIorder {
                                    const double c          ///< a scaling factor
                                    ) override;
 
+    /// Evaluate the constraint Jacobians at the current state.
+    virtual void LoadConstraintJacobians() override { ConstraintsLoadJacobians(); }
+
     //
     // UTILITY FUNCTIONS
     //
@@ -724,6 +754,10 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// because the sleeping policy changed the totalDOFs and offsets.
     bool ManageSleepingBodies();
 
+    /// Solve the independent islands of the system descriptor separately (see EnableIslandSolver).
+    /// Returns false if the island decomposition cannot be used, in which case the descriptor was not solved.
+    bool SolveIslands();
+
     /// Performs a single dynamical simulation step, according to
     /// current values of:  Y, time, step  (and other minor settings)
     /// Depending on the integration type, it switches to one of the following:
@@ -793,6 +827,13 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     void EnableSolverMatrixWrite(bool val, const std::string& out_dir = ".");
     bool IsSolverMatrixWriteEnabled() const { return write_matrix; }
 
+    /// Enable/disable capture of the solver problems to binary files.
+    /// If enabled, the problem defined by the system descriptor is written, before each call to the solver, to a file
+    /// 'problem_[step]_[solve].dat' in the specified directory. Such files can be loaded with ChDescriptorCapture and
+    /// used to compare solvers offline, on exactly the same problem.
+    void EnableSolverProblemCapture(bool val, const std::string& out_dir = ".");
+    bool IsSolverProblemCaptureEnabled() const { return capture_problem; }
+
     /// Dump the current M mass matrix, K damping matrix, R damping matrix, Cq constraint jacobian
     /// matrix (at the current configuration). 
     /// These can be later used for linearized motion, modal analysis, buckling analysis, etc.
@@ -887,6 +928,25 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Method to allow deserialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive);
 
+    /// Write a checkpoint of the current system state.
+    /// Unlike ArchiveOUT, this does not serialize the system configuration (bodies, links, materials, etc.), but only
+    /// the data that evolves during a simulation: the simulation time and step counter, the sleep state of bodies,
+    /// the state of all physics items (positions, velocities, accelerations, and Lagrange multipliers of links), and
+    /// the data carried over from one step to the next by the timestepper and the collision system. Contacts are
+    /// regenerated from the body states at the beginning of the next step; their reactions, used for warm starting
+    /// the solver, are written by the collision system.
+    /// The system must have been set up (e.g., by taking at least one step) and is not modified.
+    void CheckpointOUT(ChArchiveOut& marchive);
+
+    /// Restore the system state from a checkpoint written with CheckpointOUT.
+    /// The system must have the same configuration as the one used to write the checkpoint (typically, it is
+    /// constructed by the same code). Restarting from the checkpoint continues the simulation along the same
+    /// trajectory, with the following exceptions: Bullet contact manifolds are rebuilt, so the contacts of a pair of
+    /// objects may differ if its manifold accumulated points over several steps; the narrowphase cache of the Chrono
+    /// collision system is discarded; and a Newton matrix reused across steps (see ChTimestepperHHT) is recomputed.
+    /// An exception is thrown if the checkpoint is inconsistent with the system configuration.
+    void CheckpointIN(ChArchiveIn& marchive);
+
     /// Process a ".chr" binary file containing the full system object
     /// hierarchy as exported -for example- by the R3D modeler, with chrono plug-in version,
     /// or by using the FileWriteChR() function.
@@ -924,10 +984,16 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     int maxiter;  ///< max iterations for nonlinear convergence in DoAssembly()
 
     bool use_sleeping;  ///< if true, put to sleep objects that come to rest
+    std::unordered_map<ChBody*, int> sleep_islands;  ///< island of each sleeping body, recorded when it fell asleep
 
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< system descriptor
     std::shared_ptr<ChSolver> solver;                ///< solver for DVI or DAE problem
 
+    bool use_islands;                            ///< if true, solve independent islands separately
+    int num_islands;                             ///< number of islands in last solve
+    ChIslandDecomposition island_decomposition;  ///< partition of the system descriptor into islands
+    std::vector<std::shared_ptr<ChIterativeSolverVI>> island_solvers;  ///< per-thread copies of the solver
+
     double min_bounce_speed;                ///< minimum speed for rebounce after impacts. Lower speeds are clamped to 0
     double max_penetration_recovery_speed;  ///< limit for the speed of penetration recovery (positive, speed of exiting)
 
@@ -939,6 +1005,9 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     bool write_matrix;       ///< write current system matrix to file(s); for debugging
     std::string output_dir;  ///< output directory for writing system matrices
 
+    bool capture_problem;            ///< write solver problems to binary file(s)
+    std::string capture_output_dir;  ///< output directory for solver problem captures
+
     int ncontacts;  ///< total number of contacts
 
     collision::ChCollisionSystemType collision_system_type;                     ///< type of the collision engine
@@ -952,6 +1021,7 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     int nthreads_chrono;
     int nthreads_eigen;
     int nthreads_collision;
+    bool deterministic;  ///< deterministic mode (results independent of number of threads)
 
     // timers for profiling execution speed
     ChTimer<double> timer_step;       ///< timer for integration step
@@ -894,6 +894,19 @@ class  ChArchiveOut : public ChArchive {
       virtual void out_array_between (ChValue& bVal, size_t msize) = 0;
       virtual void out_array_end (ChValue& bVal, size_t msize) = 0;
 
+        // for the elements of contiguous arrays of doubles (Eigen matrices, std::vector<double>), to be called
+        // between out_array_pre and out_array_end. Archives with a binary representation can write the entire
+        // block at once; by default, elements are serialized one by one.
+      virtual void out_array_data (ChValue& bVal, double* data, size_t msize) {
+          char buffer[21];
+          for (size_t i = 0; i < msize; ++i) {
+              sprintf(buffer, "%lu", (unsigned long)i);
+              ChNameValue<double> array_val(buffer, data[i]);
+              this->out(array_val);
+              this->out_array_between(bVal, msize);
+          }
+      }
+
 
       //---------------------------------------------------
 
@@ -935,6 +948,13 @@ class  ChArchiveOut : public ChArchive {
               this->out_array_between(specVal, bVal.value().size());
           }
           this->out_array_end(specVal, bVal.value().size());
+      }
+        // std::vector of doubles, serialized as a contiguous block
+      void out     (ChNameValue< std::vector<double> > bVal) {
+          ChValueSpecific< std::vector<double> > specVal(bVal.value(), bVal.name(), bVal.flags());
+          this->out_array_pre( specVal, bVal.value().size());
+          this->out_array_data( specVal, bVal.value().data(), bVal.value().size());
+          this->out_array_end( specVal, bVal.value().size());
       }
         // trick to wrap st::list container
       template<class T>
@@ -1205,6 +1225,18 @@ class  ChArchiveIn : public ChArchive {
       virtual void in_array_between (const char* name) = 0;
       virtual void in_array_end (const char* name) = 0;
 
+        // for the elements of contiguous arrays of doubles (see ChArchiveOut::out_array_data), to be called
+        // between in_array_pre and in_array_end.
+      virtual void in_array_data (const char* name, double* data, size_t msize) {
+          char idname[21];
+          for (size_t i = 0; i < msize; ++i) {
+              sprintf(idname, "%lu", (unsigned long)i);
+              ChNameValue<double> array_val(idname, data[i]);
+              this->in(array_val);
+              this->in_array_between(name);
+          }
+      }
+
       //---------------------------------------------------
 
            // trick to wrap enum mappers:
@@ -1251,6 +1283,14 @@ class  ChArchiveIn : public ChArchive {
               this->in_array_between(bVal.name());
           }
           this->in_array_end(bVal.name());
+      }
+             // std::vector of doubles, deserialized as a contiguous block
+      void in     (ChNameValue< std::vector<double> > bVal) {
+          size_t arraysize;
+          this->in_array_pre(bVal.name(), arraysize);
+          bVal.value().resize(arraysize);
+          this->in_array_data(bVal.name(), bVal.value().data(), arraysize);
+          this->in_array_end(bVal.name());
       }
              // trick to wrap st::list container
       template<class T>
@@ -70,6 +70,9 @@ class  ChArchiveOutBinary : public ChArchiveOut {
       }
       virtual void out_array_between (ChValue& bVal, size_t msize) {}
       virtual void out_array_end (ChValue& bVal, size_t msize) {}
+      virtual void out_array_data (ChValue& bVal, double* data, size_t msize) {
+            ostream->ArrayOutput(data, msize);
+      }
 
 
         // for custom c++ objects:
@@ -162,6 +165,9 @@ class  ChArchiveInBinary : public ChArchiveIn {
       }
       virtual void in_array_between (const char* name) {}
       virtual void in_array_end (const char* name) {}
+      virtual void in_array_data (const char* name, double* data, size_t msize) {
+            istream->ArrayInput(data, msize);
+      }
 
         //  for custom c++ objects:
       virtual void in     (ChNameValue<ChFunctorArchiveIn> bVal) {
@@ -82,8 +82,7 @@ class  ChArchiveOutJSON : public ChArchiveOut {
             comma_cr();
             indent();
             if (is_array.top()==false)
-                (*ostream) << "\"" << bVal.name() << "\"";
-            (*ostream) << "\t: ";
+                (*ostream) << "\"" << bVal.name() << "\"" << "\t: ";
             (*ostream) << bVal.value();
             ++nitems.top();
       }
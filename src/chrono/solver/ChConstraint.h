@@ -19,8 +19,12 @@
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
 
+#include <vector>
+
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -280,6 +284,12 @@ class ChApi ChConstraint {
     /// Same as Build_Cq, but puts the _transposed_ jacobian row as a column.
     virtual void Build_CqT(ChSparseMatrix& storage, int inscol) = 0;
 
+    /// Append to 'vars' the ChVariables objects referenced by this constraint.
+    /// Used by solvers that need the connectivity of the constraint graph (e.g. to color constraints for a
+    /// multithreaded sweep). Return false if the constraint cannot report its variables, in which case it must be
+    /// assumed coupled to all other constraints.
+    virtual bool GetVariables(std::vector<ChVariables*>& vars) const { return false; }
+
     /// Set offset in global q vector (set automatically by ChSystemDescriptor)
     void SetOffset(int moff) { offset = moff; }
 
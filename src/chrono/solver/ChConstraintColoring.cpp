@@ -0,0 +1,80 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include "chrono/solver/ChConstraintColoring.h"
+
+namespace chrono {
+
+void ChConstraintColoring::Update(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    auto nc = (unsigned int)mconstraints.size();
+
+    blocks.clear();
+    colors.clear();
+    serial.clear();
+
+    // Group constraints in blocks. As in the PSOR-like solvers, every three consecutive CONSTRAINT_FRIC constraints
+    // form one block (normal, u, v), since they are projected together onto the friction cone.
+    unsigned int ic = 0;
+    while (ic < nc) {
+        Block block{ic, 1};
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC && ic + 2 < nc)
+            block.size = 3;
+        if (mconstraints[ic]->IsActive())
+            blocks.push_back(block);
+        ic += block.size;
+    }
+
+    // Greedy coloring. For each variable (identified by its offset in the global 'q' vector), keep a bit mask of the
+    // colors of the blocks already acting on it; assign each block the smallest color not used by any of its variables.
+    masks.assign(sysd.CountActiveVariables() + 1, 0);
+
+    for (const auto& block : blocks) {
+        vars.clear();
+        bool known = true;
+        for (unsigned int i = 0; i < block.size; i++)
+            known = known && mconstraints[block.start + i]->GetVariables(vars);
+
+        if (!known) {
+            serial.push_back(block);
+            continue;
+        }
+
+        unsigned long long used = 0;
+        for (auto var : vars) {
+            if (var && var->IsActive())
+                used |= masks[var->GetOffset()];
+        }
+
+        int color = 0;
+        while (color < MAX_COLORS && (used & (1ULL << color)))
+            color++;
+
+        if (color == MAX_COLORS) {
+            serial.push_back(block);
+            continue;
+        }
+
+        for (auto var : vars) {
+            if (var && var->IsActive())
+                masks[var->GetOffset()] |= (1ULL << color);
+        }
+
+        if (color >= (int)colors.size())
+            colors.resize(color + 1);
+        colors[color].push_back(block);
+    }
+}
+
+}  // end namespace chrono
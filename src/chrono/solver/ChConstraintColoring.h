@@ -0,0 +1,78 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_CONSTRAINT_COLORING_H
+#define CH_CONSTRAINT_COLORING_H
+
+#include <vector>
+
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Partition of the constraints in a system descriptor into independent sets ("colors").
+/// Constraints are first grouped in blocks, where a block is either a single scalar constraint or the triplet of
+/// consecutive CONSTRAINT_FRIC constraints (normal, u, v) of a frictional contact, which projected solvers update
+/// together. Blocks are then greedily colored, in the order in which they appear in the descriptor, such that no two
+/// blocks of the same color act on a common active ChVariables object. All blocks of one color can therefore be
+/// processed concurrently by PSOR-like solvers without write conflicts on the variables 'q'.
+///
+/// The coloring only depends on the constraint graph and the order of the constraints, not on the number of threads.
+/// Blocks containing constraints that cannot report their variables (see ChConstraint::GetVariables), or that would
+/// require more than the maximum number of colors, are placed in a separate set which must be processed serially.
+class ChApi ChConstraintColoring {
+  public:
+    /// A block of consecutive constraints in the descriptor list.
+    struct Block {
+        unsigned int start;  ///< index of the first constraint in the block
+        unsigned int size;   ///< number of constraints in the block (1 or 3)
+    };
+
+    /// Maximum number of colors. Blocks that cannot be colored with fewer colors are processed serially.
+    static const int MAX_COLORS = 64;
+
+    ChConstraintColoring() {}
+
+    /// Compute the constraint blocks and their coloring for the given descriptor.
+    /// Only active constraint blocks are collected. The variable offsets in the descriptor must be up-to-date.
+    void Update(ChSystemDescriptor& sysd);
+
+    /// Return the number of colors in the current partition.
+    int GetNumColors() const { return (int)colors.size(); }
+
+    /// Return the list of blocks with the specified color.
+    const std::vector<Block>& GetColor(int color) const { return colors[color]; }
+
+    /// Return the list of blocks which could not be colored and must be processed serially.
+    const std::vector<Block>& GetSerialBlocks() const { return serial; }
+
+    /// Return the list of all active blocks, in descriptor order.
+    const std::vector<Block>& GetBlocks() const { return blocks; }
+
+  private:
+    std::vector<Block> blocks;               ///< all active blocks
+    std::vector<std::vector<Block>> colors;  ///< blocks, per color
+    std::vector<Block> serial;               ///< blocks that could not be colored
+    std::vector<unsigned long long> masks;   ///< colors already used by each variable (indexed by offset)
+    std::vector<ChVariables*> vars;          ///< scratch list of variables of the current block
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
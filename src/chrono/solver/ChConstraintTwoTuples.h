@@ -60,6 +60,13 @@ class ChConstraintTwoTuples : public ChConstraint {
     /// Access tuple b
     type_constraint_tuple_b& Get_tuple_b() { return tuple_b; }
 
+    /// Append the variable objects of both tuples to the given list.
+    virtual bool GetVariables(std::vector<ChVariables*>& vars) const override {
+        tuple_a.AppendVariables(vars);
+        tuple_b.AppendVariables(vars);
+        return true;
+    }
+
     virtual void Update_auxiliary() override {
         g_i = 0;
         tuple_a.Update_auxiliary(g_i);
@@ -13,6 +13,8 @@
 #ifndef CHCONSTRAINTTWOTUPLESCONTACTN_H
 #define CHCONSTRAINTTWOTUPLESCONTACTN_H
 
+#include <cmath>
+
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 
 namespace chrono {
@@ -29,6 +31,51 @@ class ChApi ChConstraintTwoTuplesContactNall {
     /// Set the cohesion
     void SetCohesion(double mcoh) { cohesion = mcoh; }
 
+    /// Project the multipliers (l_n, l_u, l_v) of a frictional contact onto the friction cone with the given friction
+    /// coefficient and cohesion. Anitescu-Tasora projection on cone generator and polar cone (contractive, but
+    /// performs correction on all three components: normal, u, v).
+    static void ProjectOntoFrictionCone(double friction, double cohesion, double& l_n, double& l_u, double& l_v) {
+        double f_n = l_n + cohesion;
+
+        // no friction? project to axis of upper cone
+        if (friction == 0) {
+            l_u = 0;
+            l_v = 0;
+            if (f_n < 0)
+                l_n = 0;
+            return;
+        }
+
+        double f_u = l_u;
+        double f_v = l_v;
+
+        double mu2 = friction * friction;
+        double f_n2 = f_n * f_n;
+        double f_t2 = (f_v * f_v + f_u * f_u);
+
+        // inside lower cone or close to origin? reset normal, u, v to zero!
+        if ((f_n <= 0 && f_t2 < f_n2 / mu2) || (f_n < 1e-14 && f_n > -1e-14)) {
+            l_n = 0;
+            l_u = 0;
+            l_v = 0;
+            return;
+        }
+
+        // inside upper cone? keep untouched!
+        if (f_t2 < f_n2 * mu2)
+            return;
+
+        // project orthogonally to generator segment of upper cone
+        double f_t = sqrt(f_t2);
+        double f_n_proj = (f_t * friction + f_n) / (mu2 + 1);
+        double f_t_proj = f_n_proj * friction;
+        double tproj_div_t = f_t_proj / f_t;
+
+        l_n = f_n_proj - cohesion;
+        l_u = tproj_div_t * f_u;
+        l_v = tproj_div_t * f_v;
+    }
+
   protected:
     double friction;  ///< friction coefficient 'f', for sqrt(Tx^2+Ty^2)<f*Nz
     double cohesion;  ///< cohesion 'c', non-negative, for sqrt(Tx^2+Ty^2)<f*(Nz+c)
@@ -107,50 +154,13 @@ class ChApi ChConstraintTwoTuplesContactN : public ChConstraintTwoTuples<Ta, Tb>
         if (!constraint_U || !constraint_V)
             return;
 
-        // Anitescu-Tasora projection on cone generator and polar cone
-        // (contractive, but performs correction on three components: normal,u,v)
-
-        double f_n = this->l_i + this->cohesion;
-
-		// no friction? project to axis of upper cone
-        if (friction == 0) {
-            constraint_U->Set_l_i(0);
-            constraint_V->Set_l_i(0);
-            if (f_n < 0)
-                this->Set_l_i(0);
-            return;
-        }
-
-        double f_u = constraint_U->Get_l_i();
-        double f_v = constraint_V->Get_l_i();
-
-        double mu2 = friction * friction;
-        double f_n2 = f_n * f_n;
-        double f_t2 = (f_v * f_v + f_u * f_u);
-
-        // inside lower cone or close to origin? reset normal, u, v to zero!
-        if ((f_n <= 0 && f_t2 < f_n2 / mu2) || (f_n < 1e-14 && f_n > -1e-14)) {
-            this->Set_l_i(0);
-            constraint_U->Set_l_i(0);
-            constraint_V->Set_l_i(0);
-            return;
-        }
-
-        // inside upper cone? keep untouched!
-        if (f_t2 < f_n2 * mu2)
-            return;
-
-        // project orthogonally to generator segment of upper cone
-        double f_t = sqrt(f_t2);
-		double f_n_proj = (f_t * friction + f_n) / (mu2 + 1);
-        double f_t_proj = f_n_proj * friction;
-        double tproj_div_t = f_t_proj / f_t;
-        double f_u_proj = tproj_div_t * f_u;
-        double f_v_proj = tproj_div_t * f_v;
-
-        this->Set_l_i(f_n_proj - this->cohesion);
-        constraint_U->Set_l_i(f_u_proj);
-        constraint_V->Set_l_i(f_v_proj);
+        double l_n = this->l_i;
+        double l_u = constraint_U->Get_l_i();
+        double l_v = constraint_V->Get_l_i();
+        ProjectOntoFrictionCone(friction, cohesion, l_n, l_u, l_v);
+        this->Set_l_i(l_n);
+        constraint_U->Set_l_i(l_u);
+        constraint_V->Set_l_i(l_v);
     }
 };
 
@@ -0,0 +1,416 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "chrono/core/ChException.h"
+#include "chrono/serialization/ChArchiveBinary.h"
+#include "chrono/solver/ChConstraintNgeneric.h"
+#include "chrono/solver/ChConstraintTwoTuplesContactN.h"
+#include "chrono/solver/ChConstraintTwoTuplesRollingN.h"
+#include "chrono/solver/ChConstraintTwoTuplesRollingT.h"
+#include "chrono/solver/ChDescriptorCapture.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChVariablesGeneric.h"
+
+namespace chrono {
+
+CH_CLASS_VERSION(ChDescriptorCapture, 0)
+
+// Types of captured constraints
+static const int GENERIC = 0;    // bilateral, unilateral, or other constraint with default projection
+static const int CONTACT_N = 1;  // normal component of a frictional contact (projects the entire contact)
+static const int CONTACT_T = 2;  // tangential component of a frictional contact
+
+// -----------------------------------------------------------------------------
+
+// Replay constraint for the normal component of a frictional contact.
+// The two tangential components are the next two constraints; projection onto the friction cone is performed as in
+// ChConstraintTwoTuplesContactN.
+class ChConstraintReplayContactN : public ChConstraintNgeneric, public ChConstraintTwoTuplesContactNall {
+  public:
+    ChConstraintReplayContactN(double mfriction, double mcohesion) : constraint_U(nullptr), constraint_V(nullptr) {
+        mode = CONSTRAINT_FRIC;
+        friction = mfriction;
+        cohesion = mcohesion;
+    }
+
+    virtual ChConstraintReplayContactN* Clone() const override { return new ChConstraintReplayContactN(*this); }
+
+    void SetTangentialConstraints(ChConstraint* mU, ChConstraint* mV) {
+        constraint_U = mU;
+        constraint_V = mV;
+    }
+
+    virtual void Project() override {
+        double l_n = l_i;
+        double l_u = constraint_U->Get_l_i();
+        double l_v = constraint_V->Get_l_i();
+        ProjectOntoFrictionCone(friction, cohesion, l_n, l_u, l_v);
+        Set_l_i(l_n);
+        constraint_U->Set_l_i(l_u);
+        constraint_V->Set_l_i(l_v);
+    }
+
+  private:
+    ChConstraint* constraint_U;
+    ChConstraint* constraint_V;
+};
+
+// Replay constraint for a tangential component of a frictional contact.
+class ChConstraintReplayFrictionT : public ChConstraintNgeneric, public ChConstraintTwoTuplesFrictionTall {
+  public:
+    ChConstraintReplayFrictionT() { mode = CONSTRAINT_FRIC; }
+
+    virtual ChConstraintReplayFrictionT* Clone() const override { return new ChConstraintReplayFrictionT(*this); }
+
+    virtual bool IsLinear() const override { return false; }
+    virtual double Violation(double mc_i) override { return 0; }
+};
+
+// -----------------------------------------------------------------------------
+
+ChDescriptorCapture::ChDescriptorCapture() : mass_factor(1) {}
+
+ChDescriptorCapture::~ChDescriptorCapture() {}
+
+void ChDescriptorCapture::Capture(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+    std::vector<ChKblock*>& mstiffness = sysd.GetKblocksList();
+
+    for (auto constraint : mconstraints) {
+        if (constraint->IsActive() && (dynamic_cast<ChConstraintTwoTuplesRollingNall*>(constraint) ||
+                                       dynamic_cast<ChConstraintTwoTuplesRollingTall*>(constraint)))
+            throw ChException("ChDescriptorCapture: contacts with rolling friction are not supported.");
+    }
+    for (auto kblock : mstiffness) {
+        if (!dynamic_cast<ChKblockGeneric*>(kblock))
+            throw ChException("ChDescriptorCapture: only stiffness blocks of type ChKblockGeneric are supported.");
+    }
+
+    descriptor.reset();
+    variables.clear();
+    constraints.clear();
+    kblocks.clear();
+
+    mass_factor = sysd.GetMassFactor();
+
+    // Variables. Also set the offsets of all active variables.
+    int n_q = sysd.CountActiveVariables();
+
+    var_ndof.clear();
+    var_mass.clear();
+    var_f.clear();
+
+    std::unordered_map<ChVariables*, int> var_index;
+    std::vector<int> var_offset;
+    for (auto var : mvariables) {
+        if (!var->IsActive())
+            continue;
+        int ndof = var->Get_ndof();
+        var_index[var] = (int)var_ndof.size();
+        var_offset.push_back(var->GetOffset());
+        var_ndof.push_back(ndof);
+
+        ChSparseMatrix M(ndof, ndof);
+        var->Build_M(M, 0, 0, 1.0);
+        ChMatrixDynamic<> Md = M.toDense();
+        for (int i = 0; i < ndof; i++)
+            for (int j = 0; j < ndof; j++)
+                var_mass.push_back(Md(i, j));
+        for (int i = 0; i < ndof; i++)
+            var_f.push_back(var->Get_fb()(i));
+    }
+
+    // Constraints
+    con_mode.clear();
+    con_type.clear();
+    con_b.clear();
+    con_cfm.clear();
+    con_l.clear();
+    con_friction.clear();
+    con_cohesion.clear();
+    con_nvars.clear();
+    con_vars.clear();
+    con_jac.clear();
+
+    ChSparseMatrix Cq(1, n_q);
+    int pending_tangential = 0;
+    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+        auto constraint = mconstraints[ic];
+        if (!constraint->IsActive())
+            continue;
+
+        // Constraint type
+        int type = GENERIC;
+        double friction = 0;
+        double cohesion = 0;
+        if (pending_tangential > 0) {
+            type = CONTACT_T;
+            pending_tangential--;
+        } else if (auto contact = dynamic_cast<ChConstraintTwoTuplesContactNall*>(constraint)) {
+            // Capture as a frictional contact only if followed by its two active tangential components
+            if (ic + 2 < mconstraints.size() &&                                          //
+                dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[ic + 1]) &&  //
+                dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[ic + 2]) &&  //
+                mconstraints[ic + 1]->IsActive() && mconstraints[ic + 2]->IsActive()) {
+                type = CONTACT_N;
+                friction = contact->GetFrictionCoefficient();
+                cohesion = contact->GetCohesion();
+                pending_tangential = 2;
+            }
+        }
+
+        con_mode.push_back(constraint->GetMode());
+        con_type.push_back(type);
+        con_b.push_back(constraint->Get_b_i());
+        con_cfm.push_back(constraint->Get_cfm_i());
+        con_l.push_back(constraint->Get_l_i());
+        con_friction.push_back(friction);
+        con_cohesion.push_back(cohesion);
+
+        // Jacobian, split in slices for the referenced variables (in increasing order of their offsets)
+        Cq.setZero();
+        constraint->Build_Cq(Cq, 0);
+        int nvars = 0;
+        int last_var = -1;
+        size_t last_start = 0;
+        for (ChSparseMatrix::InnerIterator it(Cq, 0); it; ++it) {
+            int iv = (int)(std::upper_bound(var_offset.begin(), var_offset.end(), it.col()) - var_offset.begin()) - 1;
+            if (iv != last_var) {
+                nvars++;
+                con_vars.push_back(iv);
+                last_start = con_jac.size();
+                con_jac.resize(last_start + var_ndof[iv], 0.0);
+                last_var = iv;
+            }
+            con_jac[last_start + it.col() - var_offset[iv]] = it.value();
+        }
+        con_nvars.push_back(nvars);
+    }
+
+    // Stiffness blocks (only the rows and columns of active variables)
+    kb_nvars.clear();
+    kb_vars.clear();
+    kb_K.clear();
+
+    for (auto kblock : mstiffness) {
+        auto kb = static_cast<ChKblockGeneric*>(kblock);
+        ChMatrixRef K = kb->Get_K();
+
+        std::vector<int> vars;
+        std::vector<int> local_offsets;
+        int local_offset = 0;
+        for (unsigned int iv = 0; iv < kb->GetNvars(); iv++) {
+            auto var = kb->GetVariableN(iv);
+            if (var->IsActive()) {
+                vars.push_back(var_index[var]);
+                local_offsets.push_back(local_offset);
+            }
+            local_offset += var->Get_ndof();
+        }
+
+        kb_nvars.push_back((int)vars.size());
+        kb_vars.insert(kb_vars.end(), vars.begin(), vars.end());
+        for (size_t a = 0; a < vars.size(); a++)
+            for (int i = 0; i < var_ndof[vars[a]]; i++)
+                for (size_t b = 0; b < vars.size(); b++)
+                    for (int j = 0; j < var_ndof[vars[b]]; j++)
+                        kb_K.push_back(K(local_offsets[a] + i, local_offsets[b] + j));
+    }
+}
+
+int ChDescriptorCapture::GetNumContacts() const {
+    return (int)std::count(con_type.begin(), con_type.end(), CONTACT_N);
+}
+
+void ChDescriptorCapture::Build() {
+    descriptor = std::unique_ptr<ChSystemDescriptor>(new ChSystemDescriptor);
+    variables.clear();
+    constraints.clear();
+    kblocks.clear();
+
+    // Variables
+    size_t im = 0;
+    size_t iff = 0;
+    for (auto ndof : var_ndof) {
+        auto var = new ChVariablesGeneric(ndof);
+        for (int i = 0; i < ndof; i++)
+            for (int j = 0; j < ndof; j++)
+                var->GetMass()(i, j) = var_mass[im++];
+        var->GetInvMass() = var->GetMass().inverse();
+        for (int i = 0; i < ndof; i++)
+            var->Get_fb()(i) = var_f[iff++];
+        variables.push_back(std::unique_ptr<ChVariables>(var));
+    }
+
+    // Constraints
+    size_t iv = 0;
+    size_t ij = 0;
+    for (size_t ic = 0; ic < con_mode.size(); ic++) {
+        ChConstraintNgeneric* constraint;
+        switch (con_type[ic]) {
+            case CONTACT_N:
+                constraint = new ChConstraintReplayContactN(con_friction[ic], con_cohesion[ic]);
+                break;
+            case CONTACT_T:
+                constraint = new ChConstraintReplayFrictionT;
+                break;
+            default:
+                constraint = new ChConstraintNgeneric;
+                break;
+        }
+
+        std::vector<ChVariables*> vars;
+        for (int k = 0; k < con_nvars[ic]; k++)
+            vars.push_back(variables[con_vars[iv + k]].get());
+        constraint->SetVariables(vars);
+        for (int k = 0; k < con_nvars[ic]; k++) {
+            int ndof = var_ndof[con_vars[iv + k]];
+            for (int i = 0; i < ndof; i++)
+                constraint->Get_Cq_N(k)(i) = con_jac[ij++];
+        }
+        iv += con_nvars[ic];
+
+        constraint->SetMode(static_cast<eChConstraintMode>(con_mode[ic]));
+        constraint->Set_b_i(con_b[ic]);
+        constraint->Set_cfm_i(con_cfm[ic]);
+        constraints.push_back(std::unique_ptr<ChConstraint>(constraint));
+    }
+
+    for (size_t ic = 0; ic < con_mode.size(); ic++) {
+        if (con_type[ic] == CONTACT_N) {
+            auto contact = static_cast<ChConstraintReplayContactN*>(constraints[ic].get());
+            contact->SetTangentialConstraints(constraints[ic + 1].get(), constraints[ic + 2].get());
+        }
+    }
+
+    // Stiffness blocks
+    iv = 0;
+    size_t ik = 0;
+    for (auto nvars : kb_nvars) {
+        std::vector<ChVariables*> vars;
+        for (int k = 0; k < nvars; k++)
+            vars.push_back(variables[kb_vars[iv + k]].get());
+        iv += nvars;
+
+        auto kblock = new ChKblockGeneric(vars);
+        ChMatrixRef K = kblock->Get_K();
+        for (int i = 0; i < K.rows(); i++)
+            for (int j = 0; j < K.cols(); j++)
+                K(i, j) = kb_K[ik++];
+        kblocks.push_back(std::unique_ptr<ChKblock>(kblock));
+    }
+
+    // Descriptor
+    descriptor->BeginInsertion();
+    for (auto& var : variables)
+        descriptor->InsertVariables(var.get());
+    for (auto& constraint : constraints)
+        descriptor->InsertConstraint(constraint.get());
+    for (auto& kblock : kblocks)
+        descriptor->InsertKblock(kblock.get());
+    descriptor->EndInsertion();
+    descriptor->SetMassFactor(mass_factor);
+
+    Reset(true);
+}
+
+ChSystemDescriptor& ChDescriptorCapture::GetDescriptor() {
+    if (!descriptor)
+        Build();
+    return *descriptor;
+}
+
+void ChDescriptorCapture::Reset(bool warm_start) {
+    if (!descriptor) {
+        Build();
+        if (warm_start)
+            return;
+    }
+
+    for (size_t ic = 0; ic < constraints.size(); ic++)
+        constraints[ic]->Set_l_i(warm_start ? con_l[ic] : 0.0);
+    for (auto& var : variables)
+        var->Get_qb().setZero();
+}
+
+// -----------------------------------------------------------------------------
+
+void ChDescriptorCapture::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChDescriptorCapture>();
+
+    marchive << CHNVP(mass_factor);
+    marchive << CHNVP(var_ndof);
+    marchive << CHNVP(var_mass);
+    marchive << CHNVP(var_f);
+    marchive << CHNVP(con_mode);
+    marchive << CHNVP(con_type);
+    marchive << CHNVP(con_b);
+    marchive << CHNVP(con_cfm);
+    marchive << CHNVP(con_l);
+    marchive << CHNVP(con_friction);
+    marchive << CHNVP(con_cohesion);
+    marchive << CHNVP(con_nvars);
+    marchive << CHNVP(con_vars);
+    marchive << CHNVP(con_jac);
+    marchive << CHNVP(kb_nvars);
+    marchive << CHNVP(kb_vars);
+    marchive << CHNVP(kb_K);
+}
+
+void ChDescriptorCapture::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    /*int version =*/marchive.VersionRead<ChDescriptorCapture>();
+
+    marchive >> CHNVP(mass_factor);
+    marchive >> CHNVP(var_ndof);
+    marchive >> CHNVP(var_mass);
+    marchive >> CHNVP(var_f);
+    marchive >> CHNVP(con_mode);
+    marchive >> CHNVP(con_type);
+    marchive >> CHNVP(con_b);
+    marchive >> CHNVP(con_cfm);
+    marchive >> CHNVP(con_l);
+    marchive >> CHNVP(con_friction);
+    marchive >> CHNVP(con_cohesion);
+    marchive >> CHNVP(con_nvars);
+    marchive >> CHNVP(con_vars);
+    marchive >> CHNVP(con_jac);
+    marchive >> CHNVP(kb_nvars);
+    marchive >> CHNVP(kb_vars);
+    marchive >> CHNVP(kb_K);
+
+    descriptor.reset();
+    variables.clear();
+    constraints.clear();
+    kblocks.clear();
+}
+
+void ChDescriptorCapture::Write(const std::string& filename) {
+    ChStreamOutBinaryFile stream(filename.c_str());
+    ChArchiveOutBinary archive(stream);
+    ArchiveOUT(archive);
+}
+
+void ChDescriptorCapture::Read(const std::string& filename) {
+    ChStreamInBinaryFile stream(filename.c_str());
+    ChArchiveInBinary archive(stream);
+    ArchiveIN(archive);
+}
+
+}  // end namespace chrono
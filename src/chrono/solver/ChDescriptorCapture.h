@@ -0,0 +1,125 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_DESCRIPTOR_CAPTURE_H
+#define CH_DESCRIPTOR_CAPTURE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Capture and replay of the problem defined by a system descriptor.
+/// A capture stores, for all active variables, constraints, and stiffness blocks of a descriptor, the mass matrix
+/// blocks, the known terms f and b, the constraint jacobians, compliances and modes, the friction and cohesion
+/// coefficients of frictional contacts, the stiffness matrix blocks, and the current multipliers (used for warm
+/// start). A capture can be written to and read from a binary file.
+///
+/// A captured problem is replayed through a system descriptor which references variables, constraints, and stiffness
+/// blocks reconstructed from the captured data (see GetDescriptor). This descriptor can be passed to any ChSolver
+/// (Setup and Solve), without the original model, so that different solvers and solver settings can be compared on
+/// exactly the same problem.
+///
+/// Frictional contacts are captured if the two tangential constraints immediately follow the normal constraint in the
+/// descriptor (as inserted by all Chrono contact containers). Contacts with rolling friction are not supported.
+class ChApi ChDescriptorCapture {
+  public:
+    ChDescriptorCapture();
+    ~ChDescriptorCapture();
+
+    /// Capture the problem currently defined by the given descriptor.
+    /// Throws a ChException if the descriptor includes unsupported constraints or stiffness blocks.
+    void Capture(ChSystemDescriptor& sysd);
+
+    /// Write the captured problem to a binary file.
+    /// Throws a ChException if the file cannot be written.
+    void Write(const std::string& filename);
+
+    /// Read a captured problem from a binary file.
+    /// Throws a ChException if the file cannot be read.
+    void Read(const std::string& filename);
+
+    /// Method to allow serialization of the captured problem to archives.
+    void ArchiveOUT(ChArchiveOut& marchive);
+
+    /// Method to allow de-serialization of a captured problem from archives.
+    void ArchiveIN(ChArchiveIn& marchive);
+
+    /// Return the number of captured variable objects.
+    int GetNumVariables() const { return (int)var_ndof.size(); }
+
+    /// Return the number of captured scalar constraints.
+    int GetNumConstraints() const { return (int)con_mode.size(); }
+
+    /// Return the number of captured frictional contacts.
+    int GetNumContacts() const;
+
+    /// Return the number of captured stiffness blocks.
+    int GetNumKblocks() const { return (int)kb_nvars.size(); }
+
+    /// Access a system descriptor defining the captured problem.
+    /// The descriptor, its variables, constraints, and stiffness blocks are owned by this object. On first use, the
+    /// unknowns are initialized as with Reset(true); after solving, the solution is available in the descriptor (see
+    /// for example ChSystemDescriptor::FromUnknownsToVector).
+    ChSystemDescriptor& GetDescriptor();
+
+    /// Reset the unknowns of the replayed problem.
+    /// The multipliers are set to the captured values (warm start) or to zero, and the variables are set to zero.
+    void Reset(bool warm_start);
+
+  private:
+    void Build();
+
+    double mass_factor;  ///< mass factor c_a of the captured descriptor
+
+    // Variables (concatenated data for all variable objects)
+    std::vector<int> var_ndof;     ///< number of DOFs of each variable object
+    std::vector<double> var_mass;  ///< mass matrix blocks (row-major)
+    std::vector<double> var_f;     ///< known terms f
+
+    // Scalar constraints (concatenated data for all constraints)
+    std::vector<int> con_mode;         ///< constraint mode (eChConstraintMode)
+    std::vector<int> con_type;         ///< constraint type (generic, contact normal, or contact tangential)
+    std::vector<double> con_b;         ///< known terms b_i
+    std::vector<double> con_cfm;       ///< constraint force mixing terms cfm_i
+    std::vector<double> con_l;         ///< captured multipliers l_i
+    std::vector<double> con_friction;  ///< friction coefficients (contact normal constraints only)
+    std::vector<double> con_cohesion;  ///< cohesion (contact normal constraints only)
+    std::vector<int> con_nvars;        ///< number of variable objects referenced by each constraint
+    std::vector<int> con_vars;         ///< indices of referenced variable objects
+    std::vector<double> con_jac;       ///< jacobian slices, one for each referenced variable object
+
+    // Stiffness blocks (concatenated data for all blocks)
+    std::vector<int> kb_nvars;  ///< number of variable objects referenced by each block
+    std::vector<int> kb_vars;   ///< indices of referenced variable objects
+    std::vector<double> kb_K;   ///< stiffness matrix blocks (row-major)
+
+    // Reconstructed problem
+    std::unique_ptr<ChSystemDescriptor> descriptor;
+    std::vector<std::unique_ptr<ChVariables>> variables;
+    std::vector<std::unique_ptr<ChConstraint>> constraints;
+    std::vector<std::unique_ptr<ChKblock>> kblocks;
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
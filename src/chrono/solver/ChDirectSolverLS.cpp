@@ -30,7 +30,9 @@ ChDirectSolverLS::ChDirectSolverLS()
       m_dim(0),
       m_sparsity(-1),
       m_solve_call(0),
-      m_setup_call(0) {}
+      m_setup_call(0),
+      m_reuse_call(0),
+      m_fresh(false) {}
 
 void ChDirectSolverLS::ResetTimers() {
     m_timer_setup_assembly.reset();
@@ -39,6 +41,12 @@ void ChDirectSolverLS::ResetTimers() {
     m_timer_solve_solvercall.reset();
 }
 
+void ChDirectSolverLS::ResetCounters() {
+    m_setup_call = 0;
+    m_solve_call = 0;
+    m_reuse_call = 0;
+}
+
 bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     m_timer_setup_assembly.start();
 
@@ -104,6 +112,7 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     }
 
     m_setup_call++;
+    m_fresh = true;
 
     if (!result) {
         // If the factorization failed, let the concrete solver display an error message.
@@ -129,6 +138,10 @@ double ChDirectSolverLS::Solve(ChSystemDescriptor& sysd) {
     bool result = SolveSystem();
     m_timer_solve_solvercall.stop();
 
+    if (!m_fresh)
+        m_reuse_call++;
+    m_fresh = false;
+
     if (write_matrix)
         WriteVector("LS_" + frame_id + "_x.dat", m_sol);
 
@@ -144,6 +157,8 @@ double ChDirectSolverLS::Solve(ChSystemDescriptor& sysd) {
                  << "  solve:             " << m_timer_solve_solvercall.GetTimeSecondsIntermediate() << "\n";
     }
 
+    m_solve_call++;
+
     if (!result) {
         // If the solution failed, let the concrete solver display an error message.
         GetLog() << "Solver solve failed\n";
@@ -174,6 +189,7 @@ bool ChDirectSolverLS::SetupCurrent() {
     }
 
     m_setup_call++;
+    m_fresh = true;
 
     if (!result) {
         // If the factorization failed, let the concrete solver display an error message.
@@ -194,6 +210,10 @@ double ChDirectSolverLS::SolveCurrent() {
     bool result = SolveSystem();
     m_timer_solve_solvercall.stop();
 
+    if (!m_fresh)
+        m_reuse_call++;
+    m_fresh = false;
+
     if (verbose) {
         double res_norm = (m_rhs - m_mat * m_sol).norm();
         GetLog() << " Solver SolveCurrent() [" << m_solve_call << "]  |residual| = " << res_norm << "\n\n";
@@ -201,6 +221,8 @@ double ChDirectSolverLS::SolveCurrent() {
                  << "  solve:             " << m_timer_solve_solvercall.GetTimeSecondsIntermediate() << "\n";
     }
 
+    m_solve_call++;
+
     if (!result) {
         // If the solution failed, let the concrete solver display an error message.
         GetLog() << "Solver SolveCurrent() failed\n";
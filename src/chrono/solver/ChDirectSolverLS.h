@@ -123,10 +123,16 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// Get cumulative time for Pardiso calls in Setup phase.
     double GetTimeSetup_SolverCall() const { return m_timer_setup_solvercall(); }
 
-    /// Return the number of calls to the solver's Setup function.
+    /// Reset the counters of Setup and Solve calls.
+    void ResetCounters();
+
+    /// Return the number of calls to the solver's Setup function (i.e., the number of matrix factorizations).
     int GetNumSetupCalls() const { return m_setup_call; }
-    /// Return the number of calls to the solver's Setup function.
+    /// Return the number of calls to the solver's Solve function.
     int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of calls to the solver's Solve function which reused the factorization from a previous
+    /// Solve call (i.e., without an intermediate call to Setup).
+    int GetNumFactorizationReuses() const { return m_reuse_call; }
 
     /// Get a handle to the underlying matrix.
     ChSparseMatrix& GetMatrix() { return m_mat; }
@@ -196,6 +202,8 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
 
     int m_solve_call;  ///< counter for calls to Solve
     int m_setup_call;  ///< counter for calls to Setup
+    int m_reuse_call;  ///< counter for calls to Solve reusing a factorization
+    bool m_fresh;      ///< was the factorization computed since the last call to Solve?
 
     bool m_lock;          ///< is the matrix sparsity pattern locked?
     bool m_use_learner;   ///< use the sparsity pattern learner?
@@ -0,0 +1,202 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+#include <numeric>
+
+#include "chrono/solver/ChIslandDecomposition.h"
+#include "chrono/solver/ChKblockGeneric.h"
+
+namespace chrono {
+
+int ChIslandDecomposition::FindRoot(int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void ChIslandDecomposition::Merge(int i, int j) {
+    int ri = FindRoot(i);
+    int rj = FindRoot(j);
+    if (ri != rj)
+        parent[std::max(ri, rj)] = std::min(ri, rj);
+}
+
+bool ChIslandDecomposition::Update(ChSystemDescriptor& sysd) {
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChKblock*>& mstiffness = sysd.GetKblocksList();
+    auto nv = (int)mvariables.size();
+    auto nc = (int)mconstraints.size();
+    auto nk = (int)mstiffness.size();
+
+    num_islands = 0;
+
+    // Map the offset of each active variable (in the global 'q' vector) to its index in the variables list.
+    var_index.assign(sysd.CountActiveVariables() + 1, -1);
+    parent.resize(nv);
+    for (int iv = 0; iv < nv; iv++) {
+        parent[iv] = iv;
+        if (mvariables[iv]->IsActive())
+            var_index[mvariables[iv]->GetOffset()] = iv;
+    }
+
+    // Merge the variables coupled by constraints. As in the PSOR-like solvers, every three consecutive CONSTRAINT_FRIC
+    // constraints form one block, which is never split across islands. For each constraint, temporarily record one of
+    // its active variables (or -1 if it acts on no active variable).
+    con_island.assign(nc, -1);
+    int ic = 0;
+    while (ic < nc) {
+        int size = (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC && ic + 2 < nc) ? 3 : 1;
+        scratch.clear();
+        bool known = true;
+        bool active = false;
+        for (int i = 0; i < size; i++) {
+            known = known && mconstraints[ic + i]->GetVariables(scratch);
+            active = active || mconstraints[ic + i]->IsActive();
+        }
+        if (!known) {
+            if (active)
+                return false;
+            scratch.clear();
+        }
+
+        int first = -1;
+        for (auto var : scratch) {
+            if (!var || !var->IsActive())
+                continue;
+            int iv = var_index[var->GetOffset()];
+            if (first < 0)
+                first = iv;
+            else
+                Merge(first, iv);
+        }
+        for (int i = 0; i < size; i++)
+            con_island[ic + i] = first;
+        ic += size;
+    }
+
+    // Merge the variables coupled by stiffness blocks.
+    std::vector<int> kb_island(nk, -1);
+    for (int ik = 0; ik < nk; ik++) {
+        auto kblock = dynamic_cast<ChKblockGeneric*>(mstiffness[ik]);
+        if (!kblock)
+            return false;
+        int first = -1;
+        for (unsigned int i = 0; i < (unsigned int)kblock->GetNvars(); i++) {
+            auto var = kblock->GetVariableN(i);
+            if (!var || !var->IsActive())
+                continue;
+            int iv = var_index[var->GetOffset()];
+            if (first < 0)
+                first = iv;
+            else
+                Merge(first, iv);
+        }
+        kb_island[ik] = first;
+    }
+
+    // Number the islands (identified by the roots of the union-find forest) in order of first appearance. Variables and
+    // constraints not coupled to any other variable are collected in one additional island.
+    std::vector<int> root_island(nv, -1);
+    island_size.clear();
+    auto assign = [&](int iv) {
+        int r = FindRoot(iv);
+        if (root_island[r] < 0) {
+            root_island[r] = (int)island_size.size();
+            island_size.push_back(0);
+        }
+        return root_island[r];
+    };
+    for (ic = 0; ic < nc; ic++) {
+        if (con_island[ic] >= 0) {
+            con_island[ic] = assign(con_island[ic]);
+            island_size[con_island[ic]]++;
+        }
+    }
+    for (int ik = 0; ik < nk; ik++) {
+        if (kb_island[ik] >= 0)
+            kb_island[ik] = assign(kb_island[ik]);
+    }
+
+    int free_island = -1;
+    var_island.assign(nv, -1);
+    for (int iv = 0; iv < nv; iv++) {
+        if (!mvariables[iv]->IsActive())
+            continue;
+        int r = FindRoot(iv);
+        if (root_island[r] >= 0) {
+            var_island[iv] = root_island[r];
+        } else {
+            if (free_island < 0) {
+                free_island = (int)island_size.size();
+                island_size.push_back(0);
+            }
+            var_island[iv] = free_island;
+        }
+    }
+    for (ic = 0; ic < nc; ic++) {
+        if (con_island[ic] < 0) {
+            if (free_island < 0) {
+                free_island = (int)island_size.size();
+                island_size.push_back(0);
+            }
+            con_island[ic] = free_island;
+            island_size[free_island]++;
+        }
+    }
+    for (int ik = 0; ik < nk; ik++) {
+        if (kb_island[ik] < 0) {
+            if (free_island < 0) {
+                free_island = (int)island_size.size();
+                island_size.push_back(0);
+            }
+            kb_island[ik] = free_island;
+        }
+    }
+
+    num_islands = (int)island_size.size();
+
+    // Sort islands by decreasing number of constraints, so that the largest islands are scheduled first.
+    std::vector<int> order(num_islands);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return island_size[a] > island_size[b]; });
+    std::vector<int> rank(num_islands);
+    for (int i = 0; i < num_islands; i++)
+        rank[order[i]] = i;
+
+    // Fill the island descriptors, preserving the order of items in the original descriptor.
+    while ((int)islands.size() < num_islands)
+        islands.push_back(std::unique_ptr<ChSystemDescriptor>(new ChSystemDescriptor));
+    for (int i = 0; i < num_islands; i++) {
+        islands[i]->BeginInsertion();
+        islands[i]->SetMassFactor(sysd.GetMassFactor());
+        islands[i]->SetNumThreads(1);
+        islands[i]->EnablePackedContacts(sysd.IsPackedContactsEnabled());
+    }
+    for (int iv = 0; iv < nv; iv++) {
+        if (var_island[iv] >= 0)
+            islands[rank[var_island[iv]]]->InsertVariables(mvariables[iv]);
+    }
+    for (ic = 0; ic < nc; ic++)
+        islands[rank[con_island[ic]]]->InsertConstraint(mconstraints[ic]);
+    for (int ik = 0; ik < nk; ik++)
+        islands[rank[kb_island[ik]]]->InsertKblock(mstiffness[ik]);
+
+    return true;
+}
+
+}  // end namespace chrono
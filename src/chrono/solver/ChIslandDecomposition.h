@@ -0,0 +1,74 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_ISLAND_DECOMPOSITION_H
+#define CH_ISLAND_DECOMPOSITION_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Decomposition of a system descriptor into independent islands.
+/// Two active ChVariables objects belong to the same island if they are coupled, directly or indirectly, through
+/// active constraints or stiffness blocks. Inactive variables (e.g., those of fixed bodies) do not couple islands.
+/// Each island is represented by a separate system descriptor referencing a subset of the variables, constraints, and
+/// stiffness blocks of the original descriptor, in their original order. Since islands are independent, they can be
+/// solved separately (and concurrently), each to its own convergence. Variables not acted upon by any constraint are
+/// collected in a single additional island.
+///
+/// The decomposition fails (and the descriptor must be solved as a whole) if any active constraint cannot report its
+/// variables (see ChConstraint::GetVariables) or if a stiffness block is not a ChKblockGeneric.
+class ChApi ChIslandDecomposition {
+  public:
+    ChIslandDecomposition() : num_islands(0) {}
+
+    /// Partition the given descriptor into islands.
+    /// Islands are sorted by decreasing number of constraints. Return false if the decomposition failed.
+    /// Note that the island descriptors are not finalized (offsets of their variables and constraints are not set);
+    /// call EndInsertion() on an island descriptor before solving it, and UpdateCountsAndOffsets() on the original
+    /// descriptor after all islands were solved.
+    bool Update(ChSystemDescriptor& sysd);
+
+    /// Return the number of islands in the current decomposition.
+    int GetNumIslands() const { return num_islands; }
+
+    /// Return the descriptor for the specified island.
+    ChSystemDescriptor& GetIsland(int island) { return *islands[island]; }
+
+  private:
+    int FindRoot(int i);
+    void Merge(int i, int j);
+
+    std::vector<std::unique_ptr<ChSystemDescriptor>> islands;  ///< island descriptors (reused)
+    int num_islands;                                           ///< number of islands in current decomposition
+
+    std::vector<int> var_index;        ///< index of active variable, by offset in the global 'q' vector
+    std::vector<int> parent;           ///< union-find forest over active variables
+    std::vector<int> var_island;       ///< island of each active variable
+    std::vector<int> con_island;       ///< island of each constraint (-1 if inactive)
+    std::vector<int> island_size;      ///< number of constraints in each island
+    std::vector<ChVariables*> scratch;  ///< scratch list of variables
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -82,6 +82,10 @@ class ChApi ChIterativeSolverVI : public ChIterativeSolver, public ChSolverVI {
     /// Return the number of iterations performed during the last solve.
     virtual int GetIterations() const override { return m_iterations; }
 
+    /// Set the number of iterations reported by GetIterations.
+    /// Used when the problem is solved in independent parts by copies of this solver (see ChSystem::SolveIslands).
+    void SetIterations(int iterations) { m_iterations = iterations; }
+
     /// Access the vector of constraint violation history.
     /// Note that collection of constraint violations must be enabled through SetRecordViolation.
     const std::vector<double>& GetViolationHistory() const { return violation_history; }
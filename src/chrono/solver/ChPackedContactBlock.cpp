@@ -0,0 +1,137 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "chrono/solver/ChConstraintTwoTuplesContactN.h"
+#include "chrono/solver/ChConstraintTwoTuplesRollingN.h"
+#include "chrono/solver/ChPackedContactBlock.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+const int ChPackedContactBlock::NOT_PACKED;
+
+// Constraint types for the frictional contact between two objects with 6 DOFs each
+typedef ChVariableTupleCarrier_1vars<6> Carrier6;
+typedef ChConstraintTwoTuplesContactN<Carrier6, Carrier6> ContactN66;
+typedef ChConstraintTwoTuplesFrictionT<Carrier6, Carrier6> FrictionT66;
+typedef ChConstraintTwoTuplesRollingN<Carrier6, Carrier6> RollingN66;
+
+// Copy the jacobian and [Eq] of one side of a contact row into the packed arrays.
+// Inactive variables are skipped (zero jacobian), consistently with ChConstraintTuple_1vars.
+static void PackTuple(ChConstraintTuple_1vars<Carrier6>& tuple, double* Cq_row, double* Eq_row) {
+    if (tuple.GetVariables()->IsActive()) {
+        std::copy(tuple.Get_Cq().data(), tuple.Get_Cq().data() + 6, Cq_row);
+        std::copy(tuple.Get_Eq().data(), tuple.Get_Eq().data() + 6, Eq_row);
+    } else {
+        std::fill(Cq_row, Cq_row + 6, 0.0);
+        std::fill(Eq_row, Eq_row + 6, 0.0);
+    }
+}
+
+void ChPackedContactBlock::Reset() {
+    index.clear();
+    constraints.clear();
+    offset.clear();
+    Cq.clear();
+    Eq.clear();
+    q.clear();
+    b.clear();
+    cfm.clear();
+    g.clear();
+    l.clear();
+    friction.clear();
+    cohesion.clear();
+}
+
+void ChPackedContactBlock::Update(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    size_t nc = mconstraints.size();
+
+    Reset();
+    index.assign(nc, NOT_PACKED);
+    std::fill(q_inactive, q_inactive + 6, 0.0);
+
+    // Normal components of rolling friction contacts. These are not packed, since the rolling constraints are
+    // processed through the generic interface and read and modify the normal multiplier in the constraint object.
+    std::unordered_set<ChConstraint*> rolling_normals;
+    for (size_t i = 0; i < nc; i++) {
+        if (mconstraints[i]->GetMode() != CONSTRAINT_FRIC)
+            continue;
+        if (auto rn = dynamic_cast<RollingN66*>(mconstraints[i]))
+            rolling_normals.insert(rn->GetNormalConstraint());
+    }
+
+    size_t ic = 0;
+    while (ic < nc) {
+        if (mconstraints[ic]->GetMode() != CONSTRAINT_FRIC || ic + 2 >= nc) {
+            ic++;
+            continue;
+        }
+
+        // Only pack active triplets (normal, u, v) of body-body contacts without rolling friction, stored
+        // consecutively in the descriptor.
+        auto cn = dynamic_cast<ContactN66*>(mconstraints[ic]);
+        if (!cn || cn->GetTangentialConstraintU() != mconstraints[ic + 1] ||
+            cn->GetTangentialConstraintV() != mconstraints[ic + 2] || !mconstraints[ic]->IsActive() ||
+            !mconstraints[ic + 1]->IsActive() || !mconstraints[ic + 2]->IsActive() || rolling_normals.count(cn)) {
+            ic += 3;
+            continue;
+        }
+
+        int i = (int)offset.size();
+        index[ic] = i;
+        index[ic + 1] = TANGENTIAL;
+        index[ic + 2] = TANGENTIAL;
+        offset.push_back(mconstraints[ic]->GetOffset());
+        friction.push_back(cn->GetFrictionCoefficient());
+        cohesion.push_back(cn->GetCohesion());
+
+        Cq.resize(36 * (i + 1));
+        Eq.resize(36 * (i + 1));
+
+        ChConstraintTwoTuples<Carrier6, Carrier6>* rows[3] = {cn, cn->GetTangentialConstraintU(),
+                                                               cn->GetTangentialConstraintV()};
+        for (int k = 0; k < 3; k++) {
+            PackTuple(rows[k]->Get_tuple_a(), &Cq[36 * i + 6 * k], &Eq[36 * i + 6 * k]);
+            PackTuple(rows[k]->Get_tuple_b(), &Cq[36 * i + 18 + 6 * k], &Eq[36 * i + 18 + 6 * k]);
+            constraints.push_back(rows[k]);
+            b.push_back(rows[k]->Get_b_i());
+            cfm.push_back(rows[k]->Get_cfm_i());
+            g.push_back(rows[k]->Get_g_i());
+            l.push_back(rows[k]->Get_l_i());
+        }
+
+        ChVariables* var_a = cn->Get_tuple_a().GetVariables();
+        ChVariables* var_b = cn->Get_tuple_b().GetVariables();
+        q.push_back(var_a->IsActive() ? var_a->Get_qb().data() : q_inactive);
+        q.push_back(var_b->IsActive() ? var_b->Get_qb().data() : q_inactive);
+
+        ic += 3;
+    }
+}
+
+void ChPackedContactBlock::Project(int i, double* lambda) const {
+    ChConstraintTwoTuplesContactNall::ProjectOntoFrictionCone(friction[i], cohesion[i], lambda[0], lambda[1],
+                                                              lambda[2]);
+}
+
+void ChPackedContactBlock::Store_l() {
+    for (size_t k = 0; k < constraints.size(); k++)
+        constraints[k]->Set_l_i(l[k]);
+}
+
+}  // end namespace chrono
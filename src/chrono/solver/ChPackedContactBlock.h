@@ -0,0 +1,132 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_PACKED_CONTACT_BLOCK_H
+#define CH_PACKED_CONTACT_BLOCK_H
+
+#include <vector>
+
+#include "chrono/core/ChMatrix.h"
+#include "chrono/solver/ChConstraint.h"
+
+namespace chrono {
+
+class ChSystemDescriptor;
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Packed representation of the frictional contacts between two 6-DOF objects (e.g., body-body contacts).
+/// Each such contact is represented in a ChSystemDescriptor by a triplet of constraints (one
+/// ChConstraintTwoTuplesContactN and two ChConstraintTwoTuplesFrictionT) which iterative solvers otherwise process
+/// one scalar row at a time, through virtual function calls.
+/// This class gathers the jacobians [Cq], the products [Eq]=[invM]*[Cq]', the known terms and the multipliers of all
+/// such contacts in contiguous arrays (3x6 row-major jacobian blocks for each of the two objects, stored contiguously
+/// for consecutive contacts), so that the products [Cq]*q, the increments q += [Eq]*l and the projection onto the
+/// friction cone are computed with fixed-size (vectorizable) kernels, for all three rows of a contact at once.
+/// Constraints of all other types are not packed and must be processed through the generic ChConstraint interface.
+/// Contacts with rolling or spinning friction are not packed either, since their rolling constraints read and modify
+/// the multiplier of the normal component during the projection.
+class ChApi ChPackedContactBlock {
+  public:
+    /// Value returned by GetContactIndex() for constraints that are not packed.
+    static const int NOT_PACKED = -1;
+
+    /// Value returned by GetContactIndex() for the tangential components of a packed contact.
+    static const int TANGENTIAL = -2;
+
+    ChPackedContactBlock() {}
+
+    /// Collect all active body-body frictional contacts (without rolling friction) from the given descriptor.
+    /// This must be called after the constraint offsets and the auxiliary data in all constraints (i.e., g_i and
+    /// [Eq]) were updated, with the current multipliers l_i in the constraint objects.
+    void Update(ChSystemDescriptor& sysd);
+
+    /// Remove all packed contacts.
+    void Reset();
+
+    /// Return the number of packed contacts.
+    int GetNumContacts() const { return (int)offset.size(); }
+
+    /// Return the index of the packed contact whose normal component is the constraint with index 'ic' in the
+    /// descriptor list. Return TANGENTIAL if the constraint is a tangential component of a packed contact and
+    /// NOT_PACKED if it is not packed.
+    int GetContactIndex(size_t ic) const { return index[ic]; }
+
+    /// Return the offset of the i-th contact (normal component) in the vector of multipliers.
+    int GetOffset(int i) const { return offset[i]; }
+
+    /// Access the multipliers (normal, u, v) of the i-th contact.
+    double* Get_l(int i) { return &l[3 * i]; }
+
+    /// Access the known terms b_i (normal, u, v) of the i-th contact.
+    const double* Get_b(int i) const { return &b[3 * i]; }
+
+    /// Access the constraint force mixing terms cfm_i (normal, u, v) of the i-th contact.
+    const double* Get_cfm(int i) const { return &cfm[3 * i]; }
+
+    /// Access the diagonal terms g_i (normal, u, v) of the i-th contact.
+    const double* Get_g(int i) const { return &g[3 * i]; }
+
+    /// Compute the products [Cq]*q for the three rows (normal, u, v) of the i-th contact.
+    void Compute_Cq_q(int i, double* result) const {
+        Eigen::Map<const ChMatrixNM<double, 3, 6>> Cq_a(&Cq[36 * i]);
+        Eigen::Map<const ChMatrixNM<double, 3, 6>> Cq_b(&Cq[36 * i + 18]);
+        Eigen::Map<const ChVectorN<double, 6>> q_a(q[2 * i]);
+        Eigen::Map<const ChVectorN<double, 6>> q_b(q[2 * i + 1]);
+        Eigen::Map<ChVectorN<double, 3>> res(result);
+        res = Cq_a * q_a + Cq_b * q_b;
+    }
+
+    /// Increment the variables of the i-th contact with [invM]*[Cq]'*deltal, for the three rows (normal, u, v).
+    /// The rows are accumulated one at a time, in the same order as the generic per-constraint updates, so that both
+    /// paths produce identical round-off.
+    void Increment_q(int i, const double* deltal) {
+        Eigen::Map<const ChMatrixNM<double, 3, 6>> Eq_a(&Eq[36 * i]);
+        Eigen::Map<const ChMatrixNM<double, 3, 6>> Eq_b(&Eq[36 * i + 18]);
+        Eigen::Map<ChVectorN<double, 6>> q_a(q[2 * i]);
+        Eigen::Map<ChVectorN<double, 6>> q_b(q[2 * i + 1]);
+        for (int k = 0; k < 3; k++) {
+            q_a += Eq_a.row(k).transpose() * deltal[k];
+            q_b += Eq_b.row(k).transpose() * deltal[k];
+        }
+    }
+
+    /// Project the given multipliers (normal, u, v) onto the friction cone of the i-th contact.
+    void Project(int i, double* lambda) const;
+
+    /// Copy the multipliers of all packed contacts back to the corresponding constraint objects.
+    void Store_l();
+
+  private:
+    std::vector<int> index;                  ///< packed contact index for each constraint in the descriptor
+    std::vector<ChConstraint*> constraints;  ///< the three constraints (normal, u, v) of each contact
+    std::vector<int> offset;                 ///< offset of each contact in the vector of multipliers
+    std::vector<double> Cq;                  ///< jacobians, 3x6 blocks for object A then object B (36 per contact)
+    std::vector<double> Eq;                  ///< [invM]*[Cq]', stored transposed as [Cq] (36 per contact)
+    std::vector<double*> q;                  ///< variables of object A and object B (2 per contact)
+    std::vector<double> b;                   ///< known terms (3 per contact)
+    std::vector<double> cfm;                 ///< constraint force mixing terms (3 per contact)
+    std::vector<double> g;                   ///< diagonal terms (3 per contact)
+    std::vector<double> l;                   ///< multipliers (3 per contact)
+    std::vector<double> friction;            ///< friction coefficient (1 per contact)
+    std::vector<double> cohesion;            ///< cohesion (1 per contact)
+    double q_inactive[6];                    ///< placeholder for the variables of inactive objects
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -84,6 +84,9 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the body-body contacts for use in the Schur complement products (if enabled in the descriptor)
+    sysd.PackContacts();
+
     double L, t;
     double theta;
     double thetaNew;
@@ -112,6 +115,7 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     // If no constraints, return now. Variables contain M^-1 * f after call to ShurBvectorCompute.
     // This early exit is needed, else we get division by zero and a potential infinite loop.
     if (nc == 0) {
+        sysd.ReleasePackedContacts();
         return 0;
     }
 
@@ -248,6 +252,8 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
             mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
     }
 
+    sysd.ReleasePackedContacts();
+
     return residual;
 }
 
@@ -88,6 +88,10 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
             }
         }
     }
+
+    // Pack the body-body contacts for use in the Schur complement products (if enabled in the descriptor)
+    sysd.PackContacts();
+
     // The vector with the diagonal of the N matrix
     mD.setZero();
     int d_i = 0;
@@ -340,6 +344,8 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
             mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
     }
 
+    sysd.ReleasePackedContacts();
+
     if (verbose)
         GetLog() << "-----\n";
 
@@ -20,11 +20,15 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChSolverPJacobi)
 
-ChSolverPJacobi::ChSolverPJacobi() : maxviolation(0) {
+ChSolverPJacobi::ChSolverPJacobi() : maxviolation(0), m_multithreading(false) {
     m_omega = 0.2;
 }
 
 double ChSolverPJacobi::Solve(ChSystemDescriptor& sysd) {
+    // In deterministic mode, use the colored sweep also with a single thread (same results for any number of threads)
+    if (m_multithreading && (sysd.GetNumThreads() > 1 || sysd.IsDeterministicModeEnabled()))
+        return SolveColored(sysd);
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
@@ -187,4 +191,155 @@ double ChSolverPJacobi::Solve(ChSystemDescriptor& sysd) {
     return maxviolation;
 }
 
+double ChSolverPJacobi::SolveColored(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    int nthreads = sysd.GetNumThreads();
+    int nc = (int)mconstraints.size();
+    int nv = (int)mvariables.size();
+
+    m_iterations = 0;
+    maxviolation = 0;
+
+    // Partition the constraint blocks in sets that do not share variables
+    m_coloring.Update(sysd);
+    const std::vector<ChConstraintColoring::Block>& blocks = m_coloring.GetBlocks();
+    int nb = (int)blocks.size();
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+#pragma omp parallel for num_threads(nthreads)
+    for (int ic = 0; ic < nc; ic++)
+        mconstraints[ic]->Update_auxiliary();
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+#pragma omp parallel for num_threads(nthreads)
+    for (int ib = 0; ib < nb; ib++) {
+        if (blocks[ib].size == 3) {
+            unsigned int ic = blocks[ib].start;
+            double average_g_i = (mconstraints[ic + 0]->Get_g_i() + mconstraints[ic + 1]->Get_g_i() +
+                                  mconstraints[ic + 2]->Get_g_i()) /
+                                 3.0;
+            mconstraints[ic + 0]->Set_g_i(average_g_i);
+            mconstraints[ic + 1]->Set_g_i(average_g_i);
+            mconstraints[ic + 2]->Set_g_i(average_g_i);
+        }
+    }
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+#pragma omp parallel for num_threads(nthreads)
+    for (int iv = 0; iv < nv; iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    }
+
+    // 3)  If no warm start, simply resets initial lagrangians to zero.
+    if (!m_warm_start) {
+#pragma omp parallel for num_threads(nthreads)
+        for (int ic = 0; ic < nc; ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+
+    // 4)  Perform the iteration loops
+    //
+
+    std::vector<double> delta_gammas;
+    delta_gammas.resize(mconstraints.size());
+
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        maxviolation = 0;
+        double maxdeltalambda = 0;
+
+        // Compute and project the new reactions of all constraint blocks. This only reads the variables 'q', so all
+        // blocks are processed in parallel.
+#pragma omp parallel num_threads(nthreads)
+        {
+            double t_violation = 0;
+            double t_deltalambda = 0;
+
+#pragma omp for schedule(static)
+            for (int ib = 0; ib < nb; ib++) {
+                unsigned int start = blocks[ib].start;
+                unsigned int size = blocks[ib].size;
+                double old_lambda[3];
+
+                for (unsigned int i = 0; i < size; i++) {
+                    ChConstraint* constraint = mconstraints[start + i];
+
+                    // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+                    double mresidual = constraint->Compute_Cq_q() + constraint->Get_b_i() +
+                                       constraint->Get_cfm_i() * constraint->Get_l_i();
+
+                    // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+                    if (size == 1)
+                        t_violation = ChMax(t_violation, fabs(constraint->Violation(mresidual)));
+                    else if (i == 0)
+                        t_violation = ChMax(t_violation, fabs(ChMin(0.0, mresidual)));
+
+                    // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+                    double deltal = (m_omega / constraint->Get_g_i()) * (-mresidual);
+
+                    // update:   lambda += delta_lambda;
+                    old_lambda[i] = constraint->Get_l_i();
+                    constraint->Set_l_i(old_lambda[i] + deltal);
+                }
+
+                // Project on the admissible set (for frictional contacts, the N component takes care of N,U,V)
+                mconstraints[start]->Project();
+
+                for (unsigned int i = 0; i < size; i++) {
+                    ChConstraint* constraint = mconstraints[start + i];
+                    double new_lambda = constraint->Get_l_i();
+                    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                    if (m_shlambda != 1.0) {
+                        new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda[i];
+                        constraint->Set_l_i(new_lambda);
+                    }
+                    // Now do NOT update the primal variables , posticipate
+                    delta_gammas[start + i] = new_lambda - old_lambda[i];
+
+                    if (this->record_violation_history)
+                        t_deltalambda = ChMax(t_deltalambda, fabs(delta_gammas[start + i]));
+                }
+            }
+
+#pragma omp critical
+            {
+                maxviolation = ChMax(maxviolation, t_violation);
+                maxdeltalambda = ChMax(maxdeltalambda, t_deltalambda);
+            }
+        }
+
+        // Now, after all deltas are updated, sweep through all constraints and increment  q += [invM][Cq]'* delta_l
+        // Blocks in the same color do not share variables, so they can be processed in parallel.
+        for (int color = 0; color < m_coloring.GetNumColors(); color++) {
+            const std::vector<ChConstraintColoring::Block>& cblocks = m_coloring.GetColor(color);
+            int ncb = (int)cblocks.size();
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+            for (int ib = 0; ib < ncb; ib++) {
+                for (unsigned int ic = cblocks[ib].start; ic < cblocks[ib].start + cblocks[ib].size; ic++)
+                    mconstraints[ic]->Increment_q(delta_gammas[ic]);
+            }
+        }
+        for (const auto& block : m_coloring.GetSerialBlocks()) {
+            for (unsigned int ic = block.start; ic < block.start + block.size; ic++)
+                mconstraints[ic]->Increment_q(delta_gammas[ic]);
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+    }
+
+    return maxviolation;
+}
+
 }  // end namespace chrono
@@ -16,6 +16,7 @@
 #define CHSOLVERJACOBI_H
 
 #include "chrono/solver/ChIterativeSolverVI.h"
+#include "chrono/solver/ChConstraintColoring.h"
 
 namespace chrono {
 
@@ -44,8 +45,23 @@ class ChApi ChSolverPJacobi : public ChIterativeSolverVI {
     /// For the PJacobi solver, this is the maximum constraint violation.
     virtual double GetError() const override { return maxviolation; }
 
+    /// Enable/disable multithreading (default: false).
+    /// If enabled, the projection of the constraint reactions is performed in parallel and the increments of the
+    /// variables are applied in parallel over independent sets of constraints (see ChConstraintColoring), using the
+    /// number of threads specified in the system descriptor (see ChSystem::SetNumThreads). If deterministic mode is
+    /// enabled in the system descriptor, the same algorithm is used also with a single thread.
+    void EnableMultithreading(bool val) { m_multithreading = val; }
+
+    /// Return true if multithreading is enabled.
+    bool IsMultithreading() const { return m_multithreading; }
+
   private:
+    /// Multithreaded variant of Solve.
+    double SolveColored(ChSystemDescriptor& sysd);
+
     double maxviolation;
+    bool m_multithreading;
+    ChConstraintColoring m_coloring;
 };
 
 /// @} chrono_solver
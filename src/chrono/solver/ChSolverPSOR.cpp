@@ -20,9 +20,13 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChSolverPSOR)
 
-ChSolverPSOR::ChSolverPSOR() : maxviolation(0) {}
+ChSolverPSOR::ChSolverPSOR() : maxviolation(0), m_multithreading(false) {}
 
 double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
+    // In deterministic mode, use the colored sweep also with a single thread (same results for any number of threads)
+    if (m_multithreading && (sysd.GetNumThreads() > 1 || sysd.IsDeterministicModeEnabled()))
+        return SolveColored(sysd);
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
@@ -75,6 +79,10 @@ double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
             mconstraints[ic]->Set_l_i(0.);
     }
 
+    // Pack the body-body contacts (if enabled in the descriptor)
+    bool packed = sysd.PackContacts();
+    ChPackedContactBlock& mpacked = sysd.GetPackedContacts();
+
     // 4)  Perform the iteration loops
     //
 
@@ -87,6 +95,17 @@ double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
         i_friction_comp = 0;
 
         for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+            if (packed) {
+                int k = mpacked.GetContactIndex(ic);
+                if (k >= 0) {
+                    // process the whole triplet (normal, u, v) of a packed contact
+                    double violation = UpdatePackedContact(mpacked, k, maxdeltalambda);
+                    maxviolation = ChMax(maxviolation, violation);
+                }
+                if (k != ChPackedContactBlock::NOT_PACKED)
+                    continue;
+            }
+
             // skip computations if constraint not active.
             if (mconstraints[ic]->IsActive()) {
                 // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
@@ -184,7 +203,248 @@ double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
 
     }  // end iteration loop
 
+    if (packed) {
+        mpacked.Store_l();
+        sysd.ReleasePackedContacts();
+    }
+
     return maxviolation;
 }
 
+double ChSolverPSOR::UpdatePackedContact(ChPackedContactBlock& mpacked, int k, double& maxdeltalambda) {
+    double* l = mpacked.Get_l(k);
+    const double* b = mpacked.Get_b(k);
+    const double* cfm = mpacked.Get_cfm(k);
+    const double* g = mpacked.Get_g(k);
+
+    // compute residuals  c_i = [Cq_i]*q + b_i + cfm_i*l_i  for the normal and tangential rows
+    double Cq_q[3];
+    mpacked.Compute_Cq_q(k, Cq_q);
+
+    double old_l[3] = {l[0], l[1], l[2]};
+    double mresidual[3];
+    for (int j = 0; j < 3; j++) {
+        mresidual[j] = Cq_q[j] + b[j] + cfm[j] * l[j];
+        // update:   lambda += delta_lambda;
+        l[j] += (m_omega / g[j]) * (-mresidual[j]);
+    }
+
+    // project onto the friction cone
+    mpacked.Project(k, l);
+
+    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+    if (m_shlambda != 1.0) {
+        for (int j = 0; j < 3; j++)
+            l[j] = m_shlambda * l[j] + (1.0 - m_shlambda) * old_l[j];
+    }
+
+    double true_delta[3] = {l[0] - old_l[0], l[1] - old_l[1], l[2] - old_l[2]};
+    mpacked.Increment_q(k, true_delta);
+
+    if (this->record_violation_history) {
+        for (int j = 0; j < 3; j++)
+            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta[j]));
+    }
+
+    // only the normal component contributes to the violation
+    return fabs(ChMin(0.0, mresidual[0]));
+}
+
+double ChSolverPSOR::SolveColored(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    int nthreads = sysd.GetNumThreads();
+    int nc = (int)mconstraints.size();
+    int nv = (int)mvariables.size();
+
+    m_iterations = 0;
+    maxviolation = 0;
+
+    // Partition the constraint blocks in sets that do not share variables
+    m_coloring.Update(sysd);
+    const std::vector<ChConstraintColoring::Block>& blocks = m_coloring.GetBlocks();
+    int nb = (int)blocks.size();
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+#pragma omp parallel for num_threads(nthreads)
+    for (int ic = 0; ic < nc; ic++)
+        mconstraints[ic]->Update_auxiliary();
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+#pragma omp parallel for num_threads(nthreads)
+    for (int ib = 0; ib < nb; ib++) {
+        if (blocks[ib].size == 3) {
+            unsigned int ic = blocks[ib].start;
+            double average_g_i = (mconstraints[ic + 0]->Get_g_i() + mconstraints[ic + 1]->Get_g_i() +
+                                  mconstraints[ic + 2]->Get_g_i()) /
+                                 3.0;
+            mconstraints[ic + 0]->Set_g_i(average_g_i);
+            mconstraints[ic + 1]->Set_g_i(average_g_i);
+            mconstraints[ic + 2]->Set_g_i(average_g_i);
+        }
+    }
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+#pragma omp parallel for num_threads(nthreads)
+    for (int iv = 0; iv < nv; iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    }
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (m_warm_start) {
+        for (int color = 0; color < m_coloring.GetNumColors(); color++) {
+            const std::vector<ChConstraintColoring::Block>& cblocks = m_coloring.GetColor(color);
+            int ncb = (int)cblocks.size();
+#pragma omp parallel for num_threads(nthreads)
+            for (int ib = 0; ib < ncb; ib++) {
+                for (unsigned int ic = cblocks[ib].start; ic < cblocks[ib].start + cblocks[ib].size; ic++)
+                    mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+            }
+        }
+        for (const auto& block : m_coloring.GetSerialBlocks()) {
+            for (unsigned int ic = block.start; ic < block.start + block.size; ic++)
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+        }
+    } else {
+#pragma omp parallel for num_threads(nthreads)
+        for (int ic = 0; ic < nc; ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+
+    // 4)  Perform the iteration loops, sweeping the constraints color by color.
+    //     Blocks in the same color are independent and are processed in parallel.
+    //     Blocks which could not be colored are processed serially, at the end of each sweep.
+
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        maxviolation = 0;
+        double maxdeltalambda = 0;
+
+        for (int color = 0; color < m_coloring.GetNumColors(); color++) {
+            const std::vector<ChConstraintColoring::Block>& cblocks = m_coloring.GetColor(color);
+            int ncb = (int)cblocks.size();
+
+#pragma omp parallel num_threads(nthreads)
+            {
+                double t_violation = 0;
+                double t_deltalambda = 0;
+#pragma omp for schedule(static)
+                for (int ib = 0; ib < ncb; ib++) {
+                    UpdateBlock(mconstraints, cblocks[ib], t_violation, t_deltalambda);
+                }
+#pragma omp critical
+                {
+                    maxviolation = ChMax(maxviolation, t_violation);
+                    maxdeltalambda = ChMax(maxdeltalambda, t_deltalambda);
+                }
+            }
+        }
+
+        for (const auto& block : m_coloring.GetSerialBlocks()) {
+            UpdateBlock(mconstraints, block, maxviolation, maxdeltalambda);
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+    }
+
+    return maxviolation;
+}
+
+void ChSolverPSOR::UpdateBlock(std::vector<ChConstraint*>& mconstraints,
+                               const ChConstraintColoring::Block& block,
+                               double& violation,
+                               double& deltalambda) {
+    if (block.size == 3) {
+        // Frictional contact: update the N,U,V components, then project them together on the friction cone
+        double old_lambda[3];
+        for (unsigned int i = 0; i < 3; i++) {
+            ChConstraint* constraint = mconstraints[block.start + i];
+
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual =
+                constraint->Compute_Cq_q() + constraint->Get_b_i() + constraint->Get_cfm_i() * constraint->Get_l_i();
+
+            if (i == 0)
+                violation = ChMax(violation, fabs(ChMin(0.0, mresidual)));
+
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (m_omega / constraint->Get_g_i()) * (-mresidual);
+
+            // update:   lambda += delta_lambda;
+            old_lambda[i] = constraint->Get_l_i();
+            constraint->Set_l_i(old_lambda[i] + deltal);
+        }
+
+        mconstraints[block.start]->Project();  // the N normal component will take care of N,U,V
+
+        for (unsigned int i = 0; i < 3; i++) {
+            ChConstraint* constraint = mconstraints[block.start + i];
+            double new_lambda = constraint->Get_l_i();
+            // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+            if (m_shlambda != 1.0) {
+                new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda[i];
+                constraint->Set_l_i(new_lambda);
+            }
+            double true_delta = new_lambda - old_lambda[i];
+            constraint->Increment_q(true_delta);
+
+            if (this->record_violation_history)
+                deltalambda = ChMax(deltalambda, fabs(true_delta));
+        }
+
+        return;
+    }
+
+    ChConstraint* constraint = mconstraints[block.start];
+
+    // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+    double mresidual =
+        constraint->Compute_Cq_q() + constraint->Get_b_i() + constraint->Get_cfm_i() * constraint->Get_l_i();
+
+    // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+    violation = ChMax(violation, fabs(constraint->Violation(mresidual)));
+
+    // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+    double deltal = (m_omega / constraint->Get_g_i()) * (-mresidual);
+
+    // update:   lambda += delta_lambda;
+    double old_lambda = constraint->Get_l_i();
+    constraint->Set_l_i(old_lambda + deltal);
+
+    // If new lagrangian multiplier does not satisfy inequalities, project
+    // it into an admissible orthant (or, in general, onto an admissible set)
+    constraint->Project();
+
+    // After projection, the lambda may have changed a bit..
+    double new_lambda = constraint->Get_l_i();
+
+    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+    if (m_shlambda != 1.0) {
+        new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda;
+        constraint->Set_l_i(new_lambda);
+    }
+
+    double true_delta = new_lambda - old_lambda;
+
+    // For all items with variables, add the effect of incremented
+    // (and projected) lagrangian reactions:
+    constraint->Increment_q(true_delta);
+
+    if (this->record_violation_history)
+        deltalambda = ChMax(deltalambda, fabs(true_delta));
+}
+
 }  // end namespace chrono
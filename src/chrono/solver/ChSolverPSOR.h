@@ -16,6 +16,7 @@
 #define CHSOLVER_PSOR_H
 
 #include "chrono/solver/ChIterativeSolverVI.h"
+#include "chrono/solver/ChConstraintColoring.h"
 
 namespace chrono {
 
@@ -26,6 +27,11 @@ namespace chrono {
 /// SOR methods.\n
 /// See ChSystemDescriptor for more information about the problem formulation and the data structures passed to the
 /// solver.
+///
+/// Optionally, the sweep over the constraints can be multithreaded (see EnableMultithreading). In that case, the
+/// constraint graph is colored so that constraints acting on common variables are never updated concurrently.
+/// If packed contacts are enabled in the system descriptor (see ChSystemDescriptor::EnablePackedContacts), the serial
+/// sweep processes body-body contacts with the batched kernels of ChPackedContactBlock, in the same order.
 
 class ChApi ChSolverPSOR : public ChIterativeSolverVI {
   public:
@@ -44,8 +50,35 @@ class ChApi ChSolverPSOR : public ChIterativeSolverVI {
     /// For the PSOR solver, this is the maximum constraint violation.
     virtual double GetError() const override { return maxviolation; }
 
+    /// Enable/disable the multithreaded sweep (default: false).
+    /// If enabled, the constraints are partitioned in independent sets (colors) such that no two constraints in a set
+    /// act on the same ChVariables object, and the constraints of each set are processed in parallel, using the number
+    /// of threads specified in the system descriptor (see ChSystem::SetNumThreads). The Gauss-Seidel ordering is
+    /// therefore different from that of the serial sweep, but the results do not depend on the number of threads.
+    /// The multithreaded sweep is used whenever more than one thread is available or, if deterministic mode is enabled
+    /// in the system descriptor, also with a single thread.
+    void EnableMultithreading(bool val) { m_multithreading = val; }
+
+    /// Return true if the multithreaded sweep is enabled.
+    bool IsMultithreading() const { return m_multithreading; }
+
   private:
+    /// Multithreaded variant of Solve, sweeping the constraints color by color.
+    double SolveColored(ChSystemDescriptor& sysd);
+
+    /// Perform the projected SOR update of one constraint block and apply the resulting increments to 'q'.
+    void UpdateBlock(std::vector<ChConstraint*>& mconstraints,
+                     const ChConstraintColoring::Block& block,
+                     double& violation,
+                     double& deltalambda);
+
+    /// Perform the projected SOR update of the k-th packed contact and apply the resulting increments to 'q'.
+    /// Return the violation of the normal component.
+    double UpdatePackedContact(ChPackedContactBlock& mpacked, int k, double& maxdeltalambda);
+
     double maxviolation;
+    bool m_multithreading;
+    ChConstraintColoring m_coloring;
 };
 
 /// @} chrono_solver
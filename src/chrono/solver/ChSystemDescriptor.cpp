@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+#include <memory>
+
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
@@ -25,7 +28,18 @@ CH_FACTORY_REGISTER(ChSystemDescriptor)
 
 #define CH_SPINLOCK_HASHSIZE 203
 
-ChSystemDescriptor::ChSystemDescriptor() : n_q(0), n_c(0), c_a(1.0), freeze_count(false) {
+// Minimum number of items (variables, stiffness blocks, and constraints) for using the parallel matrix assembly
+#define CH_PARALLEL_ASSEMBLY_MIN_ITEMS 1000
+
+ChSystemDescriptor::ChSystemDescriptor()
+    : n_q(0),
+      n_c(0),
+      c_a(1.0),
+      n_threads(1),
+      deterministic(false),
+      use_packed_contacts(false),
+      packed_contacts_valid(false),
+      freeze_count(false) {
     vconstraints.clear();
     vvariables.clear();
     vstiffness.clear();
@@ -37,6 +51,17 @@ ChSystemDescriptor::~ChSystemDescriptor() {
     vstiffness.clear();
 }
 
+bool ChSystemDescriptor::PackContacts() {
+    packed_contacts_valid = false;
+    if (!use_packed_contacts)
+        return false;
+
+    packed_contacts.Update(*this);
+    packed_contacts_valid = true;
+
+    return true;
+}
+
 void ChSystemDescriptor::ComputeFeasabilityViolation(double& resulting_maxviolation, double& resulting_feasability) {
     resulting_maxviolation = 0;
     resulting_feasability = 0;
@@ -215,32 +240,36 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChVectorDynamic<
         Z->conservativeResize(n_q + mn_c, n_q + mn_c);
         Z->setZeroValues();        
 
-        // Fill Z with masses and inertias.
-        int s_q = 0;
-        for (size_t iv = 0; iv < mv_size; iv++) {
-            if (mvariables[iv]->IsActive()) {
-                // Masses and inertias in upper-left block of Z
-                mvariables[iv]->Build_M(*Z, s_q, s_q, c_a);
-                s_q += mvariables[iv]->Get_ndof();
+        if (n_threads > 1 && mv_size + vs_size + mc_size >= CH_PARALLEL_ASSEMBLY_MIN_ITEMS) {
+            ConvertToMatrixFormParallel(*Z);
+        } else {
+            // Fill Z with masses and inertias.
+            int s_q = 0;
+            for (size_t iv = 0; iv < mv_size; iv++) {
+                if (mvariables[iv]->IsActive()) {
+                    // Masses and inertias in upper-left block of Z
+                    mvariables[iv]->Build_M(*Z, s_q, s_q, c_a);
+                    s_q += mvariables[iv]->Get_ndof();
+                }
             }
-        }
 
-        // If present, add stiffness matrix K to upper-left block of Z.
-        for (size_t ik = 0; ik < vs_size; ik++) {
-            vstiffness[ik]->Build_K(*Z, true);
-        }
+            // If present, add stiffness matrix K to upper-left block of Z.
+            for (size_t ik = 0; ik < vs_size; ik++) {
+                vstiffness[ik]->Build_K(*Z, true);
+            }
 
-        // Fill Z by looping over constraints.
-        int s_c = 0;
-        for (size_t ic = 0; ic < mc_size; ic++) {
-            if (mconstraints[ic]->IsActive()) {
-                // Constraint Jacobian in lower-left block of Z
-                mconstraints[ic]->Build_Cq(*Z, n_q + s_c);
-                // Transposed constraint Jacobian in upper-right block of Z
-                mconstraints[ic]->Build_CqT(*Z, n_q + s_c);
-                // E ( = cfm ) in lower-right block of Z
-                Z->SetElement(n_q + s_c, n_q + s_c, mconstraints[ic]->Get_cfm_i());
-                s_c++;
+            // Fill Z by looping over constraints.
+            int s_c = 0;
+            for (size_t ic = 0; ic < mc_size; ic++) {
+                if (mconstraints[ic]->IsActive()) {
+                    // Constraint Jacobian in lower-left block of Z
+                    mconstraints[ic]->Build_Cq(*Z, n_q + s_c);
+                    // Transposed constraint Jacobian in upper-right block of Z
+                    mconstraints[ic]->Build_CqT(*Z, n_q + s_c);
+                    // E ( = cfm ) in lower-right block of Z
+                    Z->SetElement(n_q + s_c, n_q + s_c, mconstraints[ic]->Get_cfm_i());
+                    s_c++;
+                }
             }
         }
     }
@@ -270,6 +299,119 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChVectorDynamic<
     }
 }
 
+// Sparse matrix which does not store the elements set through SetElement(), but records them (with their row, column,
+// value, and overwrite flag) in separate buckets for disjoint ranges of rows.
+class ChSparseMatrixRecorder final : public ChSparseMatrix {
+  public:
+    struct Element {
+        int row;
+        int col;
+        double val;
+        bool overwrite;
+    };
+
+    ChSparseMatrixRecorder(int nrows, int ncols, int nbuckets) : ChSparseMatrix(nrows, ncols), buckets(nbuckets) {}
+
+    virtual void SetElement(int row, int col, double val, bool overwrite = true) override {
+        buckets[GetBucket(row)].push_back({row, col, val, overwrite});
+    }
+
+    // Index of the bucket (range of rows) for the given row.
+    int GetBucket(int row) const { return (int)(((long long)row * buckets.size()) / rows()); }
+
+    std::vector<std::vector<Element>> buckets;
+};
+
+void ChSystemDescriptor::ConvertToMatrixFormParallel(ChSparseMatrix& Z) {
+    auto mv_size = vvariables.size();
+    auto vs_size = vstiffness.size();
+    auto mc_size = vconstraints.size();
+    int n = (int)Z.rows();
+
+    // Offsets of the variables and constraints (as assigned in the serial assembly)
+    std::vector<int> v_offsets(mv_size);
+    int s_q = 0;
+    for (size_t iv = 0; iv < mv_size; iv++) {
+        v_offsets[iv] = s_q;
+        if (vvariables[iv]->IsActive())
+            s_q += vvariables[iv]->Get_ndof();
+    }
+    std::vector<int> c_offsets(mc_size);
+    int s_c = 0;
+    for (size_t ic = 0; ic < mc_size; ic++) {
+        c_offsets[ic] = s_q + s_c;
+        if (vconstraints[ic]->IsActive())
+            s_c++;
+    }
+
+    // 1 - The sequence of all items (variables, then stiffness blocks, then constraints) is split in contiguous chunks,
+    //     one per thread. Each thread records the elements of its items in a private buffer, bucketed by rows.
+    int nchunks = n_threads;
+    size_t n_items = mv_size + vs_size + mc_size;
+    std::vector<std::unique_ptr<ChSparseMatrixRecorder>> recorders(nchunks);
+
+#pragma omp parallel for schedule(static, 1) num_threads(n_threads)
+    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+        recorders[ichunk].reset(new ChSparseMatrixRecorder(n, n, nchunks));
+        auto recorder = recorders[ichunk].get();
+        size_t start = (n_items * ichunk) / nchunks;
+        size_t end = (n_items * (ichunk + 1)) / nchunks;
+        for (size_t i = start; i < end; i++) {
+            if (i < mv_size) {
+                // Masses and inertias in upper-left block of Z
+                if (vvariables[i]->IsActive())
+                    vvariables[i]->Build_M(*recorder, v_offsets[i], v_offsets[i], c_a);
+            } else if (i < mv_size + vs_size) {
+                // Stiffness matrix K in upper-left block of Z
+                vstiffness[i - mv_size]->Build_K(*recorder, true);
+            } else {
+                // Constraint Jacobian, its transpose, and cfm term
+                size_t ic = i - mv_size - vs_size;
+                if (vconstraints[ic]->IsActive()) {
+                    vconstraints[ic]->Build_Cq(*recorder, c_offsets[ic]);
+                    vconstraints[ic]->Build_CqT(*recorder, c_offsets[ic]);
+                    recorder->SetElement(c_offsets[ic], c_offsets[ic], vconstraints[ic]->Get_cfm_i());
+                }
+            }
+        }
+    }
+
+    // 2 - Each thread merges the elements in one bucket (range of rows) directly into the existing sparsity pattern of
+    //     Z, processing the buffers in chunk order so that the result is identical to that of the serial assembly.
+    //     Elements not present in the sparsity pattern are collected and inserted afterwards, in the same order.
+    std::vector<std::vector<ChSparseMatrixRecorder::Element>> missing(nchunks);
+    const int* outer = Z.outerIndexPtr();
+    const int* inner = Z.innerIndexPtr();
+    const int* inner_nnz = Z.innerNonZeroPtr();
+    double* values = Z.valuePtr();
+
+#pragma omp parallel for schedule(static, 1) num_threads(n_threads)
+    for (int ibucket = 0; ibucket < nchunks; ibucket++) {
+        for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+            for (const auto& el : recorders[ichunk]->buckets[ibucket]) {
+                int row_start = outer[el.row];
+                int row_end = inner_nnz ? row_start + inner_nnz[el.row] : outer[el.row + 1];
+                const int* pos = std::lower_bound(inner + row_start, inner + row_end, el.col);
+                if (pos != inner + row_end && *pos == el.col) {
+                    double& val = values[pos - inner];
+                    val = el.overwrite ? el.val : val + el.val;
+                } else {
+                    missing[ibucket].push_back(el);
+                }
+            }
+        }
+    }
+
+    recorders.clear();
+
+    // 3 - Insert the elements that were not in the sparsity pattern (this also covers the case where Z is a
+    //     ChSparsityPatternLearner).
+    for (int ibucket = 0; ibucket < nchunks; ibucket++) {
+        for (const auto& el : missing[ibucket])
+            Z.SetElement(el.row, el.col, el.val, el.overwrite);
+    }
+}
+
 int ChSystemDescriptor::BuildFbVector(ChVectorDynamic<>& Fvector) {
     n_q = CountActiveVariables();
     Fvector.setZero(n_q);
@@ -510,6 +652,24 @@ void ChSystemDescriptor::ShurComplementProduct(ChVectorDynamic<>& result,
 
     // ATTENTION:  this loop cannot be parallelized! Concurrent write to some q may happen
     for (size_t ic = 0; ic < vc_size; ic++) {
+        if (packed_contacts_valid) {
+            // Body-body contacts are processed by the packed contact kernels (all three rows at once)
+            int k = packed_contacts.GetContactIndex(ic);
+            if (k >= 0) {
+                int s_c = packed_contacts.GetOffset(k);
+                const double* cfm = packed_contacts.Get_cfm(k);
+                double li[3];
+                for (int j = 0; j < 3; j++) {
+                    bool process = (!enabled) || (*enabled)[s_c + j];
+                    li[j] = process ? lvector(s_c + j) : 0.0;
+                    result(s_c + j) = cfm[j] * li[j];
+                }
+                packed_contacts.Increment_q(k, li);
+            }
+            if (k != ChPackedContactBlock::NOT_PACKED)
+                continue;
+        }
+
         if (vconstraints[ic]->IsActive()) {
             int s_c = vconstraints[ic]->GetOffset();
 
@@ -532,6 +692,24 @@ void ChSystemDescriptor::ShurComplementProduct(ChVectorDynamic<>& result,
     //     iterating over all constraints
 
     for (size_t ic = 0; ic < vc_size; ic++) {
+        if (packed_contacts_valid) {
+            int k = packed_contacts.GetContactIndex(ic);
+            if (k >= 0) {
+                int s_c = packed_contacts.GetOffset(k);
+                double Cq_q[3];
+                packed_contacts.Compute_Cq_q(k, Cq_q);
+                for (int j = 0; j < 3; j++) {
+                    bool process = (!enabled) || (*enabled)[s_c + j];
+                    if (process)
+                        result(s_c + j) += Cq_q[j];
+                    else
+                        result(s_c + j) = 0;
+                }
+            }
+            if (k != ChPackedContactBlock::NOT_PACKED)
+                continue;
+        }
+
         if (vconstraints[ic]->IsActive()) {
             bool process = (!enabled) || (*enabled)[vconstraints[ic]->GetOffset()];
 
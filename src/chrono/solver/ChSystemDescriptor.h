@@ -19,6 +19,7 @@
 
 #include "chrono/solver/ChConstraint.h"
 #include "chrono/solver/ChKblock.h"
+#include "chrono/solver/ChPackedContactBlock.h"
 #include "chrono/solver/ChVariables.h"
 
 namespace chrono {
@@ -77,11 +78,23 @@ class ChApi ChSystemDescriptor {
 
     double c_a;  // coefficient form M mass matrices in vvariables
 
+    int n_threads;       ///< number of threads that solvers may use on this descriptor
+    bool deterministic;  ///< if true, solvers must produce results independent of the number of threads
+
+    bool use_packed_contacts;             ///< if true, solvers may use a packed representation of the contacts
+    bool packed_contacts_valid;           ///< true if the packed contacts are up-to-date
+    ChPackedContactBlock packed_contacts;  ///< packed representation of body-body frictional contacts
+
   private:
     int n_q;            ///< number of active variables
     int n_c;            ///< number of active constraints
     bool freeze_count;  ///< for optimization: avoid to re-count the number of active variables and constraints
 
+    /// Multithreaded assembly of the system matrix (Z must be already sized and zeroed).
+    /// Threads record the matrix elements of contiguous chunks of items in private buffers, which are then merged in
+    /// parallel (by ranges of rows) into the current sparsity pattern of Z.
+    void ConvertToMatrixFormParallel(ChSparseMatrix& Z);
+
   public:
     /// Constructor
     ChSystemDescriptor();
@@ -105,6 +118,7 @@ class ChApi ChSystemDescriptor {
         vconstraints.clear();
         vvariables.clear();
         vstiffness.clear();
+        packed_contacts_valid = false;
     }
 
     /// Insert reference to a ChConstraint object
@@ -146,6 +160,45 @@ class ChApi ChSystemDescriptor {
     /// when performing ShurComplementProduct(), SystemProduct(), ConvertToMatrixForm(),
     virtual double GetMassFactor() { return c_a; }
 
+    /// Set the number of threads that solvers may use when operating on this descriptor (default: 1).
+    /// This is set automatically by the owning ChSystem to its Chrono thread count (see ChSystem::SetNumThreads).
+    void SetNumThreads(int nthreads) { n_threads = (nthreads < 1) ? 1 : nthreads; }
+
+    /// Get the number of threads that solvers may use when operating on this descriptor.
+    int GetNumThreads() const { return n_threads; }
+
+    /// Enable/disable deterministic mode (default: false).
+    /// If enabled, solvers which support it produce results that are bit-for-bit identical for any number of threads
+    /// (for example, by using the same multithreaded algorithm also with a single thread).
+    /// This is set automatically by the owning ChSystem (see ChSystem::EnableDeterministicMode).
+    void EnableDeterministicMode(bool val) { deterministic = val; }
+
+    /// Return true if deterministic mode is enabled.
+    bool IsDeterministicModeEnabled() const { return deterministic; }
+
+    /// Enable/disable the use of a packed representation of the body-body frictional contacts (default: false).
+    /// If enabled, iterative solvers which support it (PSOR, APGD, BB) process the triplets of contact constraints
+    /// between two 6-DOF objects with batched kernels operating on contiguous data (see ChPackedContactBlock), and
+    /// all other constraints through the generic ChConstraint interface.
+    void EnablePackedContacts(bool val) { use_packed_contacts = val; }
+
+    /// Return true if the use of packed contacts is enabled.
+    bool IsPackedContactsEnabled() const { return use_packed_contacts; }
+
+    /// Update the packed representation of the body-body frictional contacts, if enabled.
+    /// Solvers must call this function after updating the auxiliary data of the constraints (g_i and [Eq]) and must
+    /// call ReleasePackedContacts() when done. Return true if packed contacts are available.
+    bool PackContacts();
+
+    /// Invalidate the packed representation of the contacts.
+    void ReleasePackedContacts() { packed_contacts_valid = false; }
+
+    /// Return true if the packed representation of the contacts is currently valid.
+    bool HasPackedContacts() const { return packed_contacts_valid; }
+
+    /// Access the packed representation of the body-body frictional contacts.
+    ChPackedContactBlock& GetPackedContacts() { return packed_contacts; }
+
     // DATA <-> MATH.VECTORS FUNCTIONS
 
     /// Get a vector with all the 'fb' known terms ('forces'etc.) associated to all variables,
@@ -321,6 +374,8 @@ class ChApi ChSystemDescriptor {
     );
 
     /// Create and return the assembled system matrix and RHS vector.
+    /// If more than one thread is available (see SetNumThreads) and the system is large enough, the system matrix is
+    /// assembled in parallel, with results identical to those of the serial assembly.
     virtual void ConvertToMatrixForm(ChSparseMatrix* Z,      ///< [out] assembled system matrix
                                      ChVectorDynamic<>* rhs  ///< [out] assembled RHS vector
     );
@@ -200,6 +200,11 @@ class ChApi ChIntegrable {
                                    ) {
         throw ChException("LoadConstraint_Ct() not implemented, implicit integrators cannot be used. ");
     }
+
+    /// Evaluate the constraint Jacobians Cq at the current state (i.e., the state last scattered to the integrable
+    /// object). The Jacobians are otherwise evaluated when solving for a correction (see StateSolveCorrection) and
+    /// are also used in the residual terms Cq'*L. By default it does nothing.
+    virtual void LoadConstraintJacobians() {}
 };
 
 // -----------------------------------------------------------------------------
@@ -65,6 +65,39 @@ void ChTimestepper::ArchiveIN(ChArchiveIn& archive) {
     archive >> CHNVP(Qc_do_clamp);
     archive >> CHNVP(Qc_clamping);
 }
+
+// -----------------------------------------------------------------------------
+
+double ChImplicitIterativeTimestepper::AdaptiveErrorNorm(const ChVectorDynamic<>& err,
+                                                         const ChVectorDynamic<>& y) const {
+    if (err.size() == 0)
+        return 0;
+    ChVectorDynamic<> ewt = (adaptive_reltol * y.cwiseAbs()).array() + adaptive_abstol;
+    return err.wrmsNorm(ewt.cwiseInverse());
+}
+
+// PI step size controller (Gustafsson). For an accepted step, the new step size is
+//    h_new = h * safety * (1/err)^(kI+kP) * err_prev^kP,   with kI = 0.3/k, kP = 0.4/k
+// where err_prev is the error norm of the previous accepted step. After a rejected step, only the current
+// error norm is used. In both cases, the step size ratio is limited to [facmin, facmax].
+double ChImplicitIterativeTimestepper::AdaptiveStepSize(double h, double err, int k, bool accepted) {
+    err = ChMax(err, 1e-10);
+
+    double fac;
+    if (accepted) {
+        double kI = 0.3 / k;
+        double kP = 0.4 / k;
+        fac = adaptive_safety * std::pow(err, -(kI + kP)) * std::pow(err_prev, kP);
+        fac = ChMin(adaptive_facmax, ChMax(adaptive_facmin, fac));
+        err_prev = err;
+    } else {
+        fac = adaptive_safety * std::pow(err, -1.0 / k);
+        fac = ChMin(1.0, ChMax(adaptive_facmin, fac));
+    }
+
+    return h * fac;
+}
+
 // -----------------------------------------------------------------------------
 
 // Register into the object factory, to enable run-time dynamic creation and persistence
@@ -323,68 +356,158 @@ void ChTimestepperEulerImplicit::Advance(const double dt) {
 
     mintegrable->StateGather(X, V, T);  // state <- system
 
-    // Extrapolate a prediction as warm start
-
-    Xnew = X + V * dt;
-    Vnew = V;  //+ A()*dt;
-
-    // use Newton Raphson iteration to solve implicit Euler for v_new
-    //
-    // [ M - dt*dF/dv - dt^2*dF/dx    Cq' ] [ Dv     ] = [ M*(v_old - v_new) + dt*f + dt*Cq'*l ]
-    // [ Cq                           0   ] [ -dt*Dl ] = [ -C/dt  ]
-
     numiters = 0;
     numsetups = 0;
     numsolves = 0;
+    num_accepted = 0;
+    num_rejected = 0;
+
+    // Without adaptive step size control, take a single step of size dt.
+    // Otherwise, cover the interval dt with internal steps of size h selected by the error controller.
+    double tfinal = T + dt;
+    double h = (adaptive && h_adapt > 0) ? ChMin(h_adapt, dt) : dt;
+
+    // Depending on the Jacobian update policy, the Newton matrix is updated at each iteration, at the first iteration
+    // of each step, or only when it cannot be reused (AUTOMATIC). In the latter case, a step that does not converge
+    // with a matrix from a previous step is re-attempted with an updated matrix.
+    int nv = mintegrable->GetNcoords_v();
+    int nc = mintegrable->GetNconstr();
+    bool force_setup = false;
+
+    while (true) {
+        bool truncated = false;
+        if (adaptive && T + h > tfinal) {
+            h = tfinal - T;
+            truncated = true;
+        }
 
-    for (int i = 0; i < this->GetMaxiters(); ++i) {
-        mintegrable->StateScatter(Xnew, Vnew, T + dt, false);  // state -> system
-        R.setZero();
-        Qc.setZero();
-        mintegrable->LoadResidual_F(R, dt);
-        mintegrable->LoadResidual_Mv(R, (V - Vnew), 1.0);
-        mintegrable->LoadResidual_CqL(R, L, dt);
-        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);
+        // Extrapolate a prediction as warm start
+
+        Xnew = X + V * h;
+        Vnew = V;  //+ A()*h;
+        L.setZero();
+
+        // use Newton Raphson iteration to solve implicit Euler for v_new
+        //
+        // [ M - h*dF/dv - h^2*dF/dx    Cq' ] [ Dv     ] = [ M*(v_old - v_new) + h*f + h*Cq'*l ]
+        // [ Cq                         0   ] [ -h*Dl  ] = [ -C/h  ]
+
+        bool call_setup = force_setup || jacobian_update != JacobianUpdate::AUTOMATIC || !CanReuseJacobian(h, nv, nc);
+        bool converged = false;
+        bool fresh_matrix = false;
+        double Dv_nrm_prev = 0;
+        force_setup = false;
+
+        for (int i = 0; i < this->GetMaxiters(); ++i) {
+            mintegrable->StateScatter(Xnew, Vnew, T + h, false);  // state -> system
+            R.setZero();
+            Qc.setZero();
+            mintegrable->LoadResidual_F(R, h);
+            mintegrable->LoadResidual_Mv(R, (V - Vnew), 1.0);
+            mintegrable->LoadResidual_CqL(R, L, h);
+            mintegrable->LoadConstraint_C(Qc, 1.0 / h, Qc_do_clamp, Qc_clamping);
+
+            if (verbose)
+                GetLog() << " Euler iteration=" << i << "  |R|=" << R.lpNorm<Eigen::Infinity>()
+                         << "  |Qc|=" << Qc.lpNorm<Eigen::Infinity>() << "\n";
+
+            if ((R.lpNorm<Eigen::Infinity>() < abstolS) && (Qc.lpNorm<Eigen::Infinity>() < abstolL)) {
+                converged = true;
+                break;
+            }
 
-        if (verbose)
-            GetLog() << " Euler iteration=" << i << "  |R|=" << R.lpNorm<Eigen::Infinity>()
-                     << "  |Qc|=" << Qc.lpNorm<Eigen::Infinity>() << "\n";
+            mintegrable->StateSolveCorrection(  //
+                Dv, Dl, R, Qc,                  //
+                1.0,                            // factor for  M
+                -h,                             // factor for  dF/dv
+                -h * h,                         // factor for  dF/dx
+                Xnew, Vnew, T + h,              // not used here (scatter = false)
+                false,                          // do not scatter update to Xnew Vnew T+h before computing correction
+                false,                          // full update? (not used, since no scatter)
+                call_setup                      // call the solver's Setup?
+            );
+
+            numiters++;
+            numsolves++;
+            if (call_setup) {
+                numsetups++;
+                fresh_matrix = true;
+                SetJacobianUpdated(h, nv, nc);
+            }
 
-        if ((R.lpNorm<Eigen::Infinity>() < abstolS) && (Qc.lpNorm<Eigen::Infinity>() < abstolL))
-            break;
+            // Update the Newton matrix at the next iteration only for full Newton or if reusing a matrix from a
+            // previous step and the ratio of successive corrections is too large
+            double Dv_nrm = Dv.norm();
+            call_setup = (jacobian_update == JacobianUpdate::EVERY_ITERATION) ||
+                         (jacobian_update == JacobianUpdate::AUTOMATIC && !fresh_matrix && i > 0 &&
+                          Dv_nrm > jacobian_max_rate * Dv_nrm_prev);
+            Dv_nrm_prev = Dv_nrm;
 
-        mintegrable->StateSolveCorrection(  //
-            Dv, Dl, R, Qc,                  //
-            1.0,                            // factor for  M
-            -dt,                            // factor for  dF/dv
-            -dt * dt,                       // factor for  dF/dx
-            Xnew, Vnew, T + dt,             // not used here (scatter = false)
-            false,                          // do not scatter update to Xnew Vnew T+dt before computing correction
-            false,                          // full update? (not used, since no scatter)
-            true                            // always call the solver's Setup
-        );
+            Dl *= (1.0 / h);  // Note it is not -(1.0/h) because we assume StateSolveCorrection already flips sign of Dl
+            L += Dl;
 
-        numiters++;
-        numsetups++;
-        numsolves++;
+            Vnew += Dv;
 
-        Dl *= (1.0 / dt);  // Note it is not -(1.0/dt) because we assume StateSolveCorrection already flips sign of Dl
-        L += Dl;
+            Xnew = X + Vnew * h;
+        }
 
-        Vnew += Dv;
+        if (!converged && !fresh_matrix && jacobian_update == JacobianUpdate::AUTOMATIC) {
+            // Re-attempt step with an updated Newton matrix
+            if (verbose)
+                GetLog() << " Euler re-attempt step with updated matrix.\n";
 
-        Xnew = X + Vnew * dt;
-    }
+            mintegrable->StateScatter(X, V, T, false);
+            force_setup = true;
+            continue;
+        }
 
-    mintegrable->StateScatterAcceleration(
-        (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+        if (adaptive) {
+            // Local error estimate: difference between the implicit Euler and the trapezoidal position updates,
+            //    e = h/2 * (v_new - v_old)
+            err_last = AdaptiveErrorNorm((Vnew - V) * (h / 2), Vnew * h);
 
-    X = Xnew;
-    V = Vnew;
-    T += dt;
+            if (err_last > 1) {
+                // Reject step, reduce stepsize and re-attempt from the current state
+                num_rejected++;
+                h = AdaptiveStepSize(h, err_last, 2, false);
+                h_adapt = h;
+
+                if (verbose)
+                    GetLog() << " ---Euler reject step (err = " << err_last << "), reduce stepsize to " << h << "\n";
 
-    mintegrable->StateScatter(X, V, T, true);     // state -> system
-    mintegrable->StateScatterReactions(L);  // -> system auxiliary data
+                if (h < h_min)
+                    throw ChException("Euler implicit: Reached minimum allowable step size.");
+
+                mintegrable->StateScatter(X, V, T, false);
+                continue;
+            }
+
+            // Accept step and propose the size of the next step. If the step was truncated to reach the end of the
+            // interval, only allow the proposal to decrease.
+            num_accepted++;
+            double h_new = AdaptiveStepSize(h, err_last, 2, true);
+            if (!truncated || h_new < h)
+                h_adapt = h_new;
+        }
+
+        A = (Vnew - V) * (1 / h);
+        X = Xnew;
+        V = Vnew;
+        T += h;
+
+        if (!adaptive || tfinal - T < ChMin(h_min, 1e-6)) {
+            T = tfinal;
+            break;
+        }
+
+        mintegrable->StateScatter(X, V, T, false);  // state -> system
+        h = h_adapt;
+    }
+
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+
+    mintegrable->StateScatter(X, V, T, true);  // state -> system
+    mintegrable->StateScatterReactions(L);     // -> system auxiliary data
 }
 
 // -----------------------------------------------------------------------------
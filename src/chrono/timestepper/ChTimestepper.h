@@ -15,6 +15,7 @@
 #ifndef CHTIMESTEPPER_H
 #define CHTIMESTEPPER_H
 
+#include <cmath>
 #include <cstdlib>
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChMath.h"
@@ -92,6 +93,15 @@ class ChApi ChTimestepper {
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& archive);
 
+    /// Write the internal data carried over from one step to the next (e.g., step size control data).
+    /// Used in writing a checkpoint of the system state (see ChSystem::CheckpointOUT). Note that the state of the
+    /// integrable object (positions, velocities, accelerations, and Lagrange multipliers) is not part of this data.
+    virtual void CheckpointOUT(ChArchiveOut& archive) {}
+
+    /// Read the internal data carried over from one step to the next.
+    /// Used in restoring the system state from a checkpoint (see ChSystem::CheckpointIN).
+    virtual void CheckpointIN(ChArchiveIn& archive) {}
+
   protected:
     ChIntegrable* integrable;
     double T;
@@ -176,6 +186,14 @@ class ChApi ChImplicitTimestepper {};
 /// using an iterative process, up to a desired tolerance. At each iteration,
 /// a linear system must be solved.
 class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
+  public:
+    /// Policy for updating (re-evaluating and re-factorizing) the Newton matrix.
+    enum class JacobianUpdate {
+        EVERY_ITERATION,  ///< update the Newton matrix at every iteration (full Newton)
+        EVERY_STEP,       ///< update the Newton matrix at the beginning of each step (modified Newton)
+        AUTOMATIC         ///< reuse the Newton matrix across steps, until the Newton convergence rate degrades
+    };
+
   protected:
     int maxiters;    ///< maximum number of iterations
     double reltol;   ///< relative tolerance
@@ -186,9 +204,51 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     int numsetups;  ///< number of calls to the solver's Setup function
     int numsolves;  ///< number of calls to the solver's Solve function
 
+    bool adaptive;           ///< error-based adaptive step size control enabled?
+    double adaptive_reltol;  ///< relative tolerance for the local error test
+    double adaptive_abstol;  ///< absolute tolerance for the local error test
+    double adaptive_safety;  ///< safety factor of the step size controller (<1)
+    double adaptive_facmin;  ///< minimum ratio between successive step sizes (<1)
+    double adaptive_facmax;  ///< maximum ratio between successive step sizes (>1)
+    double h_adapt;          ///< step size proposed by the controller for the next step (0 if none)
+    double err_prev;         ///< error norm of the last accepted step
+    double err_last;         ///< error norm of the last attempted step
+    int num_accepted;        ///< number of steps accepted by the local error test
+    int num_rejected;        ///< number of steps rejected by the local error test
+
+    JacobianUpdate jacobian_update;  ///< policy for updating the Newton matrix
+    double jacobian_max_rate;        ///< maximum Newton convergence rate with a reused matrix (AUTOMATIC only)
+    bool jacobian_valid;             ///< is there a Newton matrix from a previous step?
+    double jacobian_h;               ///< step size at the last Newton matrix update
+    int jacobian_nv;                 ///< number of state derivatives at the last Newton matrix update
+    int jacobian_nc;                 ///< number of constraints at the last Newton matrix update
+
   public:
     ChImplicitIterativeTimestepper()
-        : maxiters(6), reltol(1e-4), abstolS(1e-10), abstolL(1e-10), numiters(0), numsetups(0), numsolves(0) {}
+        : maxiters(6),
+          reltol(1e-4),
+          abstolS(1e-10),
+          abstolL(1e-10),
+          numiters(0),
+          numsetups(0),
+          numsolves(0),
+          adaptive(false),
+          adaptive_reltol(1e-3),
+          adaptive_abstol(1e-6),
+          adaptive_safety(0.9),
+          adaptive_facmin(0.2),
+          adaptive_facmax(5),
+          h_adapt(0),
+          err_prev(1),
+          err_last(0),
+          num_accepted(0),
+          num_rejected(0),
+          jacobian_update(JacobianUpdate::EVERY_ITERATION),
+          jacobian_max_rate(0.5),
+          jacobian_valid(false),
+          jacobian_h(0),
+          jacobian_nv(0),
+          jacobian_nc(0) {}
     virtual ~ChImplicitIterativeTimestepper() {}
 
     /// Set the max number of iterations using the Newton Raphson procedure
@@ -228,6 +288,70 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     /// Return the number of calls to the solver's Solve function.
     int GetNumSolveCalls() const { return numsolves; }
 
+    /// Set the policy for updating the Newton matrix (Jacobian).
+    /// With AUTOMATIC, the matrix (and its factorization, if using a direct linear solver) is kept across steps, as
+    /// long as the step size and the problem size do not change. A matrix from a previous step is re-evaluated if the
+    /// ratio of successive Newton corrections exceeds the threshold set with SetJacobianMaxRate, and a step that fails
+    /// to converge with a reused matrix is re-attempted with an up-to-date matrix.
+    /// Note that the solver's factorization is assumed to be left untouched between steps; call
+    /// ForceJacobianUpdate if the solver is used for other purposes (e.g., an assembly analysis) in between.
+    void SetJacobianUpdateMethod(JacobianUpdate method) {
+        jacobian_update = method;
+        jacobian_valid = false;
+    }
+
+    /// Return the policy for updating the Newton matrix.
+    JacobianUpdate GetJacobianUpdateMethod() const { return jacobian_update; }
+
+    /// Set the maximum convergence rate (ratio of the norms of successive Newton corrections) accepted with a
+    /// reused Newton matrix (AUTOMATIC update policy only). Default: 0.5.
+    void SetJacobianMaxRate(double rate) { jacobian_max_rate = rate; }
+
+    /// Force an update of the Newton matrix at the next step (AUTOMATIC update policy only).
+    void ForceJacobianUpdate() { jacobian_valid = false; }
+
+    /// Enable/disable adaptive step size control based on a local truncation error estimate.
+    /// If enabled, a call to Advance(dt) covers the interval dt with internal steps whose size is selected by a PI
+    /// controller so that the weighted RMS norm of the local error estimate stays below 1. The internal step size is
+    /// never larger than dt and is carried over to the next call to Advance. Disabled by default (only supported by
+    /// timesteppers that provide an error estimate, i.e. HHT and Euler implicit).
+    void SetAdaptiveStepControl(bool val) {
+        adaptive = val;
+        h_adapt = 0;
+        err_prev = 1;
+    }
+
+    /// Return true if adaptive step size control is enabled.
+    bool IsAdaptiveStepControl() const { return adaptive; }
+
+    /// Set the relative and absolute tolerances for the local error test.
+    /// The error estimate (in position units) for each coordinate is weighted by 1/(atol + rtol*|h*v|), where h*v is
+    /// the displacement over the step. Defaults: rtol = 1e-3, atol = 1e-6.
+    void SetAdaptiveTolerances(double rtol, double atol) {
+        adaptive_reltol = rtol;
+        adaptive_abstol = atol;
+    }
+
+    /// Set the limits on the ratio between successive step sizes (facmin < 1 < facmax) and the controller safety
+    /// factor (less than 1). Defaults: facmin = 0.2, facmax = 5, safety = 0.9.
+    void SetAdaptiveStepFactors(double facmin, double facmax, double safety = 0.9) {
+        adaptive_facmin = facmin;
+        adaptive_facmax = facmax;
+        adaptive_safety = safety;
+    }
+
+    /// Return the step size proposed by the adaptive controller for the next step (0 if none yet).
+    double GetAdaptiveStepSize() const { return h_adapt; }
+
+    /// Return the number of internal steps accepted by the local error test during the last call to Advance.
+    int GetNumAcceptedSteps() const { return num_accepted; }
+
+    /// Return the number of internal steps rejected by the local error test during the last call to Advance.
+    int GetNumRejectedSteps() const { return num_rejected; }
+
+    /// Return the (weighted RMS) norm of the local error estimate of the last attempted step.
+    double GetLastErrorNorm() const { return err_last; }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& archive) {
         // version number
@@ -249,6 +373,43 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
         archive >> CHNVP(abstolS);
         archive >> CHNVP(abstolL);
     }
+
+  protected:
+    /// Write the step size control data carried over from one step to the next.
+    void CheckpointStepControlOUT(ChArchiveOut& archive) {
+        archive << CHNVP(h_adapt);
+        archive << CHNVP(err_prev);
+    }
+
+    /// Read the step size control data carried over from one step to the next.
+    /// A Newton matrix from a previous step is not available after a restart.
+    void CheckpointStepControlIN(ChArchiveIn& archive) {
+        archive >> CHNVP(h_adapt);
+        archive >> CHNVP(err_prev);
+        jacobian_valid = false;
+    }
+
+    /// Return the weighted RMS norm of a local error estimate, using weights 1/(atol + rtol*|y|).
+    double AdaptiveErrorNorm(const ChVectorDynamic<>& err, const ChVectorDynamic<>& y) const;
+
+    /// Return true if the Newton matrix from a previous step can be reused for a step of size h of a problem with
+    /// nv state derivatives and nc constraints (AUTOMATIC update policy only).
+    bool CanReuseJacobian(double h, int nv, int nc) const {
+        return jacobian_update == JacobianUpdate::AUTOMATIC && jacobian_valid && nv == jacobian_nv &&
+               nc == jacobian_nc && std::abs(h - jacobian_h) <= 1e-12 * h;
+    }
+
+    /// Record an update of the Newton matrix for a step of size h.
+    void SetJacobianUpdated(double h, int nv, int nc) {
+        jacobian_valid = true;
+        jacobian_h = h;
+        jacobian_nv = nv;
+        jacobian_nc = nc;
+    }
+
+    /// Return the size of the next step (after a step of size h with error norm err and an error estimate of
+    /// order k, i.e. err = O(h^k)). Accepted steps use a PI controller; rejected steps are reduced based on err only.
+    double AdaptiveStepSize(double h, double err, int k, bool accepted);
 };
 
 /// Euler explicit timestepper.
@@ -365,14 +526,25 @@ class ChApi ChTimestepperEulerImplicit : public ChTimestepperIIorder, public ChI
     ChStateDelta Vnew;
     ChVectorDynamic<> R;
     ChVectorDynamic<> Qc;
+    double h_min;  ///< minimum allowable stepsize (adaptive step size control only)
 
   public:
     /// Constructors (default empty)
     ChTimestepperEulerImplicit(ChIntegrableIIorder* intgr = nullptr)
-        : ChTimestepperIIorder(intgr), ChImplicitIterativeTimestepper() {}
+        : ChTimestepperIIorder(intgr), ChImplicitIterativeTimestepper(), h_min(1e-10) {}
 
     virtual Type GetType() const override { return Type::EULER_IMPLICIT; }
 
+    /// Write the step size control data to a checkpoint.
+    virtual void CheckpointOUT(ChArchiveOut& archive) override { CheckpointStepControlOUT(archive); }
+
+    /// Read the step size control data from a checkpoint.
+    virtual void CheckpointIN(ChArchiveIn& archive) override { CheckpointStepControlIN(archive); }
+
+    /// Set the minimum step size (used only with adaptive step size control).
+    /// An exception is thrown if the internal step size decreases below this limit.
+    void SetMinStepSize(double min_step) { h_min = min_step; }
+
     /// Performs an integration timestep
     virtual void Advance(const double dt  ///< timestep to advance
                          ) override;
@@ -26,6 +26,8 @@ ChTimestepperHHT::ChTimestepperHHT(ChIntegrableIIorder* intgr)
       ChImplicitIterativeTimestepper(),
       mode(ACCELERATION),
       scaling(false),
+      Tjac(0),
+      restore_jacobians(false),
       step_control(true),
       maxiters_success(3),
       req_successful_steps(5),
@@ -33,9 +35,9 @@ ChTimestepperHHT::ChTimestepperHHT(ChIntegrableIIorder* intgr)
       step_decrease_factor(0.5),
       h_min(1e-10),
       h(1e6),
-      num_successful_steps(0),
-      modified_Newton(true) {
+      num_successful_steps(0) {
     SetAlpha(-0.2);  // default: some dissipation
+    jacobian_update = JacobianUpdate::EVERY_STEP;
 }
 
 void ChTimestepperHHT::SetAlpha(double malpha) {
@@ -77,16 +79,33 @@ void ChTimestepperHHT::Advance(const double dt) {
     mintegrable->StateGatherAcceleration(A);  // <- system
     mintegrable->StateGatherReactions(L);     // <- system
 
+    // After a restart from a checkpoint, evaluate the constraint Jacobians at the state of the last Newton iteration
+    // before the checkpoint. A continuous simulation uses these in the terms Cq'*L of the first residual of the step.
+    if (restore_jacobians) {
+        if (Xjac.size() == X.size() && Vjac.size() == V.size()) {
+            mintegrable->StateScatter(Xjac, Vjac, Tjac, false);
+            mintegrable->LoadConstraintJacobians();
+            mintegrable->StateScatter(X, V, T, false);
+        }
+        restore_jacobians = false;
+    }
+
     // Advance solution to time T+dt, possibly taking multiple steps
     double tfinal = T + dt;  // target final time
     numiters = 0;            // total number of NR iterations for this step
     numsetups = 0;
     numsolves = 0;
+    num_accepted = 0;
+    num_rejected = 0;
 
-    // If we had a streak of successful steps, consider a stepsize increase.
+    // With adaptive step size control, start from the stepsize proposed by the error controller.
+    // Otherwise, if we had a streak of successful steps, consider a stepsize increase.
     // Note that we never attempt a step larger than the specified dt value.
     // If step size control is disabled, always use h = dt.
-    if (!step_control) {
+    if (adaptive) {
+        h = (h_adapt > 0) ? ChMin(h_adapt, dt) : dt;
+        num_successful_steps = 0;
+    } else if (!step_control) {
         h = dt;
         num_successful_steps = 0;
     } else if (num_successful_steps >= req_successful_steps) {
@@ -102,25 +121,42 @@ void ChTimestepperHHT::Advance(const double dt) {
     }
 
     // Monitor flags controlling whther or not the Newton matrix must be updated.
-    // If using modified Newton, a matrix update occurs:
+    // If using modified Newton (EVERY_STEP), a matrix update occurs:
     //   - at the beginning of a step
     //   - on a stepsize decrease
+    // If reusing the Newton matrix across steps (AUTOMATIC), a matrix update occurs:
+    //   - if the stepsize or the problem size changed since the last update
+    //   - if the Newton iteration converges too slowly
     //   - if the Newton iteration does not converge with an out-of-date matrix
     // Otherwise, the matrix is updated at each iteration.
+    int nv = mintegrable->GetNcoords_v();
+    int nc = mintegrable->GetNconstr();
     matrix_is_current = false;
-    call_setup = true;
+    call_setup = (jacobian_update != JacobianUpdate::AUTOMATIC);
 
     // Loop until reaching final time
     while (true) {
+        // With adaptive step size control, do not step past the final time
+        bool truncated = false;
+        if (adaptive && T + h > tfinal) {
+            h = tfinal - T;
+            truncated = true;
+        }
+
+        if (jacobian_update == JacobianUpdate::AUTOMATIC && !CanReuseJacobian(h, nv, nc))
+            call_setup = true;
+
         double scaling_factor = scaling ? beta * h * h : 1;
         Prepare(mintegrable, scaling_factor);
 
         // Newton-Raphson for state at T+h
         bool converged = false;
+        bool fresh_matrix = false;  // was the Newton matrix updated during this step?
+        double Da_nrm_prev = 0;
         int it;
 
         for (it = 0; it < maxiters; it++) {
-            if (verbose && modified_Newton && call_setup)
+            if (verbose && jacobian_update != JacobianUpdate::EVERY_ITERATION && call_setup)
                 GetLog() << " HHT call Setup.\n";
 
             // Solve linear system and increment state
@@ -131,10 +167,25 @@ void ChTimestepperHHT::Advance(const double dt) {
             numsolves++;
             if (call_setup) {
                 numsetups++;
+                fresh_matrix = true;
+                SetJacobianUpdated(h, nv, nc);
             }
 
             // If using modified Newton, do not call Setup again
-            call_setup = !modified_Newton;
+            call_setup = (jacobian_update == JacobianUpdate::EVERY_ITERATION);
+
+            // If reusing a Newton matrix from a previous step, update it if the ratio of successive corrections is
+            // too large. The first correction of a step also absorbs the error of the predictor (even with an
+            // up-to-date matrix, the second correction is not much smaller), so the rate is monitored from the
+            // second correction on.
+            double Da_nrm = Da.norm();
+            if (jacobian_update == JacobianUpdate::AUTOMATIC && !fresh_matrix && it > 1 &&
+                Da_nrm > jacobian_max_rate * Da_nrm_prev) {
+                if (verbose)
+                    GetLog() << " HHT slow convergence (rate = " << Da_nrm / Da_nrm_prev << "), update matrix.\n";
+                call_setup = true;
+            }
+            Da_nrm_prev = Da_nrm;
 
             // A flag to indicate the trend of convergence
             if ((Rold.norm() < R.norm()) && (R.norm() > threshold_R)) {
@@ -154,8 +205,39 @@ void ChTimestepperHHT::Advance(const double dt) {
             convergence_trend_flag = false;
         }
 
+        // Local error test (adaptive step size control only).
+        // The local truncation error is estimated as the difference between the HHT solution and a third-order
+        // Taylor expansion of the positions (Zienkiewicz & Xie, 1991):
+        //    e = h^2 * (beta - 1/6) * (a_new - a_old)
+        bool rejected = false;
+        if (converged && adaptive) {
+            err_last = AdaptiveErrorNorm((Anew - A) * (h * h * (beta - 1.0 / 6.0)), Vnew * h);
+            rejected = err_last > 1;
+        }
 
-        if (converged) {
+
+        if (converged && rejected) {
+            // ------ NR converged but the local error test failed
+
+            num_rejected++;
+
+            // decrease stepsize based on the error estimate
+            h = AdaptiveStepSize(h, err_last, 3, false);
+            h_adapt = h;
+
+            if (verbose)
+                GetLog() << " ---HHT reject step (err = " << err_last << "), reduce stepsize to " << h << "\n";
+
+            if (h < h_min) {
+                if (verbose)
+                    GetLog() << " HHT at minimum stepsize. Exiting...\n";
+                throw ChException("HHT: Reached minimum allowable step size.");
+            }
+
+            // force a matrix re-evaluation (due to change in stepsize)
+            call_setup = true;
+
+        } else if (converged) {
             // ------ NR converged
 
             // if the number of iterations was low enough, increase the count of successive
@@ -182,22 +264,37 @@ void ChTimestepperHHT::Advance(const double dt) {
             A = Anew;
             L = Lnew;
 
-            /*
-            } else if (!matrix_is_current) {
-                // ------ NR did not converge but the matrix was out-of-date
+            // Propose the size of the next step. If the step was truncated to reach the final time,
+            // only allow the proposal to decrease.
+            if (adaptive) {
+                num_accepted++;
+                double h_new = AdaptiveStepSize(h, err_last, 3, true);
+                if (!truncated || h_new < h)
+                    h_adapt = h_new;
+                h = h_adapt;
 
-                // reset the count of successive successful steps
-                num_successful_steps = 0;
+                if (verbose)
+                    GetLog() << " HHT error estimate = " << err_last << "  next h = " << h << "\n";
 
-                // re-attempt step with updated matrix
-                if (verbose) {
-                    GetLog() << " HHT re-attempt step with updated matrix.\n";
-                }
+                // force a matrix re-evaluation (due to change in stepsize)
+                if (jacobian_update != JacobianUpdate::AUTOMATIC)
+                    call_setup = true;
+            }
 
-                call_setup = true;
-            */
+        } else if (!fresh_matrix) {
+            // ------ NR did not converge but the matrix was out-of-date (from a previous step)
+
+            // reset the count of successive successful steps
+            num_successful_steps = 0;
 
-        } else if (!step_control) {
+            // re-attempt step with updated matrix
+            if (verbose) {
+                GetLog() << " HHT re-attempt step with updated matrix.\n";
+            }
+
+            call_setup = true;
+
+        } else if (!step_control && !adaptive) {
             // ------ NR did not converge and we do not control stepsize
 
             // reset the count of successive successful steps
@@ -223,6 +320,8 @@ void ChTimestepperHHT::Advance(const double dt) {
 
             // decrease stepsize
             h *= step_decrease_factor;
+            if (adaptive)
+                h_adapt = h;
 
             if (verbose)
                 GetLog() << " ---HHT reduce stepsize to " << h << "\n";
@@ -266,7 +365,7 @@ void ChTimestepperHHT::Advance(const double dt) {
 void ChTimestepperHHT::Prepare(ChIntegrableIIorder* integrable, double scaling_factor) {
     switch (mode) {
         case ACCELERATION:
-            if (step_control)
+            if (step_control || adaptive)
                 Anew = A;
             Vnew = V + Anew * h;
             Xnew = X + Vnew * h + Anew * (h * h);
@@ -307,6 +406,7 @@ void ChTimestepperHHT::Prepare(ChIntegrableIIorder* integrable, double scaling_f
 void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling_factor) {
     // Scatter the current estimate of state at time T+h
     integrable->StateScatter(Xnew, Vnew, T + h, false);
+    Tjac = T + h;
 
     // Initialize the two segments of the RHS
     R = Rold;      // terms related to state at time T
@@ -331,6 +431,11 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
                                              call_setup          // call Setup?
             );
 
+            // Keep the state at which the constraint Jacobians were evaluated (for checkpoints). The new estimate is
+            // computed from scratch, so the storage of the vectors is just exchanged.
+            Xjac.swap(Xnew);
+            Vjac.swap(Vnew);
+
             // Update estimate of state at t+h
             Lnew += Dl;  // not -= Dl because we assume StateSolveCorrection flips sign of Dl
             Anew += Da;
@@ -357,6 +462,10 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
                                              call_setup          // call Setup?
             );
 
+            // Keep the state at which the constraint Jacobians were evaluated (see above)
+            Xjac.swap(Xnew);
+            Vjac.swap(Vnew);
+
             // Update estimate of state at t+h
             Lnew += Dl * (1.0 / scaling_factor);  // not -= Dl because we assume StateSolveCorrection flips sign of Dl
             Dx += Da;
@@ -471,4 +580,23 @@ void ChTimestepperHHT::ArchiveIN(ChArchiveIn& archive) {
     archive >> CHNVP(modemapper(mode), "mode");
 }
 
+void ChTimestepperHHT::CheckpointOUT(ChArchiveOut& archive) {
+    CheckpointStepControlOUT(archive);
+    archive << CHNVP(h);
+    archive << CHNVP(num_successful_steps);
+    archive << CHNVP(Xjac);
+    archive << CHNVP(Vjac);
+    archive << CHNVP(Tjac);
+}
+
+void ChTimestepperHHT::CheckpointIN(ChArchiveIn& archive) {
+    CheckpointStepControlIN(archive);
+    archive >> CHNVP(h);
+    archive >> CHNVP(num_successful_steps);
+    archive >> CHNVP(Xjac);
+    archive >> CHNVP(Vjac);
+    archive >> CHNVP(Tjac);
+    restore_jacobians = (Xjac.size() > 0);
+}
+
 }  // end namespace chrono
\ No newline at end of file
@@ -25,6 +25,9 @@ namespace chrono {
 /// Implementation of the HHT implicit integrator for II order systems.
 /// This timestepper allows use of an adaptive time-step, as well as optional use of a modified
 /// Newton scheme for the solution of the resulting nonlinear problem.
+/// Two forms of step size control are available: a heuristic one, driven only by the convergence of the Newton
+/// iteration (see SetStepControl), and an error-based one (see SetAdaptiveStepControl), which uses an estimate of
+/// the local truncation error and a PI controller to select the internal step size.
 class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIterativeTimestepper {
 
   public:
@@ -52,6 +55,11 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     ChVectorDynamic<> Rold;  ///< residual terms depending on previous state
     ChVectorDynamic<> Qc;    ///< residual of nonlinear system (constranints portion)
 
+    ChState Xjac;            ///< positions at which the constraint Jacobians were last evaluated
+    ChStateDelta Vjac;       ///< velocities at which the constraint Jacobians were last evaluated
+    double Tjac;             ///< time at which the constraint Jacobians were last evaluated
+    bool restore_jacobians;  ///< re-evaluate the constraint Jacobians at Xjac before the next step?
+
     bool step_control;            ///< step size control enabled?
     int maxiters_success;         ///< maximum number of NR iterations to declare a step successful
     int req_successful_steps;     ///< required number of successive successful steps for a stepsize increase
@@ -61,7 +69,6 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     double h;                     ///< internal stepsize
     int num_successful_steps;     ///< number of successful steps
 
-    bool modified_Newton;    ///< use modified Newton?
     bool matrix_is_current;  ///< is the Newton matrix up-to-date?
     bool call_setup;         ///< should the solver's Setup function be called?
 
@@ -119,7 +126,11 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     /// per step or if the Newton iteration does not converge with an out-of-date matrix.
     /// If disabled, the Newton matrix is evaluated at every iteration of the nonlinear solver.
     /// Modified Newton iteration is enabled by default.
-    void SetModifiedNewton(bool val) { modified_Newton = val; }
+    /// This is equivalent to setting the Jacobian update method to EVERY_STEP or EVERY_ITERATION, respectively
+    /// (see SetJacobianUpdateMethod, which also allows reusing the Newton matrix across steps).
+    void SetModifiedNewton(bool val) {
+        SetJacobianUpdateMethod(val ? JacobianUpdate::EVERY_STEP : JacobianUpdate::EVERY_ITERATION);
+    }
 
     /// Perform an integration timestep.
     virtual void Advance(const double dt  ///< timestep to advance
@@ -147,6 +158,16 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& archive) override;
 
+    /// Write the step size control data to a checkpoint, together with the state of the last Newton iteration.
+    /// The constraint Jacobians evaluated at that state enter the residual of the first iteration of the next step
+    /// (through the terms Cq'*L).
+    virtual void CheckpointOUT(ChArchiveOut& archive) override;
+
+    /// Read the step size control data from a checkpoint.
+    /// The constraint Jacobians are re-evaluated at the state of the last Newton iteration before the checkpoint at
+    /// the beginning of the next step, so that a restart continues exactly as the uninterrupted simulation.
+    virtual void CheckpointIN(ChArchiveIn& archive) override;
+
   private:
     void Prepare(ChIntegrableIIorder* integrable, double scaling_factor);
     void Increment(ChIntegrableIIorder* integrable, double scaling_factor);
@@ -20,6 +20,9 @@
 #ifndef CH_BENCHMARK_H
 #define CH_BENCHMARK_H
 
+#include <map>
+#include <string>
+
 #include "chrono_thirdparty/googlebenchmark/include/benchmark/benchmark.h"
 #include "chrono/physics/ChSystem.h"
 
@@ -31,6 +34,9 @@ namespace utils {
 /// GetSystem (to return a pointer to the underlying Chrono system) and ExecuteStep (to perform
 /// all operations required to advance the system state by one time step).
 /// Timing information for various phases of the simulation is collected for a sequence of steps.
+/// A derived class can collect additional timers (e.g., for operations not covered by the ChSystem timers) by
+/// overriding AccumulateTimers. All timers are reported as counters of the benchmark (in milliseconds), and are
+/// therefore included in the benchmark output (e.g., with --benchmark_out=<file> --benchmark_out_format=json).
 class ChBenchmarkTest {
   public:
     ChBenchmarkTest();
@@ -39,6 +45,10 @@ class ChBenchmarkTest {
     virtual void ExecuteStep() = 0;
     virtual ChSystem* GetSystem() = 0;
 
+    /// Accumulate additional timers (in seconds) for the last step, identified by name.
+    /// Called after each step.
+    virtual void AccumulateTimers(std::map<std::string, double>& timers) {}
+
     void Simulate(int num_steps);
     void ResetTimers();
 
@@ -52,6 +62,8 @@ class ChBenchmarkTest {
     double m_timer_collision_narrow;  ///< time for narrow-phase collision
     double m_timer_setup;             ///< time for system update
     double m_timer_update;            ///< time for system update
+
+    std::map<std::string, double> m_timers;  ///< additional timers (see AccumulateTimers)
 };
 
 inline ChBenchmarkTest::ChBenchmarkTest()
@@ -81,6 +93,7 @@ inline void ChBenchmarkTest::Simulate(int num_steps) {
         m_timer_collision_narrow += GetSystem()->GetTimerCollisionNarrow();
         m_timer_setup += GetSystem()->GetTimerSetup();
         m_timer_update += GetSystem()->GetTimerUpdate();
+        AccumulateTimers(m_timers);
     }
 }
 
@@ -95,6 +108,8 @@ inline void ChBenchmarkTest::ResetTimers() {
     m_timer_collision_narrow = 0;
     m_timer_setup = 0;
     m_timer_update = 0;
+    for (auto& timer : m_timers)
+        timer.second = 0;
 }
 
 // =============================================================================
@@ -168,6 +183,8 @@ class ChBenchmarkFixture : public ::benchmark::Fixture {
         st.counters["CD_Total"] = m_test->m_timer_collision * 1e3;
         st.counters["CD_Broad"] = m_test->m_timer_collision_broad * 1e3;
         st.counters["CD_Narrow"] = m_test->m_timer_collision_narrow * 1e3;
+        for (const auto& timer : m_test->m_timers)
+            st.counters[timer.first] = timer.second * 1e3;
     }
 
     void Reset(int num_init_steps) {
@@ -37,6 +37,9 @@ CODE MODIFIED FROM:
 #include <ratio>
 #include <chrono>
 #include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
 
 namespace chrono {
 namespace utils {
@@ -374,6 +377,155 @@ void	ChProfileManager::dumpAll()
 
 
 
+// -----------------------------------------------------------------------------
+// ChProfileTrace
+// -----------------------------------------------------------------------------
+
+// Ring buffer of events recorded by one thread
+struct ChProfileTrace::ThreadBuffer {
+    int id;
+    std::vector<Event> events;
+    size_t next;
+    size_t count;
+    int depth;
+};
+
+bool ChProfileTrace::enabled = false;
+
+static std::mutex gTraceMutex;
+static size_t gTraceCapacity = 1 << 16;
+static std::chrono::steady_clock::time_point gTraceEpoch = std::chrono::steady_clock::now();
+
+double ChProfileTrace::Now() {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - gTraceEpoch).count();
+}
+
+// Thread buffers are never deallocated, so that the pointers cached by each thread remain valid
+std::vector<std::unique_ptr<ChProfileTrace::ThreadBuffer>>& ChProfileTrace::GetBuffers() {
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    return buffers;
+}
+
+ChProfileTrace::ThreadBuffer* ChProfileTrace::GetThreadBuffer() {
+    static thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(gTraceMutex);
+        auto new_buffer = std::unique_ptr<ThreadBuffer>(new ThreadBuffer);
+        new_buffer->id = (int)GetBuffers().size();
+        new_buffer->events.resize(gTraceCapacity);
+        new_buffer->next = 0;
+        new_buffer->count = 0;
+        new_buffer->depth = 0;
+        buffer = new_buffer.get();
+        GetBuffers().push_back(std::move(new_buffer));
+    }
+    return buffer;
+}
+
+void ChProfileTrace::Enable(size_t capacity) {
+    gTraceCapacity = capacity > 0 ? capacity : 1;
+    for (auto& buffer : GetBuffers())
+        buffer->events.resize(gTraceCapacity);
+    Clear();
+    gTraceEpoch = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+void ChProfileTrace::Disable() {
+    enabled = false;
+}
+
+void ChProfileTrace::Clear() {
+    for (auto& buffer : GetBuffers()) {
+        buffer->next = 0;
+        buffer->count = 0;
+    }
+}
+
+int ChProfileTrace::GetNumThreads() {
+    int num_threads = 0;
+    for (const auto& buffer : GetBuffers()) {
+        if (buffer->count > 0)
+            num_threads = buffer->id + 1;
+    }
+    return num_threads;
+}
+
+std::vector<ChProfileTrace::Event> ChProfileTrace::GetEvents(int thread) {
+    std::vector<Event> events;
+    if (thread < 0 || thread >= (int)GetBuffers().size())
+        return events;
+
+    const auto& buffer = GetBuffers()[thread];
+    size_t capacity = buffer->events.size();
+    size_t first = (buffer->next + capacity - buffer->count) % capacity;
+    events.reserve(buffer->count);
+    for (size_t i = 0; i < buffer->count; i++)
+        events.push_back(buffer->events[(first + i) % capacity]);
+
+    return events;
+}
+
+std::map<std::string, ChProfileTrace::ZoneStatistics> ChProfileTrace::GetStatistics() {
+    std::map<std::string, ZoneStatistics> stats;
+    for (int thread = 0; thread < (int)GetBuffers().size(); thread++) {
+        for (const auto& e : GetEvents(thread)) {
+            auto& s = stats.emplace(e.name, ZoneStatistics{0, 0, 0}).first->second;
+            s.calls++;
+            s.total += e.duration;
+            if (e.duration > s.max)
+                s.max = e.duration;
+        }
+    }
+    return stats;
+}
+
+bool ChProfileTrace::WriteChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    for (int thread = 0; thread < (int)GetBuffers().size(); thread++) {
+        for (const auto& e : GetEvents(thread)) {
+            file << (first ? "\n" : ",\n");
+            file << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"ts\":" << e.start << ",\"dur\":" << e.duration
+                 << ",\"pid\":0,\"tid\":" << thread << "}";
+            first = false;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.good();
+}
+
+void ChProfileZone::Begin(const char* zone_name) {
+    buffer = ChProfileTrace::GetThreadBuffer();
+    name = zone_name;
+    depth = buffer->depth++;
+    start = ChProfileTrace::Now();
+}
+
+void ChProfileZone::End() {
+    double end = ChProfileTrace::Now();
+    buffer->depth--;
+
+    // Zones still open when recording is disabled or the buffers are resized are dropped
+    if (!ChProfileTrace::IsEnabled() || buffer->events.empty())
+        return;
+
+    auto& e = buffer->events[buffer->next];
+    e.name = name;
+    e.start = start;
+    e.duration = end - start;
+    e.depth = depth;
+    buffer->next = (buffer->next + 1) % buffer->events.size();
+    if (buffer->count < buffer->events.size())
+        buffer->count++;
+}
 
 #endif //CH_NO_PROFILE
 
@@ -45,6 +45,10 @@ CODE MODIFIED FROM:
 #include <ctime>
 #include <ratio>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include "chrono/core/ChApiCE.h"
 
 namespace chrono {
@@ -172,16 +176,124 @@ public:
 };
 
 
+/// Thread-aware recorder of timed zones (see ChProfileZone and the CH_PROFILE_ZONE macro).
+/// When enabled, each thread records the zones it executes in its own ring buffer, so that the most recent events
+/// are always available, and recording does not require synchronization between threads. The recorded events can be
+/// exported in the Chrome trace event format (viewable in chrome://tracing or Perfetto) or summarized per zone.
+/// Enable, Disable, Clear, and the functions accessing the recorded events must not be called while other threads
+/// are recording (i.e., call them in between simulation steps).
+class ChApi ChProfileTrace {
+  public:
+    /// Event recorded for a zone.
+    struct Event {
+        const char* name;  ///< zone name (must remain valid, e.g. a string literal)
+        double start;      ///< start time, in microseconds since the trace was enabled
+        double duration;   ///< duration, in microseconds
+        int depth;         ///< nesting level of the zone in its thread
+    };
+
+    /// Statistics for all events with the same zone name.
+    struct ZoneStatistics {
+        int calls;     ///< number of recorded events
+        double total;  ///< total duration (microseconds)
+        double max;    ///< maximum duration (microseconds)
+    };
+
+    /// Enable recording, with given capacity (number of events) of the ring buffer of each thread.
+    /// Any previously recorded events are discarded.
+    static void Enable(size_t capacity = 1 << 16);
+
+    /// Disable recording. Recorded events are kept.
+    static void Disable();
+
+    /// Return true if recording is enabled.
+    static bool IsEnabled() { return enabled; }
+
+    /// Discard all recorded events.
+    static void Clear();
+
+    /// Return the number of threads which recorded events.
+    static int GetNumThreads();
+
+    /// Return the events recorded by the specified thread, in the order in which zones were closed.
+    /// If more events than the buffer capacity were recorded, only the most recent ones are returned.
+    static std::vector<Event> GetEvents(int thread);
+
+    /// Return statistics of the recorded events, for each zone name.
+    static std::map<std::string, ZoneStatistics> GetStatistics();
+
+    /// Write the recorded events to a file in the Chrome trace event format (JSON).
+    /// Returns false if the file cannot be written.
+    static bool WriteChromeTrace(const std::string& filename);
+
+  private:
+    struct ThreadBuffer;
+
+    static std::vector<std::unique_ptr<ThreadBuffer>>& GetBuffers();
+    static ThreadBuffer* GetThreadBuffer();
+    static double Now();
+
+    static bool enabled;
+
+    friend class ChProfileZone;
+};
+
+/// Scoped zone recorded by ChProfileTrace. The zone starts at construction and ends at destruction.
+/// If recording is disabled, the overhead is limited to one test.
+/// Unlike CProfileSample, this can be used from multiple threads.
+class ChApi ChProfileZone {
+  public:
+    ChProfileZone(const char* name) : buffer(nullptr) {
+        if (ChProfileTrace::IsEnabled())
+            Begin(name);
+    }
+
+    ~ChProfileZone() {
+        if (buffer)
+            End();
+    }
+
+  private:
+    void Begin(const char* name);
+    void End();
+
+    ChProfileTrace::ThreadBuffer* buffer;
+    const char* name;
+    double start;
+    int depth;
+};
+
+/// Scope profiled both in the profile tree of ChProfileManager (see CProfileSample) and in the ChProfileTrace
+/// recorder (see ChProfileZone). Used by the CH_PROFILE macro.
+class ChApi ChProfileScope {
+  public:
+    ChProfileScope(const char* name) : sample(name), zone(name) {}
+
+  private:
+    CProfileSample sample;
+    ChProfileZone zone;
+};
 
 }  // end namespace utils
 }  // end namespace chrono
 
+#define CH_PROFILE_ZONE_CONCAT_(a, b) a##b
+#define CH_PROFILE_ZONE_CONCAT(a, b) CH_PROFILE_ZONE_CONCAT_(a, b)
+
+/// Record a zone with given name (must be a string literal), from this point to the end of the current scope.
+/// Zone names have the form Module_action (e.g. "Collision_broadphase", "Solver_setup"), so that traces group by prefix.
+/// Can be used in code executed by multiple threads.
+#define CH_PROFILE_ZONE(name) \
+    chrono::utils::ChProfileZone CH_PROFILE_ZONE_CONCAT(__ch_profile_zone, __LINE__)(name)
 
-#define	CH_PROFILE( name )			chrono::utils::CProfileSample __ch_profile( name )
+/// Profile the current scope, both in the profile tree of ChProfileManager and in the ChProfileTrace recorder.
+/// Can only be used in code executed by a single thread.
+#define	CH_PROFILE( name )			chrono::utils::ChProfileScope __ch_profile( name )
 
 #else
 
 #define	CH_PROFILE( name )
+#define CH_PROFILE_ZONE(name)
 
 #endif //#ifndef CH_NO_PROFILE
 
@@ -26,6 +26,7 @@
 #include "chrono/assets/ChSphereShape.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
 #include "chrono/geometry/ChLineBezier.h"
+#include "chrono/serialization/ChArchiveBinary.h"
 #include "chrono/utils/ChUtilsInputOutput.h"
 
 namespace chrono {
@@ -294,6 +295,42 @@ void ReadCheckpoint(ChSystem* system, const std::string& filename) {
     }
 }
 
+// -----------------------------------------------------------------------------
+// WriteCheckpointBinary
+//
+// Write a binary file with a checkpoint of the state of the given system.
+// -----------------------------------------------------------------------------
+bool WriteCheckpointBinary(ChSystem* system, const std::string& filename) {
+    try {
+        ChStreamOutBinaryFile ostream(filename.c_str());
+        ChArchiveOutBinary archive(ostream);
+        system->CheckpointOUT(archive);
+    } catch (const ChException& e) {
+        std::cout << "utils::WriteCheckpointBinary ERROR: " << e.what() << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// ReadCheckpointBinary
+//
+// Restore the state of the given system from a binary checkpoint file.
+// -----------------------------------------------------------------------------
+bool ReadCheckpointBinary(ChSystem* system, const std::string& filename) {
+    try {
+        ChStreamInBinaryFile istream(filename.c_str());
+        ChArchiveInBinary archive(istream);
+        system->CheckpointIN(archive);
+    } catch (const ChException& e) {
+        std::cout << "utils::ReadCheckpointBinary ERROR: " << e.what() << "\n";
+        return false;
+    }
+
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 // Write CSV output file with current camera information
 // -----------------------------------------------------------------------------
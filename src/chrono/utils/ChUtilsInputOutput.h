@@ -25,6 +25,10 @@
 //      contact geometry.
 //    - only a subset of contact shapes are currently supported
 //
+// WriteCheckpointBinary and ReadCheckpointBinary
+//  these functions write and read, respectively, a binary checkpoint file with
+//  the full state of an existing system, allowing a restart.
+//
 // WriteVisualizationAssets
 //  this function writes a CSV file appropriate for processing with a POV-Ray
 //  script.
@@ -143,6 +147,15 @@ ChApi bool WriteCheckpoint(ChSystem* system, const std::string& filename);
 /// Read a CSV file with a checkpoint.
 ChApi void ReadCheckpoint(ChSystem* system, const std::string& filename);
 
+/// Write a binary file with a checkpoint of the system state (see ChSystem::CheckpointOUT).
+/// Unlike WriteCheckpoint, this does not allow recreating the bodies; the system must be reconstructed by the
+/// caller before restarting with ReadCheckpointBinary. Returns false if the file cannot be written.
+ChApi bool WriteCheckpointBinary(ChSystem* system, const std::string& filename);
+
+/// Restore the system state from a binary checkpoint file (see ChSystem::CheckpointIN).
+/// Returns false if the file cannot be read or is inconsistent with the given system.
+ChApi bool ReadCheckpointBinary(ChSystem* system, const std::string& filename);
+
 /// Write CSV output file with camera information for off-line visualization.
 /// The output file includes three vectors, one per line, for camera position, camera target (look-at point), and camera
 /// up vector, respectively.
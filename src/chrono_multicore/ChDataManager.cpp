@@ -39,6 +39,7 @@ ChMulticoreDataManager::ChMulticoreDataManager()
       num_rotmotors(0),
       num_dof(0),
       nnz_bilaterals(0),
+      matrix_free_contacts(false),
       add_contact_callback(nullptr),
       composition_strategy(new ChMaterialCompositionStrategy) {
     node_container = chrono_types::make_shared<Ch3DOFContainer>();
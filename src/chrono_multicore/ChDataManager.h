@@ -265,6 +265,14 @@ struct host_container {
     /// Keeps track of active bilateral constraints.
     custom_vector<int> bilateral_mapping;
 
+    /// Flat storage of the Jacobians of active bilateral constraints.
+    /// The entries for the active constraint with index i are stored, in increasing order of the column index, at
+    /// positions bilateral_jac_start[i] to bilateral_jac_start[i+1]-1 in bilateral_jac_col and bilateral_jac_val.
+    custom_vector<int> bilateral_jac_start;
+    custom_vector<int> bilateral_jac_col;   ///< column indices of bilateral Jacobian entries
+    custom_vector<real> bilateral_jac_val;  ///< values of bilateral Jacobian entries
+    custom_vector<real> bilateral_b;        ///< right-hand side terms of active bilateral constraints
+
     // Shaft data
     custom_vector<real> shaft_rot;     ///< shaft rotation angles
     custom_vector<real> shaft_inr;     ///< shaft inverse inertias
@@ -358,6 +366,9 @@ class CH_MULTICORE_API ChMulticoreDataManager {
 
     /// Flag indicating whether or not the contact forces are current (NSC only).
     bool Fc_current;
+    /// Flag indicating whether the rigid contact Jacobian is applied in matrix-free form (NSC only).
+    /// Set at each step based on the solver settings (see solver_settings::matrix_free).
+    bool matrix_free_contacts;
     /// Container for all timers for the system.
     ChTimerMulticore system_timer;
     /// Container for all settings for the system, collision detection, and solver.
@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Description: NUMA-aware placement of host arrays and OpenMP thread pinning
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "chrono_multicore/ChNUMAPlacement.h"
+
+namespace chrono {
+
+bool ChNUMAPlacement::Place(const void* key, void* data, size_t capacity, size_t element_size, int nthreads) {
+    if (capacity == 0)
+        return false;
+
+    auto& placed = m_placed[key];
+    if (placed.data == data && placed.capacity == capacity && placed.nthreads == nthreads)
+        return false;
+    placed.data = data;
+    placed.capacity = capacity;
+    placed.nthreads = nthreads;
+
+#ifdef __linux__
+    // Only whole memory pages within the array can be released
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)data;
+    uintptr_t stop = start + capacity * element_size;
+    uintptr_t begin = (start + page - 1) & ~(page - 1);
+    uintptr_t end = stop & ~(page - 1);
+    if (end <= begin)
+        return false;
+
+    // Save the contents and release the pages (subsequent accesses map new zero-filled pages)
+    std::vector<char> contents((char*)begin, (char*)end);
+    if (madvise((void*)begin, end - begin, MADV_DONTNEED) != 0)
+        return false;
+
+    // Restore the contents with the same static schedule (and number of threads) used by the parallel loops over the
+    // array elements. Each page is first touched by the thread processing its elements.
+    char* base = (char*)data;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (long long i = 0; i < (long long)capacity; i++) {
+        uintptr_t a = std::max((uintptr_t)(base + i * element_size), begin);
+        uintptr_t b = std::min((uintptr_t)(base + (i + 1) * element_size), end);
+        if (a < b)
+            std::memcpy((void*)a, contents.data() + (a - begin), b - a);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if defined(__linux__) && defined(_OPENMP)
+// Processors available to the process before any thread was pinned.
+static cpu_set_t process_mask;
+static std::vector<int> process_cpus;
+
+static bool SaveProcessMask() {
+    if (!process_cpus.empty())
+        return true;
+    CPU_ZERO(&process_mask);
+    if (sched_getaffinity(0, sizeof(process_mask), &process_mask) != 0)
+        return false;
+    for (int i = 0; i < CPU_SETSIZE; i++) {
+        if (CPU_ISSET(i, &process_mask))
+            process_cpus.push_back(i);
+    }
+    return !process_cpus.empty();
+}
+#endif
+
+bool ChNUMAPlacement::PinThreads(int nthreads) {
+#if defined(__linux__) && defined(_OPENMP)
+    if (!SaveProcessMask())
+        return false;
+
+    bool success = true;
+#pragma omp parallel num_threads(nthreads) reduction(&& : success)
+    {
+        int id = omp_get_thread_num();
+        if (id > 0) {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            CPU_SET(process_cpus[id % process_cpus.size()], &mask);
+            success = (sched_setaffinity(0, sizeof(mask), &mask) == 0);
+        }
+    }
+    return success;
+#else
+    return false;
+#endif
+}
+
+bool ChNUMAPlacement::UnpinThreads(int nthreads) {
+#if defined(__linux__) && defined(_OPENMP)
+    if (process_cpus.empty())
+        return true;
+
+    bool success = true;
+#pragma omp parallel num_threads(nthreads) reduction(&& : success)
+    { success = (sched_setaffinity(0, sizeof(process_mask), &process_mask) == 0); }
+    return success;
+#else
+    return false;
+#endif
+}
+
+}  // end namespace chrono
@@ -0,0 +1,84 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Description: NUMA-aware placement of host arrays and OpenMP thread pinning
+//
+// =============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono_multicore/ChApiMulticore.h"
+
+namespace chrono {
+
+/// @addtogroup multicore_module
+/// @{
+
+/// Utility class for NUMA-aware placement of the memory of host arrays.
+/// Arrays are allocated (and initialized) by the thread that resizes them, so that all their memory pages end up on
+/// the NUMA node of that thread. Placing an array releases its memory pages and touches them again from within an
+/// OpenMP loop with static schedule over the array elements, executed with the number of threads of the parallel loops
+/// which later process the array. This way, each page is allocated on the node of the thread which processes the
+/// corresponding elements. Array contents are preserved.
+/// The whole allocated storage of an array (its capacity) is placed, so that elements added later without
+/// reallocation are already on the node of the thread processing them. An array is placed again only if its storage
+/// was reallocated (new data pointer or capacity) or the number of threads changed since the last placement; it is
+/// not placed again if it only shrinks or grows within its capacity (as contact arrays do at every step).
+/// Placement relies on first-touch page allocation and is only performed on Linux; elsewhere it is a no-op.
+class CH_MULTICORE_API ChNUMAPlacement {
+  public:
+    ChNUMAPlacement() {}
+
+    /// Place the memory of the given vector for processing with 'nthreads' OpenMP threads, if needed.
+    /// The vector storage is saved and restored bytewise. Return true if the vector was placed.
+    template <typename T>
+    bool Place(std::vector<T>& v, int nthreads) {
+        return Place(&v, v.data(), v.capacity(), sizeof(T), nthreads);
+    }
+
+    /// Place the memory of an array with storage for 'capacity' elements of 'element_size' bytes, identified by 'key',
+    /// for processing with 'nthreads' OpenMP threads. The array is placed if this is the first call for 'key' or if
+    /// 'data', 'capacity', or 'nthreads' changed since the last call. Return true if the array was placed.
+    bool Place(const void* key, void* data, size_t capacity, size_t element_size, int nthreads);
+
+    /// Forget all placed arrays, so that all are placed again at the next call.
+    void Reset() { m_placed.clear(); }
+
+    /// Bind each of the OpenMP worker threads 1, ..., 'nthreads'-1 to one processor, in the order of the processors
+    /// available to the process at the first call. The calling (master) thread is not pinned, so that threads it
+    /// creates later do not inherit a single-processor affinity. Return false if thread pinning is not supported.
+    static bool PinThreads(int nthreads);
+
+    /// Restore the affinity of the OpenMP threads of a team of 'nthreads' to the processors available to the process
+    /// before the first call to PinThreads. Return false if thread pinning is not supported.
+    static bool UnpinThreads(int nthreads);
+
+  private:
+    /// Placement parameters of an array.
+    struct Placement {
+        const void* data;  ///< data pointer
+        size_t capacity;   ///< number of elements for which storage is allocated
+        int nthreads;      ///< number of threads
+    };
+
+    std::unordered_map<const void*, Placement> m_placed;  ///< parameters at last placement, for each array
+};
+
+/// @} multicore_module
+
+}  // end namespace chrono
@@ -102,6 +102,8 @@ class solver_settings {
         bilateral_clamp_speed = .6;
         clamp_bilaterals = true;
         compute_N = false;
+        matrix_free = false;
+        mixed_precision = false;
         use_full_inertia_tensor = true;
         max_iteration = 100;
         max_iteration_normal = 0;
@@ -162,6 +164,26 @@ class solver_settings {
     bool update_rhs;
     bool compute_N;
     bool test_objective;
+    /// Apply the rigid contact Jacobian in matrix-free form (NSC only, default: false).
+    /// If enabled, the rigid contact rows of D_T (and M_invD) are not assembled at each step; instead, the products
+    /// with D, D_T, and the Schur complement D_T*M_inv*D are evaluated directly from the contact normals, contact
+    /// points, and body indices. This reduces the memory traffic and the setup cost for large numbers of contacts.
+    /// Bilateral and 3-DOF constraints are always assembled. This option is ignored with the JACOBI and GAUSS_SEIDEL
+    /// solvers and if compute_N or update_rhs is set, as these require the assembled contact Jacobian.
+    bool matrix_free;
+    /// Evaluate the Schur complement products in single precision (NSC only, default: false).
+    /// If enabled, single precision copies of the assembled matrices (D_T and M_invD, or N if compute_N is set) are
+    /// created at each step and used in the products which determine the search direction of the iterative solver,
+    /// which halves their memory traffic. The copies are kept in addition to the matrices in the precision of 'real',
+    /// increasing the memory used by these matrices by half. The multipliers, the right-hand side, and the velocity
+    /// update are still computed in the precision of 'real'. With the APGD solvers, the products entering the
+    /// objective function at the new iterate and the residual are also computed in the precision of 'real', so that
+    /// the residual tolerance remains meaningful; the other solvers use a single product per iteration for both the
+    /// search direction and the residual, so their residual is only accurate to single precision and tolerances
+    /// below it (relative to the magnitude of the multipliers) may not be reached. This option is ignored if the
+    /// contact Jacobian is applied in matrix-free form (see matrix_free) and only affects iterations on the full set
+    /// of constraints.
+    bool mixed_precision;
     bool use_full_inertia_tensor;
     bool cache_step_length;
     bool precondition;
@@ -226,6 +248,9 @@ class settings_container {
         max_threads = 1;
 #endif
         perform_thread_tuning = false;
+        perform_phase_tuning = false;
+        pin_threads = false;
+        numa_placement = false;
         system_type = SystemType::SYSTEM_NSC;
         step_size = 0.01;
     }
@@ -238,6 +263,9 @@ class settings_container {
 
   private:
     bool perform_thread_tuning;  ///< dynamically tune number of threads
+    bool perform_phase_tuning;   ///< dynamically tune number of threads separately for each phase
+    bool pin_threads;            ///< bind OpenMP threads to processors
+    bool numa_placement;         ///< NUMA-aware placement of body and contact arrays
     int min_threads;             ///< lower bound for number of threads (if dynamic tuning)
     int max_threads;             ///< maximum bound for number of threads (if dynamic tuning)
     SystemType system_type;      ///< system type (NSC or SMC)
@@ -0,0 +1,172 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Description: per-phase tuning of the number of OpenMP threads
+//
+// =============================================================================
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "chrono_multicore/ChThreadTuner.h"
+
+namespace chrono {
+
+static const char* phase_names[ChThreadTuner::NUM_PHASES] = {"update", "broadphase", "narrowphase", "schur_product"};
+
+ChThreadTuner::ChThreadTuner() : m_num_samples(10) {
+    m_candidates.push_back(1);
+    for (int i = 0; i < NUM_PHASES; i++) {
+        m_data[i].candidate = 0;
+        m_data[i].warmup = 0;
+        m_data[i].samples = 0;
+        m_data[i].total = 0;
+        m_data[i].best_time = 0;
+        m_data[i].best_threads = 1;
+        m_data[i].tuned = true;
+        m_current[i] = 1;
+    }
+}
+
+void ChThreadTuner::Initialize(int min_threads, int max_threads, int num_samples) {
+    min_threads = std::max(min_threads, 1);
+    max_threads = std::max(max_threads, min_threads);
+    m_num_samples = std::max(num_samples, 1);
+
+    // Candidates: lower limit, powers of 2 in between, upper limit
+    m_candidates.clear();
+    m_candidates.push_back(min_threads);
+    int n = 1;
+    while (n <= min_threads)
+        n *= 2;
+    for (; n < max_threads; n *= 2)
+        m_candidates.push_back(n);
+    if (max_threads > min_threads)
+        m_candidates.push_back(max_threads);
+
+    for (int i = 0; i < NUM_PHASES; i++) {
+        m_data[i].candidate = 0;
+        m_data[i].warmup = 1;
+        m_data[i].samples = 0;
+        m_data[i].total = 0;
+        m_data[i].best_time = std::numeric_limits<double>::max();
+        m_data[i].best_threads = min_threads;
+        m_data[i].tuned = false;
+        m_current[i] = m_candidates[0];
+    }
+}
+
+bool ChThreadTuner::IsTuned() const {
+    for (int i = 0; i < NUM_PHASES; i++) {
+        if (!m_data[i].tuned)
+            return false;
+    }
+    return true;
+}
+
+void ChThreadTuner::AddSample(Phase phase, double time) {
+    PhaseData& data = m_data[phase];
+    if (data.tuned)
+        return;
+
+    // Discard the first sample after a change in thread count (thread pool resizing, cache warm-up)
+    if (data.warmup > 0) {
+        data.warmup--;
+        return;
+    }
+
+    data.total += time;
+    if (++data.samples < m_num_samples)
+        return;
+
+    double average = data.total / data.samples;
+    if (average < data.best_time) {
+        data.best_time = average;
+        data.best_threads = m_candidates[data.candidate];
+    }
+
+    data.candidate++;
+    data.warmup = 1;
+    data.samples = 0;
+    data.total = 0;
+
+    if (data.candidate < m_candidates.size()) {
+        m_current[phase] = m_candidates[data.candidate];
+    } else {
+        data.tuned = true;
+        m_current[phase] = data.best_threads;
+    }
+}
+
+bool ChThreadTuner::WriteProfile(const std::string& filename) const {
+    if (!IsTuned())
+        return false;
+
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << "# Chrono::Multicore thread profile (phase, number of threads)" << std::endl;
+    for (int i = 0; i < NUM_PHASES; i++) {
+        file << phase_names[i] << " " << m_current[i] << std::endl;
+    }
+
+    return file.good();
+}
+
+bool ChThreadTuner::ReadProfile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    int threads[NUM_PHASES];
+    bool found[NUM_PHASES] = {false};
+
+    std::string name;
+    while (file >> name) {
+        if (name[0] == '#') {
+            file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            continue;
+        }
+        int n;
+        if (!(file >> n) || n < 1)
+            return false;
+        for (int i = 0; i < NUM_PHASES; i++) {
+            if (name == phase_names[i]) {
+                threads[i] = n;
+                found[i] = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < NUM_PHASES; i++) {
+        if (!found[i])
+            return false;
+    }
+
+    for (int i = 0; i < NUM_PHASES; i++) {
+        m_data[i].tuned = true;
+        m_data[i].best_threads = threads[i];
+        m_current[i] = threads[i];
+    }
+
+    return true;
+}
+
+const char* ChThreadTuner::GetPhaseName(Phase phase) {
+    return phase_names[phase];
+}
+
+}  // end namespace chrono
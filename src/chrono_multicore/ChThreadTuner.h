@@ -0,0 +1,93 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Description: per-phase tuning of the number of OpenMP threads
+//
+// =============================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "chrono_multicore/ChApiMulticore.h"
+
+namespace chrono {
+
+/// @addtogroup multicore_module
+/// @{
+
+/// Utility class for selecting a separate number of OpenMP threads for each phase of a Chrono::Multicore step.
+/// For each phase, the candidate thread counts (powers of 2 between the specified limits, plus the upper limit) are
+/// tried in turn, each for a given number of steps. The time per phase is averaged over these steps and the fastest
+/// candidate is retained. A tuned profile can be saved to a file and loaded in a subsequent run to skip tuning.
+class CH_MULTICORE_API ChThreadTuner {
+  public:
+    /// Phases of a step with a separately tuned number of threads.
+    enum Phase {
+        UPDATE,         ///< body and constraint updates
+        BROADPHASE,     ///< collision detection broadphase
+        NARROWPHASE,    ///< collision detection narrowphase
+        SCHUR_PRODUCT,  ///< solver phase (measured by the Schur product time, if available)
+        NUM_PHASES
+    };
+
+    ChThreadTuner();
+
+    /// Start tuning all phases with thread counts between the specified limits.
+    /// Each candidate is timed over 'num_samples' steps, after one discarded warm-up step.
+    void Initialize(int min_threads, int max_threads, int num_samples = 10);
+
+    /// Return true if a thread count was selected for all phases.
+    bool IsTuned() const;
+
+    /// Return the number of threads to use for the specified phase.
+    /// During tuning, this is the candidate currently being timed.
+    int GetNumThreads(Phase phase) const { return m_current[phase]; }
+
+    /// Record the time (in seconds) spent in the specified phase during the last step.
+    /// When all samples for the current candidate were collected, advance to the next candidate.
+    void AddSample(Phase phase, double time);
+
+    /// Write the tuned profile to the specified file.
+    /// Return false if not all phases were tuned or if the file could not be written.
+    bool WriteProfile(const std::string& filename) const;
+
+    /// Load a tuned profile from the specified file.
+    /// Return false (and leave the tuner unchanged) if the file could not be read or is incomplete.
+    bool ReadProfile(const std::string& filename);
+
+    /// Return the name of the specified phase (as used in profile files).
+    static const char* GetPhaseName(Phase phase);
+
+  private:
+    struct PhaseData {
+        size_t candidate;   ///< index of the candidate currently timed
+        int warmup;         ///< number of samples left to discard for the current candidate
+        int samples;        ///< number of samples collected for the current candidate
+        double total;       ///< accumulated time for the current candidate
+        double best_time;   ///< best average time so far
+        int best_threads;   ///< thread count with the best average time
+        bool tuned;         ///< true if tuning of this phase completed
+    };
+
+    std::vector<int> m_candidates;  ///< candidate thread counts
+    int m_num_samples;              ///< number of timed samples per candidate
+    PhaseData m_data[NUM_PHASES];   ///< tuning state for each phase
+    int m_current[NUM_PHASES];      ///< thread count currently in effect for each phase
+};
+
+/// @} multicore_module
+
+}  // end namespace chrono
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 #include "chrono_multicore/ChConfigMulticore.h"
 #include "chrono_multicore/constraints/ChConstraintRigidRigid.h"
@@ -221,6 +222,27 @@ void ChConstraintRigidRigid::Setup(ChMulticoreDataManager* dm) {
             quat_b[i] = quaternion_conjugate;
         }
     }
+
+    if (data_manager->matrix_free_contacts) {
+        // Collect the contacts of each body (counting sort on the body IDs), in increasing order of contact index
+        const auto num_rigid_bodies = data_manager->num_rigid_bodies;
+        body_contacts_start.assign(num_rigid_bodies + 1, 0);
+        body_contacts.resize(2 * num_rigid_contacts);
+
+        for (int i = 0; i < (signed)num_rigid_contacts; i++) {
+            body_contacts_start[bids[i].x + 1]++;
+            body_contacts_start[bids[i].y + 1]++;
+        }
+        for (int i = 0; i < (signed)num_rigid_bodies; i++) {
+            body_contacts_start[i + 1] += body_contacts_start[i];
+        }
+
+        std::vector<int> next(body_contacts_start.begin(), body_contacts_start.end() - 1);
+        for (int i = 0; i < (signed)num_rigid_contacts; i++) {
+            body_contacts[next[bids[i].x]++] = 2 * i + 0;
+            body_contacts[next[bids[i].y]++] = 2 * i + 1;
+        }
+    }
 }
 
 void ChConstraintRigidRigid::Project(real* gamma) {
@@ -397,6 +419,10 @@ void ChConstraintRigidRigid::Build_E() {
 }
 
 void ChConstraintRigidRigid::Build_D() {
+    if (data_manager->matrix_free_contacts) {
+        return;
+    }
+
     const auto num_rigid_contacts = data_manager->cd_data->num_rigid_contacts;
     real3* norm = data_manager->cd_data->norm_rigid_rigid.data();
     vec2* ids = data_manager->cd_data->bids_rigid_rigid.data();
@@ -475,6 +501,14 @@ void ChConstraintRigidRigid::GenerateSparsity() {
 
     CompressedMatrix<real>& D_T = data_manager->host_data.D_T;
 
+    // In matrix-free mode, only finalize the (empty) contact rows
+    if (data_manager->matrix_free_contacts) {
+        for (int row = 0; row < (signed)data_manager->num_unilaterals; row++) {
+            D_T.finalize(row);
+        }
+        return;
+    }
+
     const vec2* ids = data_manager->cd_data->bids_rigid_rigid.data();
 
     for (int index = 0; index < (signed)num_rigid_contacts; index++) {
@@ -544,152 +578,119 @@ void ChConstraintRigidRigid::GenerateSparsity() {
     }
 }
 
-void ChConstraintRigidRigid::Dx(const DynamicVector<real>& gam, DynamicVector<real>& XYZUVW) {
+void ChConstraintRigidRigid::Dx(const DynamicVector<real>& gamma, DynamicVector<real>& XYZUVW, SolverMode mode) {
     const auto num_rigid_contacts = data_manager->cd_data->num_rigid_contacts;
-    real3* norm = data_manager->cd_data->norm_rigid_rigid.data();
-    ////custom_vector<char>& active_rigid = data_manager->host_data.active_rigid;
-    ////vec2* bids_rigid_rigid = data_manager->host_data.bids_rigid_rigid.data();
+    const auto num_rigid_bodies = data_manager->num_rigid_bodies;
+
+    if (num_rigid_contacts <= 0 || mode == SolverMode::BILATERAL) {
+        return;
+    }
 
+    const real3* norm = data_manager->cd_data->norm_rigid_rigid.data();
+
+    // Loop over bodies and gather the contributions of all their contacts (no concurrent writes)
 #pragma omp parallel for
-    for (int i = 0; i < (signed)num_rigid_contacts; i++) {
-        const real3& U = real3(norm[i]);
-        real3 V, W;
-        Orthogonalize(U, V, W);
-        ////int id_a = bids_rigid_rigid[i].x;
-        ////int id_b = bids_rigid_rigid[i].y;
+    for (int b = 0; b < (signed)num_rigid_bodies; b++) {
+        real3 force(0);
+        real3 torque(0);
+
+        for (int k = body_contacts_start[b]; k < body_contacts_start[b + 1]; k++) {
+            int index = body_contacts[k] / 2;
+            bool side_b = (body_contacts[k] % 2) != 0;
+
+            const real3_int& sbar = side_b ? rotated_point_b[index] : rotated_point_a[index];
+            const quaternion& q = side_b ? quat_b[index] : quat_a[index];
+
+            // Jacobian blocks are (-U, U_q x sbar) for the first body and (U, -U_q x sbar) for the second body
+            real sign = side_b ? 1 : -1;
+
+            const real3& U = norm[index];
+            real3 U_q = Rotate(U, q);
+
+            real g_n = gamma[index];
+            real3 f = U * g_n;
+            real3 t = Cross(U_q, sbar.v) * g_n;
+
+            if (mode == SolverMode::SLIDING || mode == SolverMode::SPINNING) {
+                real3 V, W;
+                Orthogonalize(U, V, W);
+                real3 V_q = Rotate(V, q);
+                real3 W_q = Rotate(W, q);
+
+                real g_u = gamma[num_rigid_contacts + index * 2 + 0];
+                real g_v = gamma[num_rigid_contacts + index * 2 + 1];
+                f += V * g_u + W * g_v;
+                t += Cross(V_q, sbar.v) * g_u + Cross(W_q, sbar.v) * g_v;
+
+                if (mode == SolverMode::SPINNING) {
+                    // Rolling and spinning rows only act on the rotational DOFs, with blocks -(U_q, V_q, W_q) for the
+                    // first body and (U_q, V_q, W_q) for the second body
+                    real g_s = gamma[3 * num_rigid_contacts + index * 3 + 0];
+                    real g_r1 = gamma[3 * num_rigid_contacts + index * 3 + 1];
+                    real g_r2 = gamma[3 * num_rigid_contacts + index * 3 + 2];
+                    torque += sign * (U_q * g_s + V_q * g_r1 + W_q * g_r2);
+                }
+            }
 
-        real3 T3, T4, T5, T6, T7, T8;
-        real3 g = real3(gam[i], gam[num_rigid_contacts + i * 2 + 0], gam[num_rigid_contacts + i * 2 + 1]);
-        {
-            const real3_int& sbar = rotated_point_a[i];
-            const quaternion& q_a = quat_a[i];
-            T3 = Cross(Rotate(U, q_a), sbar.v);
-            T4 = Cross(Rotate(V, q_a), sbar.v);
-            T5 = Cross(Rotate(W, q_a), sbar.v);
-
-            ////if (active_rigid[id_a] != 0)
-
-            real3 res = -U * g.x - V * g.y - W * g.z;
-
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 0] += res.x;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 1] += res.y;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 2] += res.z;
-
-            res = T3 * g.x + T4 * g.y + T5 * g.z;
-
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 3] += res.x;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 4] += res.y;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 5] += res.z;
+            force += sign * f;
+            torque -= sign * t;
         }
 
-        {
-            const real3_int& sbar = rotated_point_b[i];
-            const quaternion& q_b = quat_b[i];
-            T6 = Cross(Rotate(U, q_b), sbar.v);
-            T7 = Cross(Rotate(V, q_b), sbar.v);
-            T8 = Cross(Rotate(W, q_b), sbar.v);
-
-            // if (active_rigid[id_b] != 0)
-
-            real3 res = U * g.x + V * g.y + W * g.z;
-
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 0] += res.x;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 1] += res.y;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 2] += res.z;
-
-            res = -T6 * g.x - T7 * g.y - T8 * g.z;
-
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 3] += res.x;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 4] += res.y;
-#pragma omp atomic
-            XYZUVW[sbar.i * 6 + 5] += res.z;
-        }
+        XYZUVW[b * 6 + 0] += force.x;
+        XYZUVW[b * 6 + 1] += force.y;
+        XYZUVW[b * 6 + 2] += force.z;
+        XYZUVW[b * 6 + 3] += torque.x;
+        XYZUVW[b * 6 + 4] += torque.y;
+        XYZUVW[b * 6 + 5] += torque.z;
     }
 }
 
-void ChConstraintRigidRigid::D_Tx(const DynamicVector<real>& XYZUVW, DynamicVector<real>& out_vector) {
+void ChConstraintRigidRigid::D_Tx(const DynamicVector<real>& XYZUVW, DynamicVector<real>& output, SolverMode mode) {
     const auto num_rigid_contacts = data_manager->cd_data->num_rigid_contacts;
-    real3* norm = data_manager->cd_data->norm_rigid_rigid.data();
-    ////custom_vector<char>& active_rigid = data_manager->host_data.active_rigid;
-    ////real3* ptA = data_manager->cd_data->cpta_rigid_rigid.data();
-    ////real3* ptB = data_manager->cd_data->cptb_rigid_rigid.data();
-    ////vec2* bids_rigid_rigid = data_manager->cd_data->bids_rigid_rigid.data();
-    ////real3* pos = data_manager->host_data.pos_rigid.data();
-    ////quaternion* rot = data_manager->host_data.rot_rigid.data();
 
-#pragma omp parallel for
-    for (int i = 0; i < (signed)num_rigid_contacts; i++) {
-        const real3& U = real3(norm[i]);
-        real3 V, W;
-        Orthogonalize(U, V, W);
-        real temp[3] = {0, 0, 0};
-
-        ////real3 pA = ptA[i];
-        ////int id_a = bids_rigid_rigid[i].x;
-        ////if (active_rigid[id_a] != 0)
-        {
-            const real3_int& sbar = rotated_point_a[i];
-            const quaternion& quaternion_conjugate = quat_a[i];
+    if (num_rigid_contacts <= 0 || mode == SolverMode::BILATERAL) {
+        return;
+    }
 
-            real3 XYZ(XYZUVW[sbar.i * 6 + 0], XYZUVW[sbar.i * 6 + 1], XYZUVW[sbar.i * 6 + 2]);
-            real3 UVW(XYZUVW[sbar.i * 6 + 3], XYZUVW[sbar.i * 6 + 4], XYZUVW[sbar.i * 6 + 5]);
+    const real3* norm = data_manager->cd_data->norm_rigid_rigid.data();
 
-            real3 T1 = Cross(Rotate(U, quaternion_conjugate), sbar.v);
-            real3 T2 = Cross(Rotate(V, quaternion_conjugate), sbar.v);
-            real3 T3 = Cross(Rotate(W, quaternion_conjugate), sbar.v);
+#pragma omp parallel for
+    for (int index = 0; index < (signed)num_rigid_contacts; index++) {
+        const real3_int& sbar_a = rotated_point_a[index];
+        const real3_int& sbar_b = rotated_point_b[index];
+        const quaternion& q_a = quat_a[index];
+        const quaternion& q_b = quat_b[index];
 
-            temp[0] = Dot(XYZ, -U) + Dot(UVW, T1);
-            temp[1] = Dot(XYZ, -V) + Dot(UVW, T2);
-            temp[2] = Dot(XYZ, -W) + Dot(UVW, T3);
+        real3 XYZ_a(XYZUVW[sbar_a.i * 6 + 0], XYZUVW[sbar_a.i * 6 + 1], XYZUVW[sbar_a.i * 6 + 2]);
+        real3 UVW_a(XYZUVW[sbar_a.i * 6 + 3], XYZUVW[sbar_a.i * 6 + 4], XYZUVW[sbar_a.i * 6 + 5]);
+        real3 XYZ_b(XYZUVW[sbar_b.i * 6 + 0], XYZUVW[sbar_b.i * 6 + 1], XYZUVW[sbar_b.i * 6 + 2]);
+        real3 UVW_b(XYZUVW[sbar_b.i * 6 + 3], XYZUVW[sbar_b.i * 6 + 4], XYZUVW[sbar_b.i * 6 + 5]);
+        real3 XYZ_ab = XYZ_b - XYZ_a;
 
-            ////Jacobian<false>(rot[id_a], U, V, W, ptA[i] - pos[id_a], &XYZUVW[id_a * 6 + 0], temp);
-        }
+        const real3& U = norm[index];
+        real3 U_A = Rotate(U, q_a);
+        real3 U_B = Rotate(U, q_b);
 
-        ////real3 pB = ptB[i];
-        ////int id_b = bids_rigid_rigid[i].y;
-        ////if (active_rigid[id_b] != 0)
-        {
-            const real3_int& sbar = rotated_point_b[i];
-            const quaternion& quaternion_conjugate = quat_b[i];
+        output[index] += Dot(XYZ_ab, U) + Dot(UVW_a, Cross(U_A, sbar_a.v)) - Dot(UVW_b, Cross(U_B, sbar_b.v));
 
-            real3 XYZ(XYZUVW[sbar.i * 6 + 0], XYZUVW[sbar.i * 6 + 1], XYZUVW[sbar.i * 6 + 2]);
-            real3 UVW(XYZUVW[sbar.i * 6 + 3], XYZUVW[sbar.i * 6 + 4], XYZUVW[sbar.i * 6 + 5]);
+        if (mode == SolverMode::SLIDING || mode == SolverMode::SPINNING) {
+            real3 V, W;
+            Orthogonalize(U, V, W);
+            real3 V_A = Rotate(V, q_a);
+            real3 W_A = Rotate(W, q_a);
+            real3 V_B = Rotate(V, q_b);
+            real3 W_B = Rotate(W, q_b);
 
-            real3 T1 = Cross(Rotate(U, quaternion_conjugate), sbar.v);
-            real3 T2 = Cross(Rotate(V, quaternion_conjugate), sbar.v);
-            real3 T3 = Cross(Rotate(W, quaternion_conjugate), sbar.v);
+            output[num_rigid_contacts + index * 2 + 0] +=
+                Dot(XYZ_ab, V) + Dot(UVW_a, Cross(V_A, sbar_a.v)) - Dot(UVW_b, Cross(V_B, sbar_b.v));
+            output[num_rigid_contacts + index * 2 + 1] +=
+                Dot(XYZ_ab, W) + Dot(UVW_a, Cross(W_A, sbar_a.v)) - Dot(UVW_b, Cross(W_B, sbar_b.v));
 
-            temp[0] += Dot(XYZ, U) + Dot(UVW, -T1);
-            temp[1] += Dot(XYZ, V) + Dot(UVW, -T2);
-            temp[2] += Dot(XYZ, W) + Dot(UVW, -T3);
+            if (mode == SolverMode::SPINNING) {
+                output[3 * num_rigid_contacts + index * 3 + 0] += Dot(UVW_b, U_B) - Dot(UVW_a, U_A);
+                output[3 * num_rigid_contacts + index * 3 + 1] += Dot(UVW_b, V_B) - Dot(UVW_a, V_A);
+                output[3 * num_rigid_contacts + index * 3 + 2] += Dot(UVW_b, W_B) - Dot(UVW_a, W_A);
+            }
         }
-
-        out_vector[i] = temp[0];
-        out_vector[num_rigid_contacts + i * 2 + 0] = temp[1];
-        out_vector[num_rigid_contacts + i * 2 + 1] = temp[2];
-
-        //            out_vector[CONTACT + 3] = temp[3];
-        //            out_vector[CONTACT + 4] = temp[4];
-        //            out_vector[CONTACT + 5] = temp[5];
     }
-
-    //    // data_manager->PrintMatrix(data_manager->host_data.D);
-
-    //    DynamicVector<real> compare =
-    //            data_manager->host_data.D_T * data_manager->host_data.D * data_manager->host_data.gamma;
-    //    std::cout << "nconstr " << compare.size() << std::endl;
-    //    for (int i = 0; i < compare.size(); i++) {
-    //        std::cout << compare[i] << " " << out_vector[i] << std::endl;
-    //    }
 }
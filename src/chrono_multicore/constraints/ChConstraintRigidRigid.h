@@ -40,8 +40,14 @@ class CH_MULTICORE_API ChConstraintRigidRigid {
     void func_Project_normal(int index, const vec2* ids, const real* cohesion, real* gam);
     void func_Project_sliding(int index, const vec2* ids, const real3* fric, const real* cohesion, real* gam);
     void func_Project_spinning(int index, const vec2* ids, const real3* fric, real* gam);
-    void Dx(const DynamicVector<real>& x, DynamicVector<real>& output);
-    void D_Tx(const DynamicVector<real>& x, DynamicVector<real>& output);
+
+    /// Matrix-free product with the contact Jacobian D (accumulated in the rigid body entries of output).
+    /// Only the contact rows corresponding to the specified solver mode are included.
+    void Dx(const DynamicVector<real>& gamma, DynamicVector<real>& XYZUVW, SolverMode mode);
+
+    /// Matrix-free product with the transposed contact Jacobian D_T (accumulated in the contact rows of output).
+    /// Only the contact rows corresponding to the specified solver mode are computed.
+    void D_Tx(const DynamicVector<real>& XYZUVW, DynamicVector<real>& output, SolverMode mode);
 
     /// Compute the vector of corrections.
     void Build_b();
@@ -49,10 +55,12 @@ class CH_MULTICORE_API ChConstraintRigidRigid {
     void Build_E();
     /// Compute the jacobian matrix, no allocation is performed here,
     /// GenerateSparsity should take care of that.
+    /// Nothing is done if the contact Jacobian is applied in matrix-free form.
     void Build_D();
     void Build_s();
     /// Fill-in the non zero entries in the bilateral jacobian with ones.
     /// This operation is sequential.
+    /// If the contact Jacobian is applied in matrix-free form, the contact rows are left empty.
     void GenerateSparsity();
 
     int offset;
@@ -67,6 +75,11 @@ class CH_MULTICORE_API ChConstraintRigidRigid {
     custom_vector<real3_int> rotated_point_a, rotated_point_b;
     custom_vector<quaternion> quat_a, quat_b;
 
+    // Contacts of each body (used in matrix-free mode). The contacts of body i are stored in
+    // body_contacts[body_contacts_start[i]] ... body_contacts[body_contacts_start[i+1]-1], encoded as 2*index+side.
+    custom_vector<int> body_contacts_start;
+    custom_vector<int> body_contacts;
+
     ChMulticoreDataManager* data_manager;  ///< Pointer to the system's data manager
 };
 
@@ -23,6 +23,9 @@
 #include "chrono/physics/ChShaftsGearbox.h"
 #include "chrono/physics/ChShaftsGearboxAngled.h"
 #include "chrono/physics/ChShaftsPlanetary.h"
+#include "chrono/solver/ChConstraintTwoBodies.h"
+#include "chrono/solver/ChConstraintTwoGeneric.h"
+#include "chrono/solver/ChConstraintThreeGeneric.h"
 
 #include "chrono/multicore_math/matrix.h"
 
@@ -33,6 +36,7 @@
 #include "chrono_multicore/solver/ChSolverMulticore.h"
 #include "chrono_multicore/solver/ChSystemDescriptorMulticore.h"
 
+#include <algorithm>
 #include <numeric>
 
 using namespace chrono::collision;
@@ -114,6 +118,16 @@ bool ChSystemMulticore::Integrate_Y() {
 
     Setup();
 
+#ifdef _OPENMP
+    if (data_manager->settings.perform_phase_tuning) {
+        omp_set_num_threads(thread_tuner.GetNumThreads(ChThreadTuner::UPDATE));
+        if (auto cs = std::dynamic_pointer_cast<ChCollisionSystemChrono>(collision_system)) {
+            cs->SetPhaseNumThreads(thread_tuner.GetNumThreads(ChThreadTuner::BROADPHASE),
+                                   thread_tuner.GetNumThreads(ChThreadTuner::NARROWPHASE));
+        }
+    }
+#endif
+
     data_manager->system_timer.start("update");
     Update();
     data_manager->system_timer.stop("update");
@@ -128,15 +142,32 @@ bool ChSystemMulticore::Integrate_Y() {
     }
     data_manager->system_timer.stop("collision");
 
+    if (data_manager->settings.numa_placement) {
+        PlaceHostData();
+    }
+
+#ifdef _OPENMP
+    if (data_manager->settings.perform_phase_tuning) {
+        omp_set_num_threads(thread_tuner.GetNumThreads(ChThreadTuner::SCHUR_PRODUCT));
+    }
+#endif
+
     data_manager->system_timer.start("advance");
     std::static_pointer_cast<ChIterativeSolverMulticore>(solver)->RunTimeStep();
     data_manager->system_timer.stop("advance");
 
+#ifdef _OPENMP
+    if (data_manager->settings.perform_phase_tuning) {
+        omp_set_num_threads(thread_tuner.GetNumThreads(ChThreadTuner::UPDATE));
+    }
+#endif
+
     data_manager->system_timer.start("update");
 
     // Iterate over the active bilateral constraints and store their Lagrange
     // multiplier.
     std::vector<ChConstraint*>& mconstraints = descriptor->GetConstraintsList();
+#pragma omp parallel for
     for (int index = 0; index < (signed)data_manager->num_bilaterals; index++) {
         int cntr = data_manager->host_data.bilateral_mapping[index];
         mconstraints[cntr]->Set_l_i(data_manager->host_data.gamma[data_manager->num_unilaterals + index]);
@@ -144,11 +175,13 @@ bool ChSystemMulticore::Integrate_Y() {
 
     // Update the constraint reactions.
     double factor = 1 / this->GetStep();
-    for (auto& link : assembly.linklist) {
-        link->ConstraintsFetch_react(factor);
+#pragma omp parallel for
+    for (int i = 0; i < assembly.linklist.size(); i++) {
+        assembly.linklist[i]->ConstraintsFetch_react(factor);
     }
-    for (auto& item : assembly.otherphysicslist) {
-        item->ConstraintsFetch_react(factor);
+#pragma omp parallel for
+    for (int i = 0; i < assembly.otherphysicslist.size(); i++) {
+        assembly.otherphysicslist[i]->ConstraintsFetch_react(factor);
     }
     contact_container->ConstraintsFetch_react(factor);
 
@@ -182,7 +215,7 @@ bool ChSystemMulticore::Integrate_Y() {
     }
 
     uint offset = data_manager->num_rigid_bodies * 6;
-    ////#pragma omp parallel for
+#pragma omp parallel for
     for (int i = 0; i < (signed)data_manager->num_shafts; i++) {
         if (data_manager->host_data.shaft_active[i] != 0) {
             auto& shaft = assembly.shaftlist[i];
@@ -222,6 +255,9 @@ bool ChSystemMulticore::Integrate_Y() {
     if (data_manager->settings.perform_thread_tuning) {
         RecomputeThreads();
     }
+    if (data_manager->settings.perform_phase_tuning) {
+        RecomputePhaseThreads();
+    }
 
     return true;
 }
@@ -416,7 +452,7 @@ void ChSystemMulticore::UpdateShafts() {
     char* shaft_active = data_manager->host_data.shaft_active.data();
 
     uint offset = data_manager->num_rigid_bodies * 6;
-    ////#pragma omp parallel for
+#pragma omp parallel for
     for (int i = 0; i < (signed)data_manager->num_shafts; i++) {
         auto& shaft = assembly.shaftlist[i];
 
@@ -439,7 +475,8 @@ void ChSystemMulticore::UpdateShafts() {
 //
 void ChSystemMulticore::UpdateMotorLinks() {
     uint offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
-    for (uint i = 0; i < data_manager->num_linmotors; i++) {
+#pragma omp parallel for
+    for (int i = 0; i < (signed)data_manager->num_linmotors; i++) {
         linmotorlist[i]->Update(ch_time, false);
         linmotorlist[i]->VariablesFbLoadForces(GetStep());
         linmotorlist[i]->VariablesQbLoadSpeed();
@@ -447,7 +484,8 @@ void ChSystemMulticore::UpdateMotorLinks() {
         data_manager->host_data.hf[offset + i] = linmotorlist[i]->Variables().Get_fb()(0);
     }
     offset += data_manager->num_linmotors;
-    for (uint i = 0; i < data_manager->num_rotmotors; i++) {
+#pragma omp parallel for
+    for (int i = 0; i < (signed)data_manager->num_rotmotors; i++) {
         rotmotorlist[i]->Update(ch_time, false);
         rotmotorlist[i]->VariablesFbLoadForces(GetStep());
         rotmotorlist[i]->VariablesQbLoadSpeed();
@@ -466,12 +504,16 @@ void ChSystemMulticore::Update3DOFBodies() {
 //
 // Update all links in the system and set the type of the associated constraints
 // to BODY_BODY. Note that visualization assets are not updated.
+// The link updates only modify data owned by each link and are done in parallel.
+// Loading of link forces (which may act on bodies shared by several links) and
+// insertion of the constraints in the system descriptor are sequential.
 //
 void ChSystemMulticore::UpdateLinks() {
     double oostep = 1 / GetStep();
     real clamp_speed = data_manager->settings.solver.bilateral_clamp_speed;
     bool clamp = data_manager->settings.solver.clamp_bilaterals;
 
+#pragma omp parallel for
     for (int i = 0; i < assembly.linklist.size(); i++) {
         auto& link = assembly.linklist[i];
 
@@ -479,9 +521,13 @@ void ChSystemMulticore::UpdateLinks() {
         link->ConstraintsBiReset();
         link->ConstraintsBiLoad_C(oostep, clamp_speed, clamp);
         link->ConstraintsBiLoad_Ct(1);
-        link->ConstraintsFbLoadForces(GetStep());
         link->ConstraintsLoadJacobians();
+    }
+
+    for (int i = 0; i < assembly.linklist.size(); i++) {
+        auto& link = assembly.linklist[i];
 
+        link->ConstraintsFbLoadForces(GetStep());
         link->InjectConstraints(*descriptor);
 
         for (int j = 0; j < link->GetDOC_c(); j++)
@@ -531,6 +577,9 @@ void ChSystemMulticore::UpdateOtherPhysics() {
     real clamp_speed = data_manager->settings.solver.bilateral_clamp_speed;
     bool clamp = data_manager->settings.solver.clamp_bilaterals;
 
+    std::vector<BilateralType> types(assembly.otherphysicslist.size());
+
+#pragma omp parallel for
     for (int i = 0; i < assembly.otherphysicslist.size(); i++) {
         auto& item = assembly.otherphysicslist[i];
 
@@ -538,12 +587,20 @@ void ChSystemMulticore::UpdateOtherPhysics() {
         item->ConstraintsBiReset();
         item->ConstraintsBiLoad_C(oostep, clamp_speed, clamp);
         item->ConstraintsBiLoad_Ct(1);
-        item->ConstraintsFbLoadForces(GetStep());
         item->ConstraintsLoadJacobians();
+
+        types[i] = GetBilateralType(item.get());
+    }
+
+    // Items may load forces on shared bodies or shafts, so these are processed sequentially
+    for (int i = 0; i < assembly.otherphysicslist.size(); i++) {
+        auto& item = assembly.otherphysicslist[i];
+
+        item->ConstraintsFbLoadForces(GetStep());
         item->VariablesFbLoadForces(GetStep());
         item->VariablesQbLoadSpeed();
 
-        BilateralType type = GetBilateralType(item.get());
+        BilateralType type = types[i];
 
         if (type == BilateralType::UNKNOWN)
             continue;
@@ -556,37 +613,130 @@ void ChSystemMulticore::UpdateOtherPhysics() {
 }
 
 //
-// Collect indexes of all active bilateral constraints and calculate number of
-// non-zero entries in the constraint Jacobian.
+// Load the Jacobian entries (in increasing order of the column index) and the
+// right-hand side term of a bilateral constraint of the specified type.
+//
+static void LoadBilateral(ChConstraint* constraint, int type, int num_rigid_bodies, int* col, real* val, real& b) {
+    // Blocks of the Jacobian, one for each variable object (a body or a shaft)
+    struct Block {
+        int col;
+        int size;
+        const double* Cq;
+    };
+    Block blocks[3];
+    int num_blocks = 0;
+
+    auto body_col = [](ChVariables* var) {
+        return ((ChBody*)((ChVariablesBody*)(var))->GetUserData())->GetId() * 6;
+    };
+    auto shaft_col = [num_rigid_bodies](ChVariables* var) {
+        return num_rigid_bodies * 6 + ((ChVariablesShaft*)(var))->GetShaft()->GetId();
+    };
+
+    switch (type) {
+        case BilateralType::BODY_BODY: {
+            ChConstraintTwoBodies* mbilateral = (ChConstraintTwoBodies*)constraint;
+            blocks[num_blocks++] = {body_col(mbilateral->GetVariables_a()), 6, mbilateral->Get_Cq_a().data()};
+            blocks[num_blocks++] = {body_col(mbilateral->GetVariables_b()), 6, mbilateral->Get_Cq_b().data()};
+        } break;
+
+        case BilateralType::SHAFT_SHAFT: {
+            ChConstraintTwoGeneric* mbilateral = (ChConstraintTwoGeneric*)constraint;
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_a()), 1, mbilateral->Get_Cq_a().data()};
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_b()), 1, mbilateral->Get_Cq_b().data()};
+        } break;
+
+        case BilateralType::SHAFT_BODY: {
+            ChConstraintTwoGeneric* mbilateral = (ChConstraintTwoGeneric*)constraint;
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_a()), 1, mbilateral->Get_Cq_a().data()};
+            blocks[num_blocks++] = {body_col(mbilateral->GetVariables_b()), 6, mbilateral->Get_Cq_b().data()};
+        } break;
+
+        case BilateralType::SHAFT_SHAFT_SHAFT: {
+            ChConstraintThreeGeneric* mbilateral = (ChConstraintThreeGeneric*)constraint;
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_a()), 1, mbilateral->Get_Cq_a().data()};
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_b()), 1, mbilateral->Get_Cq_b().data()};
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_c()), 1, mbilateral->Get_Cq_c().data()};
+        } break;
+
+        case BilateralType::SHAFT_SHAFT_BODY: {
+            ChConstraintThreeGeneric* mbilateral = (ChConstraintThreeGeneric*)constraint;
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_a()), 1, mbilateral->Get_Cq_a().data()};
+            blocks[num_blocks++] = {shaft_col(mbilateral->GetVariables_b()), 1, mbilateral->Get_Cq_b().data()};
+            blocks[num_blocks++] = {body_col(mbilateral->GetVariables_c()), 6, mbilateral->Get_Cq_c().data()};
+        } break;
+    }
+
+    // Sort the blocks in increasing order of their first column (blocks do not overlap)
+    std::sort(blocks, blocks + num_blocks, [](const Block& a, const Block& b) { return a.col < b.col; });
+
+    int k = 0;
+    for (int ib = 0; ib < num_blocks; ib++) {
+        for (int j = 0; j < blocks[ib].size; j++) {
+            col[k] = blocks[ib].col + j;
+            val[k] = blocks[ib].Cq[j];
+            k++;
+        }
+    }
+
+    b = constraint->Get_b_i();
+}
+
+//
+// Collect indexes of all active bilateral constraints, calculate number of
+// non-zero entries in the constraint Jacobian, and load the Jacobian entries
+// and right-hand side terms of the active constraints in flat arrays.
 //
 void ChSystemMulticore::UpdateBilaterals() {
-    data_manager->nnz_bilaterals = 0;
     std::vector<ChConstraint*>& mconstraints = descriptor->GetConstraintsList();
+    auto& mapping = data_manager->host_data.bilateral_mapping;
+    auto& jac_start = data_manager->host_data.bilateral_jac_start;
+    auto& jac_col = data_manager->host_data.bilateral_jac_col;
+    auto& jac_val = data_manager->host_data.bilateral_jac_val;
+    auto& bil_b = data_manager->host_data.bilateral_b;
+
+    jac_start.clear();
+    jac_start.push_back(0);
 
     for (uint ic = 0; ic < mconstraints.size(); ic++) {
         if (mconstraints[ic]->IsActive()) {
-            data_manager->host_data.bilateral_mapping.push_back(ic);
+            int nnz = 0;
             switch (data_manager->host_data.bilateral_type[ic]) {
                 case BilateralType::BODY_BODY:
-                    data_manager->nnz_bilaterals += 12;
+                    nnz = 12;
                     break;
                 case BilateralType::SHAFT_SHAFT:
-                    data_manager->nnz_bilaterals += 2;
+                    nnz = 2;
                     break;
                 case BilateralType::SHAFT_SHAFT_SHAFT:
-                    data_manager->nnz_bilaterals += 3;
+                    nnz = 3;
                     break;
                 case BilateralType::SHAFT_BODY:
-                    data_manager->nnz_bilaterals += 7;
+                    nnz = 7;
                     break;
                 case BilateralType::SHAFT_SHAFT_BODY:
-                    data_manager->nnz_bilaterals += 8;
+                    nnz = 8;
                     break;
             }
+            mapping.push_back(ic);
+            jac_start.push_back(jac_start.back() + nnz);
         }
     }
     // Set the number of currently active bilateral constraints.
-    data_manager->num_bilaterals = (uint)data_manager->host_data.bilateral_mapping.size();
+    data_manager->num_bilaterals = (uint)mapping.size();
+    data_manager->nnz_bilaterals = jac_start.back();
+
+    jac_col.resize(data_manager->nnz_bilaterals);
+    jac_val.resize(data_manager->nnz_bilaterals);
+    bil_b.resize(data_manager->num_bilaterals);
+
+    int num_rigid_bodies = (int)data_manager->num_rigid_bodies;
+#pragma omp parallel for
+    for (int index = 0; index < (signed)data_manager->num_bilaterals; index++) {
+        int cntr = mapping[index];
+        LoadBilateral(mconstraints[cntr], data_manager->host_data.bilateral_type[cntr], num_rigid_bodies,
+                      &jac_col[jac_start[index]], &jac_val[jac_start[index]], bil_b[index]);
+    }
 }
 
 //
@@ -659,6 +809,66 @@ void ChSystemMulticore::RecomputeThreads() {
 #endif
 }
 
+void ChSystemMulticore::RecomputePhaseThreads() {
+    if (thread_tuner.IsTuned())
+        return;
+
+    // The solver phase is measured by the Schur product time for NSC and by the total solver time for SMC
+    double solver_time = (data_manager->settings.system_type == SystemType::SYSTEM_NSC)
+                             ? data_manager->system_timer.GetTime("ShurProduct")
+                             : data_manager->system_timer.GetTime("advance");
+
+    thread_tuner.AddSample(ChThreadTuner::UPDATE, data_manager->system_timer.GetTime("update"));
+    thread_tuner.AddSample(ChThreadTuner::BROADPHASE, collision_system->GetTimerCollisionBroad());
+    thread_tuner.AddSample(ChThreadTuner::NARROWPHASE, collision_system->GetTimerCollisionNarrow());
+    thread_tuner.AddSample(ChThreadTuner::SCHUR_PRODUCT, solver_time);
+
+    if (thread_tuner.IsTuned() && !thread_profile_file.empty()) {
+        if (!thread_tuner.WriteProfile(thread_profile_file)) {
+            std::cout << "WARNING! Cannot write thread profile " << thread_profile_file << std::endl;
+        }
+    }
+}
+
+void ChSystemMulticore::PlaceHostData() {
+    auto& hd = data_manager->host_data;
+    auto& cd = *data_manager->cd_data;
+
+    // Place each array with the number of threads of the phase processing it: body arrays are processed in the
+    // update phase, contact arrays and multipliers in the solver phase.
+    int nthreads_update = 1;
+    int nthreads_solver = 1;
+#ifdef _OPENMP
+    nthreads_update = omp_get_max_threads();
+    nthreads_solver = omp_get_max_threads();
+    if (data_manager->settings.perform_phase_tuning) {
+        nthreads_update = thread_tuner.GetNumThreads(ChThreadTuner::UPDATE);
+        nthreads_solver = thread_tuner.GetNumThreads(ChThreadTuner::SCHUR_PRODUCT);
+    }
+#endif
+
+    // Body arrays
+    numa_placement.Place(hd.pos_rigid, nthreads_update);
+    numa_placement.Place(hd.rot_rigid, nthreads_update);
+    numa_placement.Place(hd.active_rigid, nthreads_update);
+    numa_placement.Place(hd.collide_rigid, nthreads_update);
+    numa_placement.Place(hd.mass_rigid, nthreads_update);
+    numa_placement.Place(&hd.v, hd.v.data(), hd.v.capacity(), sizeof(real), nthreads_update);
+    numa_placement.Place(&hd.hf, hd.hf.data(), hd.hf.capacity(), sizeof(real), nthreads_update);
+
+    // Rigid contact arrays
+    numa_placement.Place(cd.norm_rigid_rigid, nthreads_solver);
+    numa_placement.Place(cd.cpta_rigid_rigid, nthreads_solver);
+    numa_placement.Place(cd.cptb_rigid_rigid, nthreads_solver);
+    numa_placement.Place(cd.dpth_rigid_rigid, nthreads_solver);
+    numa_placement.Place(cd.erad_rigid_rigid, nthreads_solver);
+    numa_placement.Place(cd.bids_rigid_rigid, nthreads_solver);
+    numa_placement.Place(cd.contact_shapeIDs, nthreads_solver);
+    numa_placement.Place(hd.fric_rigid_rigid, nthreads_solver);
+    numa_placement.Place(hd.compliance_rigid_rigid, nthreads_solver);
+    numa_placement.Place(&hd.gamma, hd.gamma.data(), hd.gamma.capacity(), sizeof(real), nthreads_solver);
+}
+
 void ChSystemMulticore::SetCollisionSystemType(ChCollisionSystemType type) {
     assert(assembly.GetNbodies() == 0);
 
@@ -796,6 +1006,9 @@ void ChSystemMulticore::SetNumThreads(int num_threads_chrono, int num_threads_co
         std::cout << "larger than maximum available (" << max_avail_threads << ")" << std::endl;
     }
     omp_set_num_threads(num_threads_chrono);
+    if (data_manager->settings.pin_threads) {
+        ChNUMAPlacement::PinThreads(num_threads_chrono);
+    }
 #else
     std::cout << "WARNING! OpenMP not enabled" << std::endl;
 #endif
@@ -812,6 +1025,37 @@ void ChSystemMulticore::EnableThreadTuning(int min_threads, int max_threads) {
 #endif
 }
 
+void ChSystemMulticore::EnableThreadPinning(bool val) {
+    bool was_pinned = data_manager->settings.pin_threads;
+    data_manager->settings.pin_threads = val;
+    if (val && !ChNUMAPlacement::PinThreads(nthreads_chrono)) {
+        std::cout << "WARNING! Thread pinning not supported" << std::endl;
+    }
+    if (!val && was_pinned) {
+        ChNUMAPlacement::UnpinThreads(nthreads_chrono);
+    }
+}
+
+void ChSystemMulticore::EnableNUMAPlacement(bool val) {
+    data_manager->settings.numa_placement = val;
+    numa_placement.Reset();
+}
+
+void ChSystemMulticore::EnablePhaseThreadTuning(int min_threads, int max_threads, const std::string& profile_file) {
+#ifdef _OPENMP
+    data_manager->settings.perform_thread_tuning = false;
+    data_manager->settings.perform_phase_tuning = true;
+    data_manager->settings.min_threads = min_threads;
+    data_manager->settings.max_threads = max_threads;
+    thread_profile_file = profile_file;
+    thread_tuner.Initialize(min_threads, max_threads);
+    if (!profile_file.empty())
+        thread_tuner.ReadProfile(profile_file);
+#else
+    std::cout << "WARNING! OpenMP not enabled" << std::endl;
+#endif
+}
+
 // -------------------------------------------------------------
 
 void ChSystemMulticore::SetMaterialCompositionStrategy(std::unique_ptr<ChMaterialCompositionStrategy>&& strategy) {
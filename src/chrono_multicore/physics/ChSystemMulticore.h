@@ -24,6 +24,7 @@
 #include <cfloat>
 #include <memory>
 #include <algorithm>
+#include <string>
 
 #include "chrono/physics/ChSystem.h"
 #include "chrono/physics/ChBody.h"
@@ -39,6 +40,8 @@
 #include "chrono_multicore/ChMulticoreDefines.h"
 #include "chrono_multicore/ChSettings.h"
 #include "chrono_multicore/ChMeasures.h"
+#include "chrono_multicore/ChThreadTuner.h"
+#include "chrono_multicore/ChNUMAPlacement.h"
 
 namespace chrono {
 
@@ -72,6 +75,8 @@ class CH_MULTICORE_API ChSystemMulticore : public ChSystem {
     virtual void UpdateMotorLinks();
     virtual void Update3DOFBodies();
     void RecomputeThreads();
+    void RecomputePhaseThreads();
+    void PlaceHostData();
 
     virtual ChBody* NewBody() override;
     virtual ChBodyAuxRef* NewBodyAuxRef() override;
@@ -176,6 +181,31 @@ class CH_MULTICORE_API ChSystemMulticore : public ChSystem {
     /// The initial number of threads is set to min_threads.
     void EnableThreadTuning(int min_threads, int max_threads);
 
+    /// Enable selection of a separate number of threads for each phase of a step (body update, collision broadphase,
+    /// collision narrowphase, and solver/Schur product), between the specified limits.
+    /// Candidate thread counts are timed over successive steps, using the per-phase timers, and the fastest one is
+    /// retained for each phase. If a profile file is specified and can be read, the thread counts are loaded from it
+    /// and no tuning is performed; otherwise, the tuned profile is written to that file once tuning completes.
+    /// This option replaces the global thread tuning enabled with EnableThreadTuning.
+    void EnablePhaseThreadTuning(int min_threads, int max_threads, const std::string& profile_file = "");
+
+    /// Enable binding of the OpenMP threads to processors (default: false).
+    /// If enabled, each of the worker threads set with SetNumThreads is bound to one of the processors available to
+    /// the process, so that threads do not migrate between NUMA nodes and keep accessing the memory they placed. The
+    /// calling (master) thread is not bound. This function also binds the threads in use at the time of the call;
+    /// disabling pinning restores their original affinity.
+    void EnableThreadPinning(bool val);
+
+    /// Enable NUMA-aware placement of the body and contact arrays (default: false).
+    /// If enabled, the memory of these arrays is placed after each reallocation or size change so that every page
+    /// resides on the NUMA node of the thread processing the corresponding elements in parallel loops (first-touch
+    /// placement matching the OpenMP static schedule and the number of threads of the phase processing the array).
+    /// This is most effective in conjunction with thread pinning.
+    void EnableNUMAPlacement(bool val);
+
+    /// Return the per-phase thread tuner.
+    const ChThreadTuner& GetThreadTuner() const { return thread_tuner; }
+
     /// Calculate the (linearized) bilateral constraint violations.
     /// Return the maximum constraint violation.
     double CalculateConstraintViolation(std::vector<double>& cvec);
@@ -191,6 +221,10 @@ class CH_MULTICORE_API ChSystemMulticore : public ChSystem {
     int detect_optimal_bins;
     std::vector<double> timer_accumulator, cd_accumulator;
     uint frame_threads, frame_bins, counter;
+
+    ChThreadTuner thread_tuner;       ///< per-phase thread counts
+    std::string thread_profile_file;  ///< file for saving/loading the tuned thread profile
+    ChNUMAPlacement numa_placement;   ///< placement of host arrays on NUMA nodes
     std::vector<ChLink*>::iterator it;
 
   private:
@@ -92,6 +92,8 @@ class CH_MULTICORE_API ChIterativeSolverMulticoreNSC : public ChIterativeSolverM
 
   private:
     ChShurProduct ShurProductFull;
+    ChShurProductMatrixFree ShurProductMatrixFree;
+    ChShurProductMixedPrecision ShurProductMixedPrecision;
     ChProjectConstraints ProjectFull;
 };
 
@@ -52,6 +52,22 @@ void ChIterativeSolverMulticoreNSC::RunTimeStep() {
 
     // This is the total number of constraints
     data_manager->num_constraints = data_manager->num_unilaterals + data_manager->num_bilaterals + num_3dof_3dof;
+
+    // Decide whether the rigid contact Jacobian is applied in matrix-free form (the Jacobi and Gauss-Seidel solvers,
+    // as well as the compute_N and update_rhs options, require the assembled contact Jacobian)
+    data_manager->matrix_free_contacts = data_manager->settings.solver.matrix_free &&
+                                         data_manager->settings.solver.solver_type != SolverType::JACOBI &&
+                                         data_manager->settings.solver.solver_type != SolverType::GAUSS_SEIDEL &&
+                                         !data_manager->settings.solver.compute_N &&
+                                         !data_manager->settings.solver.update_rhs;
+    ChShurProduct* shur_product = &ShurProductFull;
+    if (data_manager->matrix_free_contacts) {
+        shur_product = &ShurProductMatrixFree;
+    } else if (data_manager->settings.solver.mixed_precision) {
+        shur_product = &ShurProductMixedPrecision;
+    }
+    ChShurProduct& ShurProduct = *shur_product;
+
     // Generate the mass matrix and compute M_inv_k
     ComputeInvMassMatrix();
     // ComputeMassMatrix();
@@ -91,12 +107,16 @@ void ChIterativeSolverMulticoreNSC::RunTimeStep() {
 
     if (data_manager->num_constraints > 0) {
         // Rhs should be updated with latest velocity after presolve
-        data_manager->host_data.R_full =
-            -data_manager->host_data.b -
-            data_manager->host_data.D_T *
-                (data_manager->host_data.v + data_manager->host_data.M_inv * data_manager->host_data.hf);
+        DynamicVector<real> v_free =
+            data_manager->host_data.v + data_manager->host_data.M_inv * data_manager->host_data.hf;
+        data_manager->host_data.R_full = -data_manager->host_data.b - data_manager->host_data.D_T * v_free;
+        if (data_manager->matrix_free_contacts) {
+            v_free = -v_free;
+            data_manager->rigid_rigid->D_Tx(v_free, data_manager->host_data.R_full,
+                                            data_manager->settings.solver.solver_mode);
+        }
     }
-    ShurProductFull.Setup(data_manager);
+    ShurProduct.Setup(data_manager);
     ShurProductBilateral.Setup(data_manager);
     ProjectFull.Setup(data_manager);
 
@@ -109,7 +129,7 @@ void ChIterativeSolverMulticoreNSC::RunTimeStep() {
             data_manager->settings.solver.local_solver_mode = SolverMode::NORMAL;
             SetR();
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                     //
+                solver->Solve(ShurProduct,                                         //
                               ProjectFull,                                         //
                               data_manager->settings.solver.max_iteration_normal,  //
                               data_manager->num_constraints,                       //
@@ -123,7 +143,7 @@ void ChIterativeSolverMulticoreNSC::RunTimeStep() {
             data_manager->settings.solver.local_solver_mode = SolverMode::SLIDING;
             SetR();
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                      //
+                solver->Solve(ShurProduct,                                          //
                               ProjectFull,                                          //
                               data_manager->settings.solver.max_iteration_sliding,  //
                               data_manager->num_constraints,                        //
@@ -136,7 +156,7 @@ void ChIterativeSolverMulticoreNSC::RunTimeStep() {
             data_manager->settings.solver.local_solver_mode = SolverMode::SPINNING;
             SetR();
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                       //
+                solver->Solve(ShurProduct,                                           //
                               ProjectFull,                                           //
                               data_manager->settings.solver.max_iteration_spinning,  //
                               data_manager->num_constraints,                         //
@@ -211,6 +231,13 @@ void ChIterativeSolverMulticoreNSC::ComputeD() {
     CompressedMatrix<real>& M_invD = data_manager->host_data.M_invD;
     const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
 
+    // No storage is needed for the contact rows if the contact Jacobian is applied in matrix-free form
+    if (data_manager->matrix_free_contacts) {
+        nnz_normal = 0;
+        nnz_tangential = 0;
+        nnz_spinning = 0;
+    }
+
     int nnz_total = nnz_bilaterals + nnz_fluid_fluid;
     int num_rows = num_bilaterals + num_fluid_fluid;
 
@@ -371,7 +398,13 @@ void ChIterativeSolverMulticoreNSC::ComputeImpulses() {
 
     if (data_manager->num_constraints > 0) {
         // Compute new velocity based on the lagrange multipliers
-        v = v + M_inv * hf + data_manager->host_data.M_invD * gamma;
+        if (data_manager->matrix_free_contacts) {
+            DynamicVector<real> Dgamma = data_manager->host_data.D * gamma;
+            data_manager->rigid_rigid->Dx(gamma, Dgamma, data_manager->settings.solver.solver_mode);
+            v = v + M_inv * (hf + Dgamma);
+        } else {
+            v = v + M_inv * hf + data_manager->host_data.M_invD * gamma;
+        }
     } else {
         // When there are no constraints we need to still apply gravity and other
         // body forces!
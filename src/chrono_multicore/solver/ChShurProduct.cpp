@@ -103,6 +103,105 @@ void ChShurProduct::operator()(const DynamicVector<real>& x, DynamicVector<real>
     data_manager->system_timer.stop("ShurProduct");
 }
 
+void ChShurProductMatrixFree::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    data_manager->system_timer.start("ShurProduct");
+
+    const DynamicVector<real>& E = data_manager->host_data.E;
+    const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
+    ChConstraintRigidRigid* rigid_rigid = data_manager->rigid_rigid;
+
+    uint num_rigid_contacts = data_manager->cd_data->num_rigid_contacts;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    uint num_bilaterals = data_manager->num_bilaterals;
+    SolverMode mode = data_manager->settings.solver.local_solver_mode;
+    output.reset();
+
+    if (mode == data_manager->settings.solver.solver_mode) {
+        // The contact columns of D (and contact rows of D_T) are empty
+        const CompressedMatrix<real>& D = data_manager->host_data.D;
+        const CompressedMatrix<real>& D_T = data_manager->host_data.D_T;
+
+        DynamicVector<real> Dx = D * x;
+        rigid_rigid->Dx(x, Dx, mode);
+        DynamicVector<real> M_invDx = M_inv * Dx;
+
+        output = D_T * M_invDx + E * x;
+        rigid_rigid->D_Tx(M_invDx, output, mode);
+    } else {
+        const SubMatrixType& D_b_T = _DBT_;
+        uint num_bilateral_dof = (uint)D_b_T.columns();
+
+        SubVectorType o_b = subvector(output, num_unilaterals, num_bilaterals);
+        ConstSubVectorType x_b = subvector(x, num_unilaterals, num_bilaterals);
+        ConstSubVectorType E_b = subvector(E, num_unilaterals, num_bilaterals);
+
+        DynamicVector<real> Dx(data_manager->num_dof, 0);
+        subvector(Dx, 0, num_bilateral_dof) = trans(D_b_T) * x_b;
+        rigid_rigid->Dx(x, Dx, mode);
+        DynamicVector<real> M_invDx = M_inv * Dx;
+
+        o_b = D_b_T * subvector(M_invDx, 0, num_bilateral_dof) + E_b * x_b;
+        rigid_rigid->D_Tx(M_invDx, output, mode);
+
+        // Compliance terms for the contact rows in the current mode
+        uint num_rows = 0;
+        switch (mode) {
+            case SolverMode::NORMAL:
+                num_rows = num_rigid_contacts;
+                break;
+            case SolverMode::SLIDING:
+                num_rows = 3 * num_rigid_contacts;
+                break;
+            case SolverMode::SPINNING:
+                num_rows = 6 * num_rigid_contacts;
+                break;
+            default:
+                break;
+        }
+        if (num_rows > 0) {
+            subvector(output, 0, num_rows) += subvector(E, 0, num_rows) * subvector(x, 0, num_rows);
+        }
+    }
+    data_manager->system_timer.stop("ShurProduct");
+}
+
+void ChShurProductMixedPrecision::Setup(ChMulticoreDataManager* data_container_) {
+    ChShurProduct::Setup(data_container_);
+    if (data_manager->num_constraints == 0) {
+        return;
+    }
+    if (data_manager->settings.solver.compute_N) {
+        Nshur = data_manager->host_data.Nshur;
+    } else {
+        D_T = data_manager->host_data.D_T;
+        M_invD = data_manager->host_data.M_invD;
+    }
+}
+
+void ChShurProductMixedPrecision::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    if (data_manager->settings.solver.local_solver_mode != data_manager->settings.solver.solver_mode) {
+        ChShurProduct::operator()(x, output);
+        return;
+    }
+
+    data_manager->system_timer.start("ShurProduct");
+
+    const DynamicVector<real>& E = data_manager->host_data.E;
+
+    DynamicVector<float> x_single = x;
+    if (data_manager->settings.solver.compute_N) {
+        DynamicVector<float> Nx = Nshur * x_single;
+        output = Nx;
+    } else {
+        DynamicVector<float> M_invDx = M_invD * x_single;
+        DynamicVector<float> D_TM_invDx = D_T * M_invDx;
+        output = D_TM_invDx;
+    }
+    output += E * x;
+
+    data_manager->system_timer.stop("ShurProduct");
+}
+
 void ChShurProductBilateral::Setup(ChMulticoreDataManager* data_container_) {
     ChShurProduct::Setup(data_container_);
     if (data_manager->num_bilaterals == 0) {
@@ -66,6 +66,11 @@ class CH_MULTICORE_API ChShurProduct {
     //. Perform the Shur Product.
     virtual void operator()(const DynamicVector<real>& x, DynamicVector<real>& AX);
 
+    /// Perform the Shur Product in the precision of 'real'.
+    /// Used by the solvers for the products entering the objective function and the residual. By default, this is
+    /// the same as operator().
+    virtual void FullPrecision(const DynamicVector<real>& x, DynamicVector<real>& AX) { (*this)(x, AX); }
+
     ChMulticoreDataManager* data_manager;  ///< Pointer to the system's data manager
 };
 
@@ -82,6 +87,43 @@ class CH_MULTICORE_API ChShurProductBilateral : public ChShurProduct {
     CompressedMatrix<real> NshurB;
 };
 
+/// Functor class for calculating the Shur product with a matrix-free rigid contact Jacobian.
+/// The products with the rigid contact rows of D and D_T are evaluated directly from the contact data (see
+/// ChConstraintRigidRigid::Dx and ChConstraintRigidRigid::D_Tx), while the assembled matrices are used for the
+/// bilateral and 3-DOF constraints.
+class CH_MULTICORE_API ChShurProductMatrixFree : public ChShurProduct {
+  public:
+    ChShurProductMatrixFree() {}
+    virtual ~ChShurProductMatrixFree() {}
+
+    /// Perform the Shur Product.
+    virtual void operator()(const DynamicVector<real>& x, DynamicVector<real>& AX);
+};
+
+/// Functor class for calculating the Shur product in single precision.
+/// Single precision copies of the assembled matrices are created in Setup and used for the products on the full set
+/// of constraints; the input and output vectors are in the precision of 'real'. Products on subsets of constraints
+/// (local solver modes) and products requested through FullPrecision are performed as in the base class, with the
+/// assembled matrices in the precision of 'real'.
+class CH_MULTICORE_API ChShurProductMixedPrecision : public ChShurProduct {
+  public:
+    ChShurProductMixedPrecision() {}
+    virtual ~ChShurProductMixedPrecision() {}
+    virtual void Setup(ChMulticoreDataManager* data_container_);
+
+    /// Perform the Shur Product.
+    virtual void operator()(const DynamicVector<real>& x, DynamicVector<real>& AX);
+
+    /// Perform the Shur Product in the precision of 'real'.
+    virtual void FullPrecision(const DynamicVector<real>& x, DynamicVector<real>& AX) {
+        ChShurProduct::operator()(x, AX);
+    }
+
+    CompressedMatrix<float> D_T;     ///< single precision copy of D_T
+    CompressedMatrix<float> M_invD;  ///< single precision copy of M_invD
+    CompressedMatrix<float> Nshur;   ///< single precision copy of Nshur (if compute_N is set)
+};
+
 //========================================================================================================
 
 /// Base class for all Chrono::Multicore solvers.
@@ -146,7 +146,7 @@ uint ChSolverMulticoreAPGD::Solve(ChShurProduct& ShurProduct,
         g = temp - r;
         gamma_new = y - t * g;
         Project(gamma_new.data());
-        ShurProduct(gamma_new, N_gamma_new);
+        ShurProduct.FullPrecision(gamma_new, N_gamma_new);
         obj2 = (y, 0.5 * temp - r);
         temp = gamma_new - y;
         while ((gamma_new, 0.5 * N_gamma_new - r) > obj2 + (g + 0.5 * L * temp, temp)) {
@@ -154,7 +154,7 @@ uint ChSolverMulticoreAPGD::Solve(ChShurProduct& ShurProduct,
             t = 1.0 / L;
             gamma_new = y - t * g;
             Project(gamma_new.data());
-            ShurProduct(gamma_new, N_gamma_new);
+            ShurProduct.FullPrecision(gamma_new, N_gamma_new);
             obj1 = (gamma_new, 0.5 * N_gamma_new - r);
             temp = gamma_new - y;
         }
@@ -22,7 +22,7 @@ real ChSolverMulticoreAPGDREF::Res4(ChShurProduct& ShurProduct,
                                    const DynamicVector<real>& r,
                                    DynamicVector<real>& tmp) {
     real gdiff = 1.0 / pow(data_manager->num_constraints, 2.0);
-    ShurProduct(gamma, tmp);
+    ShurProduct.FullPrecision(gamma, tmp);
     tmp = tmp - r;
     tmp = gamma - gdiff * (tmp);
     Project(tmp.data());
@@ -111,9 +111,9 @@ uint ChSolverMulticoreAPGDREF::Solve(ChShurProduct& ShurProduct,
 
         // (10) while 0.5 * gamma_(k+1)' * N * gamma_(k+1) - gamma_(k+1)' * r >= 0.5 * y_k' * N * y_k - y_k' * r + g' *
         // (gamma_(k+1) - y_k) + 0.5 * L_k * norm(gamma_(k+1) - y_k)^2
-        ShurProduct(gammaNew, tmp);  // Here tmp is equal to N*gammaNew;
+        ShurProduct.FullPrecision(gammaNew, tmp);  // Here tmp is equal to N*gammaNew;
         obj1 = 0.5 * (gammaNew, tmp) - (gammaNew, r);
-        ShurProduct(y, tmp);  // Here tmp is equal to N*y;
+        ShurProduct.FullPrecision(y, tmp);  // Here tmp is equal to N*y;
         obj2 = 0.5 * (y, tmp) - (y, r);
         tmp = gammaNew - y;  // Here tmp is equal to gammaNew - y
         obj2 = obj2 + (g, tmp) + 0.5 * L * (tmp, tmp);
@@ -130,9 +130,9 @@ uint ChSolverMulticoreAPGDREF::Solve(ChShurProduct& ShurProduct,
             Project(gammaNew.data());
 
             // Update the components of the while condition
-            ShurProduct(gammaNew, tmp);  // Here tmp is equal to N*gammaNew;
+            ShurProduct.FullPrecision(gammaNew, tmp);  // Here tmp is equal to N*gammaNew;
             obj1 = 0.5 * (gammaNew, tmp) - (gammaNew, r);
-            ShurProduct(y, tmp);  // Here tmp is equal to N*y;
+            ShurProduct.FullPrecision(y, tmp);  // Here tmp is equal to N*y;
             obj2 = 0.5 * (y, tmp) - (y, r);
             tmp = gammaNew - y;  // Here tmp is equal to gammaNew - y
             obj2 = obj2 + (g, tmp) + 0.5 * L * (tmp, tmp);
@@ -168,9 +168,9 @@ uint ChSolverMulticoreAPGDREF::Solve(ChShurProduct& ShurProduct,
             std::cout << "Residual: " << residual << ", Iter: " << current_iteration << std::endl;
 
         DynamicVector<real> Nl(gammaNew.size());
-        ShurProduct(gammaNew, Nl);         // 1)  g_tmp = N*l_candidate
-        Nl = 0.5 * Nl - r;                 // 2) 0.5*N*l_candidate-b_shur
-        objective_value = (gammaNew, Nl);  // 3)  mf_p  = l_candidate'*(0.5*N*l_candidate-b_shur)
+        ShurProduct.FullPrecision(gammaNew, Nl);  // 1)  g_tmp = N*l_candidate
+        Nl = 0.5 * Nl - r;                        // 2) 0.5*N*l_candidate-b_shur
+        objective_value = (gammaNew, Nl);         // 3)  mf_p  = l_candidate'*(0.5*N*l_candidate-b_shur)
 
         AtIterationEnd(residual, objective_value);
         if (residual < data_manager->settings.solver.tol_speed) {
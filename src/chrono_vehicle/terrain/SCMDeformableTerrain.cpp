@@ -17,6 +17,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <queue>
@@ -1195,6 +1196,19 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
     m_timer_ray_casting.stop();
 
+    // List of hit nodes, in hash-map order. The iteration order of the hash-map depends on the order of insertion of
+    // the per-thread hits, so in deterministic mode sort the hit nodes by their grid coordinates.
+    typedef std::pair<const ChVector2<int>, HitRecord> HitEntry;
+    std::vector<HitEntry*> hit_list;
+    hit_list.reserve(hits.size());
+    for (auto& h : hits)
+        hit_list.push_back(&h);
+    if (GetSystem()->IsDeterministicModeEnabled()) {
+        std::sort(hit_list.begin(), hit_list.end(), [](const HitEntry* a, const HitEntry* b) {
+            return a->first.x() < b->first.x() || (a->first.x() == b->first.x() && a->first.y() < b->first.y());
+        });
+    }
+
     // --------------------
     // Find contact patches
     // --------------------
@@ -1214,7 +1228,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
     // Loop through all hit nodes and determine to which contact patch they belong.
     // Use a queue-based flood-filling algorithm based on the neighbors of each hit node.
     m_num_contact_patches = 0;
-    for (auto& h : hits) {
+    for (auto hp : hit_list) {
+        auto& h = *hp;
         if (h.second.patch_id != -1)
             continue;
 
@@ -1291,7 +1306,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
     double damping_R = m_damping_R;
 
     // Process only hit nodes
-    for (auto& h : hits) {
+    for (auto hp : hit_list) {
+        auto& h = *hp;
         ChVector2<> ij = h.first;
 
         auto& nr = m_grid_map.at(ij);      // node record
@@ -19,6 +19,8 @@
 //
 // =============================================================================
 
+#include "chrono/utils/ChProfiler.h"
+
 #include "chrono_vehicle/ChSubsysDefs.h"
 #include "chrono_vehicle/tracked_vehicle/ChTrackedVehicle.h"
 
@@ -76,6 +78,8 @@ void ChTrackedVehicle::Synchronize(double time,
                                    const DriverInputs& driver_inputs,
                                    const TerrainForces& shoe_forces_left,
                                    const TerrainForces& shoe_forces_right) {
+    CH_PROFILE_ZONE("Vehicle_synchronize");
+
     // Let the driveline combine driver inputs if needed.
     double braking_left, braking_right;
     m_driveline->CombineDriverInputs(driver_inputs, braking_left, braking_right);
@@ -117,6 +121,7 @@ void ChTrackedVehicle::Synchronize(double time,
 void ChTrackedVehicle::Advance(double step) {
     if (m_powertrain) {
         // Advance state of the associated powertrain.
+        CH_PROFILE_ZONE("Vehicle_powertrain_advance");
         m_powertrain->Advance(step);
     }
 
@@ -124,6 +129,7 @@ void ChTrackedVehicle::Advance(double step) {
     ChVehicle::Advance(step);
 
     // Process contacts.
+    CH_PROFILE_ZONE("Vehicle_track_contacts");
     m_contact_manager->Process(this);
 }
 
@@ -16,6 +16,8 @@
 //
 // =============================================================================
 
+#include "chrono/utils/ChProfiler.h"
+
 #include "chrono_vehicle/wheeled_vehicle/ChWheeledVehicle.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
@@ -65,6 +67,8 @@ void ChWheeledVehicle::InitializePowertrain(std::shared_ptr<ChPowertrain> powert
 // to the terrain system.
 // -----------------------------------------------------------------------------
 void ChWheeledVehicle::Synchronize(double time, const DriverInputs& driver_inputs, const ChTerrain& terrain) {
+    CH_PROFILE_ZONE("Vehicle_synchronize");
+
     double powertrain_torque = 0;
     if (m_powertrain && m_driveline) {
         // Extract the torque from the powertrain.
@@ -88,10 +92,13 @@ void ChWheeledVehicle::Synchronize(double time, const DriverInputs& driver_input
     }
 
     // Synchronize the vehicle's axle subsystems
+    CH_PROFILE_ZONE("Vehicle_axles_synchronize");
     for (auto& axle : m_axles) {
         for (auto& wheel : axle->GetWheels()) {
-            if (wheel->m_tire)
+            if (wheel->m_tire) {
+                CH_PROFILE_ZONE("Vehicle_tires_synchronize");
                 wheel->m_tire->Synchronize(time, terrain);
+            }
         }
         axle->Synchronize(time, driver_inputs);
     }
@@ -107,16 +114,20 @@ void ChWheeledVehicle::Synchronize(double time, const DriverInputs& driver_input
 void ChWheeledVehicle::Advance(double step) {
     if (m_powertrain) {
         // Advance state of the associated powertrain.
+        CH_PROFILE_ZONE("Vehicle_powertrain_advance");
         m_powertrain->Advance(step);
     }
 
     // Advance state of all vehicle tires.
     // This is done before advancing the state of the multibody system in order to use
     // wheel states corresponding to current time.
-    for (auto& axle : m_axles) {
-        for (auto& wheel : axle->GetWheels()) {
-            if (wheel->m_tire)
-                wheel->m_tire->Advance(step);
+    {
+        CH_PROFILE_ZONE("Vehicle_tires_advance");
+        for (auto& axle : m_axles) {
+            for (auto& wheel : axle->GetWheels()) {
+                if (wheel->m_tire)
+                    wheel->m_tire->Advance(step);
+            }
         }
     }
 
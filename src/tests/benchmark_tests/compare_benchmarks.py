@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# =============================================================================
+# PROJECT CHRONO - http://projectchrono.org
+#
+# Copyright (c) 2019 projectchrono.org
+# All right reserved.
+#
+# Use of this source code is governed by a BSD-style license that can be found
+# in the LICENSE file at the top level of the distribution and at
+# http://projectchrono.org/license-chrono.txt.
+#
+# =============================================================================
+# Authors: agent
+# =============================================================================
+#
+# Compare the results of Chrono benchmark tests against a baseline.
+#
+# The benchmark programs write their results (including the per-phase timers,
+# reported as benchmark counters) in JSON format with:
+#   btest_XXX --benchmark_out=results.json --benchmark_out_format=json
+#
+# Usage:
+#   compare_benchmarks.py baseline.json results.json [--threshold 0.1] [--counters]
+#
+# For each benchmark present in both files, the real time (mean over
+# repetitions, if available) is compared and optionally all per-phase timers.
+# The script exits with a non-zero status if any value is slower than the
+# baseline by more than the specified relative threshold.
+#
+# =============================================================================
+
+import argparse
+import json
+import sys
+
+# Ignore values below this threshold (in the reported units) when checking for regressions
+MIN_TIME = 1e-3
+
+# Entries in a benchmark record which are not timers
+NON_TIMERS = {"name", "run_name", "run_type", "family_index", "per_family_instance_index", "repetitions",
+              "repetition_index", "threads", "iterations", "time_unit", "aggregate_name", "cpu_time",
+              "error_occurred", "error_message", "real_time", "aggregate_unit"}
+
+
+def load_results(filename):
+    """Load a Google benchmark JSON file.
+    Return a dictionary keyed by benchmark run name, with the real time and the
+    per-phase timers. If repetitions were performed, the mean aggregates are used."""
+    with open(filename) as f:
+        data = json.load(f)
+
+    results = {}
+    means = {}
+    for bm in data["benchmarks"]:
+        name = bm.get("run_name", bm["name"])
+        timers = {"real_time": bm["real_time"]}
+        for key, val in bm.items():
+            if key not in NON_TIMERS and isinstance(val, (int, float)):
+                timers[key] = val
+        if bm.get("run_type") == "aggregate":
+            if bm.get("aggregate_name") == "mean":
+                means[name] = timers
+        elif name not in results:
+            results[name] = timers
+
+    results.update(means)
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare Chrono benchmark results against a baseline")
+    parser.add_argument("baseline", help="baseline results (Google benchmark JSON output)")
+    parser.add_argument("current", help="current results (Google benchmark JSON output)")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown considered a regression (default: 0.1)")
+    parser.add_argument("--counters", action="store_true", help="also check the per-phase timers")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = 0
+    print("{:<50s} {:<20s} {:>12s} {:>12s} {:>9s}".format("Benchmark", "Timer", "Baseline", "Current", "Change"))
+    for name in sorted(current):
+        if name not in baseline:
+            print("{:<50s} (no baseline)".format(name))
+            continue
+        for timer, val in sorted(current[name].items(), key=lambda x: x[0] != "real_time"):
+            if timer != "real_time" and not args.counters:
+                continue
+            ref = baseline[name].get(timer)
+            if ref is None:
+                continue
+            change = (val - ref) / ref if ref > MIN_TIME else 0.0
+            flag = ""
+            if change > args.threshold and val > MIN_TIME:
+                flag = "  REGRESSION"
+                regressions += 1
+            print("{:<50s} {:<20s} {:>12.4f} {:>12.4f} {:>+8.1f}%{}".format(name, timer, ref, val, 100 * change,
+                                                                             flag))
+
+    for name in sorted(baseline):
+        if name not in current:
+            print("{:<50s} (missing from current results)".format(name))
+
+    if regressions > 0:
+        print("\n{} regression(s) above {:.0f}%".format(regressions, 100 * args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,135 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Micro benchmark for the FEA mesh loading functions.
+// Each step evaluates the internal forces of a plate of ANCF shell elements
+// (residual) and loads the element stiffness, damping, and mass matrices (KRM),
+// with a varying number of threads. No integration step is taken.
+//
+// =============================================================================
+
+#include "chrono/ChConfig.h"
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono/physics/ChSystemSMC.h"
+
+#include "chrono/fea/ChElementShellANCF_3423.h"
+#include "chrono/fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// =============================================================================
+
+template <int N, int NTHREADS>
+class MeshLoadsTest : public utils::ChBenchmarkTest {
+  public:
+    MeshLoadsTest();
+    ~MeshLoadsTest() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override;
+    void AccumulateTimers(std::map<std::string, double>& timers) override;
+
+  private:
+    ChSystemSMC* m_system;
+    std::shared_ptr<ChMesh> m_mesh;
+    ChVectorDynamic<> m_R;
+};
+
+template <int N, int NTHREADS>
+MeshLoadsTest<N, NTHREADS>::MeshLoadsTest() {
+    m_system = new ChSystemSMC();
+    m_system->Set_G_acc(ChVector<>(0, -9.8, 0));
+    m_system->SetNumThreads(NTHREADS);
+
+    // Mesh properties
+    double length = 1;
+    double thickness = 0.01;
+
+    double rho = 500;
+    ChVector<> E(2.1e7, 2.1e7, 2.1e7);
+    ChVector<> nu(0.3, 0.3, 0.3);
+    ChVector<> G(8.0769231e6, 8.0769231e6, 8.0769231e6);
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(rho, E, nu, G);
+
+    // Create an NxN plate, fixed along one edge
+    m_mesh = chrono_types::make_shared<ChMesh>();
+    m_system->Add(m_mesh);
+
+    double dx = length / N;
+    ChVector<> dir(0, 1, 0);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyzD>> nodes;
+    for (int iz = 0; iz <= N; iz++) {
+        for (int ix = 0; ix <= N; ix++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(ix * dx, 0, iz * dx), dir);
+            node->SetFixed(ix == 0);
+            m_mesh->AddNode(node);
+            nodes.push_back(node);
+        }
+    }
+
+    for (int iz = 0; iz < N; iz++) {
+        for (int ix = 0; ix < N; ix++) {
+            int n0 = iz * (N + 1) + ix;
+            auto element = chrono_types::make_shared<ChElementShellANCF_3423>();
+            element->SetNodes(nodes[n0], nodes[n0 + 1], nodes[n0 + N + 2], nodes[n0 + N + 1]);
+            element->SetDimensions(dx, dx);
+            element->AddLayer(thickness, 0 * CH_C_DEG_TO_RAD, mat);
+            element->SetAlphaDamp(0.01);
+            m_mesh->AddElement(element);
+        }
+    }
+
+    // Take one step to set up the system (state offsets)
+    m_system->DoStepDynamics(1e-4);
+
+    m_R.setZero(m_system->GetNcoords_w());
+}
+
+template <int N, int NTHREADS>
+void MeshLoadsTest<N, NTHREADS>::ExecuteStep() {
+    m_mesh->ResetTimers();
+
+    m_R.setZero();
+    m_mesh->IntLoadResidual_F(m_mesh->GetOffset_w(), m_R, 1.0);
+    m_mesh->KRMmatricesLoad(1.0, 1.0, 1.0);
+}
+
+template <int N, int NTHREADS>
+void MeshLoadsTest<N, NTHREADS>::AccumulateTimers(std::map<std::string, double>& timers) {
+    timers["FEA_Residual"] += m_mesh->GetTimeInternalForces();
+    timers["FEA_KRM_Load"] += m_mesh->GetTimeJacobianLoad();
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 2  // number of steps for hot start
+#define NUM_SIM_STEPS 20  // number of load evaluations for each benchmark
+
+using Plate16_T1 = MeshLoadsTest<16, 1>;
+using Plate16_T2 = MeshLoadsTest<16, 2>;
+using Plate16_T4 = MeshLoadsTest<16, 4>;
+using Plate32_T1 = MeshLoadsTest<32, 1>;
+using Plate32_T2 = MeshLoadsTest<32, 2>;
+using Plate32_T4 = MeshLoadsTest<32, 4>;
+CH_BM_SIMULATION_LOOP(MeshLoads16_T1, Plate16_T1, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MeshLoads16_T2, Plate16_T2, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MeshLoads16_T4, Plate16_T4, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MeshLoads32_T1, Plate32_T1, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MeshLoads32_T2, Plate32_T2, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MeshLoads32_T4, Plate32_T4, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+BENCHMARK_MAIN();
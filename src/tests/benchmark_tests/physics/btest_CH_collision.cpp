@@ -0,0 +1,104 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Micro benchmark for collision detection.
+// A lattice of spheres and boxes in near-contact is processed by the collision
+// system at each step (no dynamics). The broadphase and narrowphase timers are
+// reported as benchmark counters.
+//
+// =============================================================================
+
+#include "chrono/ChConfig.h"
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// =============================================================================
+
+template <int N, ChCollisionSystemType CD_TYPE>
+class CollisionTest : public utils::ChBenchmarkTest {
+  public:
+    CollisionTest();
+    ~CollisionTest() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override {
+        m_system->ResetTimers();
+        m_system->ComputeCollisions();
+    }
+
+  private:
+    ChSystemNSC* m_system;
+};
+
+template <int N, ChCollisionSystemType CD_TYPE>
+CollisionTest<N, CD_TYPE>::CollisionTest() {
+    m_system = new ChSystemNSC();
+    m_system->SetCollisionSystemType(CD_TYPE);
+    m_system->SetNumThreads(1, 1, 1);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    // Ground
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(N * 0.2 + 1, 0.2, N * 0.2 + 1, 1000, mat, CD_TYPE);
+    ground->SetPos(ChVector<>((N - 1) * 0.1, -0.2, (N - 1) * 0.1));
+    ground->SetBodyFixed(true);
+    m_system->AddBody(ground);
+
+    // Lattice of alternating spheres and boxes, with a small overlap between neighbours
+    double radius = 0.1;
+    double spacing = 1.95 * radius;
+    for (int ix = 0; ix < N; ix++) {
+        for (int iy = 0; iy < N; iy++) {
+            for (int iz = 0; iz < N; iz++) {
+                std::shared_ptr<ChBody> body;
+                if ((ix + iy + iz) % 2 == 0)
+                    body = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, mat, CD_TYPE);
+                else
+                    body = chrono_types::make_shared<ChBodyEasyBox>(2 * radius, 2 * radius, 2 * radius, 1000, mat,
+                                                                    CD_TYPE);
+                body->SetPos(ChVector<>(ix * spacing, iy * spacing, iz * spacing));
+                body->SetRot(Q_from_AngY(0.1 * iy));
+                m_system->AddBody(body);
+            }
+        }
+    }
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 10  // number of steps for hot start
+#define NUM_SIM_STEPS 50   // number of collision detection passes for each benchmark
+
+using Bullet08 = CollisionTest<8, ChCollisionSystemType::BULLET>;
+using Bullet16 = CollisionTest<16, ChCollisionSystemType::BULLET>;
+using Bullet24 = CollisionTest<24, ChCollisionSystemType::BULLET>;
+CH_BM_SIMULATION_LOOP(CollisionBullet08, Bullet08, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(CollisionBullet16, Bullet16, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(CollisionBullet24, Bullet24, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+#ifdef CHRONO_COLLISION
+using Chrono08 = CollisionTest<8, ChCollisionSystemType::CHRONO>;
+using Chrono16 = CollisionTest<16, ChCollisionSystemType::CHRONO>;
+using Chrono24 = CollisionTest<24, ChCollisionSystemType::CHRONO>;
+CH_BM_SIMULATION_LOOP(CollisionChrono08, Chrono08, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(CollisionChrono16, Chrono16, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(CollisionChrono24, Chrono24, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+#endif
+
+BENCHMARK_MAIN();
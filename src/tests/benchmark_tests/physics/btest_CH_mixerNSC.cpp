@@ -22,6 +22,7 @@
 #include "chrono/physics/ChSystemNSC.h"
 #include "chrono/physics/ChBodyEasy.h"
 #include "chrono/physics/ChLinkMotorRotationSpeed.h"
+#include "chrono/solver/ChSolverPSOR.h"
 
 #ifdef CHRONO_IRRLICHT
     #include "chrono_irrlicht/ChVisualSystemIrrlicht.h"
@@ -31,7 +32,7 @@ using namespace chrono;
 
 // =============================================================================
 
-template <int N>
+template <int N, bool MT = false>
 class MixerTestNSC : public utils::ChBenchmarkTest {
   public:
     MixerTestNSC();
@@ -47,8 +48,16 @@ class MixerTestNSC : public utils::ChBenchmarkTest {
     double m_step;
 };
 
-template <int N>
-MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+template <int N, bool MT>
+MixerTestNSC<N, MT>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+    if (MT) {
+        // Multithreaded (graph-colored) PSOR sweep
+        auto solver = chrono_types::make_shared<ChSolverPSOR>();
+        solver->EnableMultithreading(true);
+        m_system->SetSolver(solver);
+        m_system->SetNumThreads(ChOMP::GetNumProcs(), 1, 1);
+    }
+
     auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
 
     for (int bi = 0; bi < N; bi++) {
@@ -101,8 +110,8 @@ MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
     m_system->AddLink(motor);
 }
 
-template <int N>
-void MixerTestNSC<N>::SimulateVis() {
+template <int N, bool MT>
+void MixerTestNSC<N, MT>::SimulateVis() {
 #ifdef CHRONO_IRRLICHT
     // Create the Irrlicht visualization system
     auto vis = chrono_types::make_shared<irrlicht::ChVisualSystemIrrlicht>();
@@ -132,6 +141,9 @@ void MixerTestNSC<N>::SimulateVis() {
 CH_BM_SIMULATION_LOOP(MixerNSC032, MixerTestNSC<32>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(MixerNSC064, MixerTestNSC<64>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 
+using MixerTestNSC064mt = MixerTestNSC<64, true>;
+CH_BM_SIMULATION_LOOP(MixerNSC064mt, MixerTestNSC064mt, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
 // =============================================================================
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,194 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Micro benchmark for the Chrono solvers.
+// Each solver is exercised on a canned problem: the model is brought to a given
+// state during hot start and this state is restored before every step, so that
+// all steps (and all solvers) work on the same system descriptor.
+// - a pile of spheres in a box (contacts) for the VI solvers
+// - a pendulum chain (bilateral constraints only) for the linear solvers
+//
+// =============================================================================
+
+#include "chrono/ChConfig.h"
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChIterativeSolver.h"
+
+using namespace chrono;
+
+// =============================================================================
+
+/// Base class for solver benchmarks on a canned problem.
+class SolverTest : public utils::ChBenchmarkTest {
+  public:
+    virtual ~SolverTest() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override;
+
+  protected:
+    SolverTest(ChSolver::Type solver_type);
+
+    /// Advance the model to the state used for all subsequent steps.
+    void Settle(int num_steps);
+
+    ChSystemNSC* m_system;
+    double m_step;
+
+  private:
+    ChState m_x;
+    ChStateDelta m_v;
+    double m_time;
+};
+
+SolverTest::SolverTest(ChSolver::Type solver_type) : m_step(1e-3), m_time(0) {
+    m_system = new ChSystemNSC();
+    m_system->Set_G_acc(ChVector<>(0, -9.81, 0));
+    m_system->SetNumThreads(1);
+    m_system->SetSolverType(solver_type);
+
+    if (auto solver = std::dynamic_pointer_cast<ChIterativeSolver>(m_system->GetSolver())) {
+        solver->SetMaxIterations(100);
+        solver->SetTolerance(1e-8);
+    }
+}
+
+void SolverTest::Settle(int num_steps) {
+    for (int i = 0; i < num_steps; i++)
+        m_system->DoStepDynamics(m_step);
+
+    m_x.resize(m_system->GetNcoords_x());
+    m_v.resize(m_system->GetNcoords_w());
+    m_system->StateGather(m_x, m_v, m_time);
+}
+
+void SolverTest::ExecuteStep() {
+    m_system->StateScatter(m_x, m_v, m_time, true);
+    m_system->DoStepDynamics(m_step);
+}
+
+// -----------------------------------------------------------------------------
+
+/// Pile of spheres in a box container.
+template <ChSolver::Type SOLVER>
+class ContactTest : public SolverTest {
+  public:
+    ContactTest();
+};
+
+template <ChSolver::Type SOLVER>
+ContactTest<SOLVER>::ContactTest() : SolverTest(SOLVER) {
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    // Container
+    double hsize = 1.0;
+    double hthick = 0.1;
+    auto bin = chrono_types::make_shared<ChBody>();
+    bin->SetBodyFixed(true);
+    bin->SetCollide(true);
+    bin->GetCollisionModel()->ClearModel();
+    bin->GetCollisionModel()->AddBox(mat, hsize, hthick, hsize, ChVector<>(0, -hthick, 0));
+    bin->GetCollisionModel()->AddBox(mat, hthick, hsize, hsize, ChVector<>(-hsize - hthick, hsize, 0));
+    bin->GetCollisionModel()->AddBox(mat, hthick, hsize, hsize, ChVector<>(+hsize + hthick, hsize, 0));
+    bin->GetCollisionModel()->AddBox(mat, hsize, hsize, hthick, ChVector<>(0, hsize, -hsize - hthick));
+    bin->GetCollisionModel()->AddBox(mat, hsize, hsize, hthick, ChVector<>(0, hsize, +hsize + hthick));
+    bin->GetCollisionModel()->BuildModel();
+    m_system->AddBody(bin);
+
+    // Spheres
+    double radius = 0.1;
+    int n = 8;
+    for (int ix = 0; ix < n; ix++) {
+        for (int iy = 0; iy < 4; iy++) {
+            for (int iz = 0; iz < n; iz++) {
+                auto ball = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, true, true, mat);
+                ball->SetPos(ChVector<>(-hsize + (ix + 0.5 + 0.1 * (iy % 2)) * 2 * hsize / n,  //
+                                        (2 * iy + 1) * radius * 1.01,                         //
+                                        -hsize + (iz + 0.5) * 2 * hsize / n));
+                m_system->AddBody(ball);
+            }
+        }
+    }
+
+    Settle(500);
+}
+
+// -----------------------------------------------------------------------------
+
+/// Pendulum chain with revolute joints.
+template <ChSolver::Type SOLVER>
+class ChainTest : public SolverTest {
+  public:
+    ChainTest();
+};
+
+template <ChSolver::Type SOLVER>
+ChainTest<SOLVER>::ChainTest() : SolverTest(SOLVER) {
+    int num_links = 64;
+    double length = 0.25;
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    m_system->AddBody(ground);
+
+    for (int ib = 0; ib < num_links; ib++) {
+        auto prev = m_system->Get_bodylist().back();
+
+        auto pend = chrono_types::make_shared<ChBodyEasyBox>(length, 0.025, 0.025, 500, true, false);
+        pend->SetPos(ChVector<>((ib + 0.5) * length, 0, 0));
+        m_system->AddBody(pend);
+
+        auto rev = chrono_types::make_shared<ChLinkLockRevolute>();
+        rev->Initialize(pend, prev, ChCoordsys<>(ChVector<>(ib * length, 0, 0)));
+        m_system->AddLink(rev);
+    }
+
+    Settle(100);
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 1  // hot start is performed by each test
+#define NUM_SIM_STEPS 20  // number of simulation steps for each benchmark
+
+using ContactPSOR = ContactTest<ChSolver::Type::PSOR>;
+using ContactPSSOR = ContactTest<ChSolver::Type::PSSOR>;
+using ContactPJACOBI = ContactTest<ChSolver::Type::PJACOBI>;
+using ContactBB = ContactTest<ChSolver::Type::BARZILAIBORWEIN>;
+using ContactAPGD = ContactTest<ChSolver::Type::APGD>;
+using ContactADMM = ContactTest<ChSolver::Type::ADDM>;
+CH_BM_SIMULATION_LOOP(SolverContactPSOR, ContactPSOR, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverContactPSSOR, ContactPSSOR, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverContactPJACOBI, ContactPJACOBI, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverContactBB, ContactBB, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverContactAPGD, ContactAPGD, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverContactADMM, ContactADMM, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+using ChainMINRES = ChainTest<ChSolver::Type::MINRES>;
+using ChainGMRES = ChainTest<ChSolver::Type::GMRES>;
+using ChainBICGSTAB = ChainTest<ChSolver::Type::BICGSTAB>;
+using ChainSparseLU = ChainTest<ChSolver::Type::SPARSE_LU>;
+using ChainSparseQR = ChainTest<ChSolver::Type::SPARSE_QR>;
+CH_BM_SIMULATION_LOOP(SolverChainMINRES, ChainMINRES, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverChainGMRES, ChainGMRES, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverChainBICGSTAB, ChainBICGSTAB, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverChainSparseLU, ChainSparseLU, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(SolverChainSparseQR, ChainSparseQR, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,214 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Micro benchmarks for Chrono::Vehicle subsystems.
+// - SCM ray casting: rigid cylinders rolling over SCM deformable terrain, with
+//   the SCM ray testing, ray casting, and contact force timers reported.
+// - tire force evaluation: HMMWV on rigid terrain, with the time spent in the
+//   tire Synchronize and Advance functions reported (from the profile trace).
+//
+// =============================================================================
+
+#include "chrono/utils/ChBenchmark.h"
+#include "chrono/utils/ChProfiler.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+#include "chrono_vehicle/ChDriver.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+#include "chrono_models/vehicle/hmmwv/HMMWV.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::hmmwv;
+
+// =============================================================================
+
+template <int NUM_CYLINDERS>
+class ScmTest : public utils::ChBenchmarkTest {
+  public:
+    ScmTest();
+    ~ScmTest();
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(m_step); }
+    void AccumulateTimers(std::map<std::string, double>& timers) override;
+
+  private:
+    ChSystemSMC* m_system;
+    SCMDeformableTerrain* m_terrain;
+    double m_step;
+};
+
+template <int NUM_CYLINDERS>
+ScmTest<NUM_CYLINDERS>::ScmTest() : m_step(2e-3) {
+    m_system = new ChSystemSMC();
+    m_system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    m_system->SetNumThreads(4, 4, 1);
+
+    // SCM terrain (Z up)
+    double length = 20;
+    double width = 2.0 * NUM_CYLINDERS;
+    m_terrain = new SCMDeformableTerrain(m_system, false);
+    m_terrain->SetSoilParameters(2e6,   // Bekker Kphi
+                                 0,     // Bekker Kc
+                                 1.1,   // Bekker n exponent
+                                 0,     // Mohr cohesive limit (Pa)
+                                 30,    // Mohr friction limit (degrees)
+                                 0.01,  // Janosi shear coefficient (m)
+                                 2e8,   // Elastic stiffness (Pa/m), before plastic yield
+                                 3e4    // Damping (Pa s/m), proportional to negative vertical speed (optional)
+    );
+
+    // Rolling cylinders (axis along Y), each monitored by a moving patch
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    double radius = 0.5;
+    for (int i = 0; i < NUM_CYLINDERS; i++) {
+        auto cyl = chrono_types::make_shared<ChBodyEasyCylinder>(radius, 0.4, 500, true, true, mat);
+        cyl->SetPos(ChVector<>(-length / 2 + 2, -width / 2 + 1 + 2.0 * i, radius));
+        cyl->SetPos_dt(ChVector<>(2, 0, 0));
+        cyl->SetWvel_par(ChVector<>(0, 2 / radius, 0));
+        m_system->AddBody(cyl);
+
+        m_terrain->AddMovingPatch(cyl, ChVector<>(0, 0, 0), ChVector<>(2 * radius, 0.4, 2 * radius));
+    }
+
+    m_terrain->Initialize(length, width, 0.02);
+}
+
+template <int NUM_CYLINDERS>
+ScmTest<NUM_CYLINDERS>::~ScmTest() {
+    delete m_terrain;
+    delete m_system;
+}
+
+template <int NUM_CYLINDERS>
+void ScmTest<NUM_CYLINDERS>::AccumulateTimers(std::map<std::string, double>& timers) {
+    // SCM timers are reported in milliseconds
+    timers["SCM_RayTesting"] += 1e-3 * m_terrain->GetTimerRayTesting();
+    timers["SCM_RayCasting"] += 1e-3 * m_terrain->GetTimerRayCasting();
+    timers["SCM_ContactForces"] += 1e-3 * m_terrain->GetTimerContactForces();
+}
+
+// =============================================================================
+
+template <TireModelType TIRE_MODEL>
+class TireTest : public utils::ChBenchmarkTest {
+  public:
+    TireTest();
+    ~TireTest();
+
+    ChSystem* GetSystem() override { return m_hmmwv->GetSystem(); }
+    void ExecuteStep() override;
+    void AccumulateTimers(std::map<std::string, double>& timers) override;
+
+  private:
+    HMMWV_Full* m_hmmwv;
+    RigidTerrain* m_terrain;
+    ChDriver* m_driver;
+
+    double m_step_veh;
+    double m_step_tire;
+};
+
+template <TireModelType TIRE_MODEL>
+TireTest<TIRE_MODEL>::TireTest() : m_step_veh(2e-3), m_step_tire(1e-3) {
+    // Create the HMMWV vehicle, set parameters, and initialize.
+    m_hmmwv = new HMMWV_Full();
+    m_hmmwv->SetContactMethod(ChContactMethod::SMC);
+    m_hmmwv->SetChassisFixed(false);
+    m_hmmwv->SetInitPosition(ChCoordsys<>(ChVector<>(-120, 0, 0.7), ChQuaternion<>(1, 0, 0, 0)));
+    m_hmmwv->SetPowertrainType(PowertrainModelType::SHAFTS);
+    m_hmmwv->SetDriveType(DrivelineTypeWV::AWD);
+    m_hmmwv->SetTireType(TIRE_MODEL);
+    m_hmmwv->SetTireStepSize(m_step_tire);
+    m_hmmwv->Initialize();
+
+    // Create the terrain
+    m_terrain = new RigidTerrain(m_hmmwv->GetSystem());
+    auto patch_material = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    patch_material->SetFriction(0.9f);
+    patch_material->SetRestitution(0.01f);
+    patch_material->SetYoungModulus(2e7f);
+    m_terrain->AddPatch(patch_material, CSYSNORM, 300, 20);
+    m_terrain->Initialize();
+
+    // Driver with constant inputs
+    m_driver = new ChDriver(m_hmmwv->GetVehicle());
+    m_driver->Initialize();
+    m_driver->SetThrottle(0.5);
+
+    // Tire timers are collected from the profile trace
+    utils::ChProfileTrace::Enable();
+}
+
+template <TireModelType TIRE_MODEL>
+TireTest<TIRE_MODEL>::~TireTest() {
+    utils::ChProfileTrace::Disable();
+    delete m_hmmwv;
+    delete m_terrain;
+    delete m_driver;
+}
+
+template <TireModelType TIRE_MODEL>
+void TireTest<TIRE_MODEL>::ExecuteStep() {
+    // Discard previous events, so that the profile trace only covers this step
+    utils::ChProfileTrace::Clear();
+
+    double time = m_hmmwv->GetSystem()->GetChTime();
+
+    DriverInputs driver_inputs = m_driver->GetInputs();
+
+    m_driver->Synchronize(time);
+    m_terrain->Synchronize(time);
+    m_hmmwv->Synchronize(time, driver_inputs, *m_terrain);
+
+    m_driver->Advance(m_step_veh);
+    m_terrain->Advance(m_step_veh);
+    m_hmmwv->Advance(m_step_veh);
+}
+
+template <TireModelType TIRE_MODEL>
+void TireTest<TIRE_MODEL>::AccumulateTimers(std::map<std::string, double>& timers) {
+    // Zone statistics are reported in microseconds
+    auto stats = utils::ChProfileTrace::GetStatistics();
+    timers["Tire_Synchronize"] += 1e-6 * stats["Tire_synchronize"].total;
+    timers["Tire_Advance"] += 1e-6 * stats["Tires_advance"].total;
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 500  // number of steps for hot start
+#define NUM_SIM_STEPS 500   // number of simulation steps for each benchmark
+
+// The models are recreated for each measurement, so that the bodies and vehicles do not leave the terrain patches
+
+CH_BM_SIMULATION_ONCE(SCM_Cylinders01, ScmTest<1>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(SCM_Cylinders04, ScmTest<4>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(SCM_Cylinders08, ScmTest<8>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+using TireRigid = TireTest<TireModelType::RIGID>;
+using TireTMeasy = TireTest<TireModelType::TMEASY>;
+using TireFiala = TireTest<TireModelType::FIALA>;
+using TirePac89 = TireTest<TireModelType::PAC89>;
+using TirePac02 = TireTest<TireModelType::PAC02>;
+CH_BM_SIMULATION_ONCE(Tire_Rigid, TireRigid, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(Tire_TMeasy, TireTMeasy, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(Tire_Fiala, TireFiala, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(Tire_Pac89, TirePac89, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(Tire_Pac02, TirePac02, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the AABB tree broadphase of the Chrono collision system.
+// A mix of small spheres and large boxes falls on a large fixed ground box. The
+// simulation uses the (persistent) AABB tree broadphase; periodically, the sets
+// of overlapping shape pairs produced by the grid and AABB tree broadphase
+// methods are compared.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static std::vector<std::pair<int, int>> OverlappingPairs(ChCollisionSystemChrono& coll) {
+    std::vector<std::pair<int, int>> pairs;
+    for (const auto& p : coll.GetOverlappingPairs())
+        pairs.push_back(std::make_pair(p.x, p.y));
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+TEST(ChBroadphase, aabb_tree) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto coll = chrono_types::make_shared<ChCollisionSystemChrono>();
+    coll->SetBroadphaseGridResolution(ChVector<int>(4, 4, 4));
+    coll->SetBroadphaseMethod(ChBroadphase::Method::AABB_TREE);
+    sys.SetCollisionSystem(coll);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, mat, ChCollisionSystemType::CHRONO);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int i = 0; i < 4; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(2, 0.5, 2, 1000, mat, ChCollisionSystemType::CHRONO);
+        box->SetPos(ChVector<>(-4.0 + 2.5 * i, 0.3 + 0.1 * i, 0.5 * (i % 2)));
+        sys.AddBody(box);
+    }
+
+    for (int i = 0; i < 400; i++) {
+        double radius = 0.05 + 0.05 * std::abs(std::sin(1.3 * i));
+        auto ball = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, mat, ChCollisionSystemType::CHRONO);
+        double x = -5.0 + 0.5 * (i % 20);
+        double y = 1.0 + 0.2 * (i / 100);
+        double z = -5.0 + 0.5 * ((i / 20) % 5) + 0.1 * (i / 100);
+        ball->SetPos(ChVector<>(x, y, z));
+        ball->SetPos_dt(ChVector<>(std::sin(0.7 * i), 0, std::cos(0.3 * i)));
+        sys.AddBody(ball);
+    }
+
+    for (int step = 0; step < 500; step++) {
+        sys.DoStepDynamics(1e-3);
+
+        if (step % 50 != 0)
+            continue;
+
+        coll->SetBroadphaseMethod(ChBroadphase::Method::GRID);
+        sys.ComputeCollisions();
+        auto grid_pairs = OverlappingPairs(*coll);
+        auto grid_contacts = sys.GetNcontacts();
+
+        coll->SetBroadphaseMethod(ChBroadphase::Method::AABB_TREE);
+        sys.ComputeCollisions();
+        auto tree_pairs = OverlappingPairs(*coll);
+        auto tree_contacts = sys.GetNcontacts();
+
+        ASSERT_GT(grid_pairs.size(), 0);
+        ASSERT_EQ(grid_pairs, tree_pairs);
+        ASSERT_EQ(grid_contacts, tree_contacts);
+    }
+}
@@ -0,0 +1,97 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for contact persistence in the Chrono collision system. A stack of
+// boxes resting on a fixed ground box is simulated with a warm-started PSOR
+// solver, with and without contact persistence. With persistent contacts, the
+// solver is initialized with the reactions from the previous step and requires
+// fewer iterations to reach the same tolerance.
+//
+// =============================================================================
+
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+struct StackResults {
+    double height;          // height of top box
+    double avg_iterations;  // average number of solver iterations over the last steps
+    unsigned int num_persistent;
+};
+
+static StackResults SimulateStack(bool persistence) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto coll = chrono_types::make_shared<ChCollisionSystemChrono>();
+    coll->SetEnvelope(0.005);
+    coll->EnableContactPersistence(persistence);
+    sys.SetCollisionSystem(coll);
+
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(500);
+    solver->SetTolerance(1e-6);
+    solver->EnableWarmStart(true);
+    sys.SetSolver(solver);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(2, 0.2, 2, 1000, mat, ChCollisionSystemType::CHRONO);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::shared_ptr<ChBody> top;
+    for (int i = 0; i < 4; i++) {
+        top = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.2, 0.4, 1000, mat, ChCollisionSystemType::CHRONO);
+        top->SetPos(ChVector<>(0, 0.1 + 0.2 * i, 0));
+        sys.AddBody(top);
+    }
+
+    int num_steps = 0;
+    int num_iterations = 0;
+    while (sys.GetChTime() < 0.5) {
+        sys.DoStepDynamics(1e-3);
+        if (sys.GetChTime() > 0.4) {
+            num_steps++;
+            num_iterations += solver->GetIterations();
+        }
+    }
+
+    StackResults res;
+    res.height = top->GetPos().y();
+    res.avg_iterations = double(num_iterations) / num_steps;
+    res.num_persistent = coll->GetNumPersistentContacts();
+
+    return res;
+}
+
+TEST(ChCollisionSystemChrono, contact_persistence) {
+    auto ref = SimulateStack(false);
+    auto per = SimulateStack(true);
+
+    ASSERT_EQ(ref.num_persistent, 0);
+    ASSERT_GT(per.num_persistent, 0);
+
+    // Same resting configuration, with fewer solver iterations
+    ASSERT_NEAR(ref.height, per.height, 1e-3);
+    ASSERT_LT(per.avg_iterations, ref.avg_iterations);
+}
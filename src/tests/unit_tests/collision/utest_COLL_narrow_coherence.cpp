@@ -0,0 +1,132 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the narrowphase cache (temporal coherence) of the Chrono
+// collision system. A pile of spheres and boxes settles on a fixed ground box,
+// with and without reuse of cached narrowphase results; the final states must
+// agree. In a given configuration, a repeated collision detection pass must
+// reuse all cached results and produce the same contacts.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static void CreatePile(ChSystemNSC& sys, std::vector<std::shared_ptr<ChBody>>& bodies) {
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, mat, ChCollisionSystemType::CHRONO);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int i = 0; i < 50; i++) {
+        ChVector<> pos(-0.6 + 0.3 * (i % 5), 0.15 + 0.25 * (i / 25), -0.6 + 0.3 * ((i / 5) % 5));
+        std::shared_ptr<ChBody> body;
+        if (i % 2 == 0)
+            body = chrono_types::make_shared<ChBodyEasySphere>(0.1, 1000, mat, ChCollisionSystemType::CHRONO);
+        else
+            body = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.2, 0.2, 1000, mat, ChCollisionSystemType::CHRONO);
+        body->SetPos(pos);
+        body->SetRot(Q_from_AngY(0.2 * i));
+        sys.AddBody(body);
+        bodies.push_back(body);
+    }
+}
+
+static std::vector<ChVector<>> Settle(bool coherence) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto coll = chrono_types::make_shared<ChCollisionSystemChrono>();
+    coll->EnableNarrowphaseCoherence(coherence);
+    coll->SetNarrowphaseCoherenceTolerances(1e-8, 1e-8);
+    sys.SetCollisionSystem(coll);
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreatePile(sys, bodies);
+
+    while (sys.GetChTime() < 0.5)
+        sys.DoStepDynamics(1e-3);
+
+    std::vector<ChVector<>> pos;
+    for (const auto& body : bodies)
+        pos.push_back(body->GetPos());
+
+    return pos;
+}
+
+TEST(ChNarrowphase, coherence_simulation) {
+    auto pos_ref = Settle(false);
+    auto pos_coh = Settle(true);
+
+    for (size_t i = 0; i < pos_ref.size(); i++) {
+        ASSERT_NEAR(pos_ref[i].x(), pos_coh[i].x(), 1e-4);
+        ASSERT_NEAR(pos_ref[i].y(), pos_coh[i].y(), 1e-4);
+        ASSERT_NEAR(pos_ref[i].z(), pos_coh[i].z(), 1e-4);
+    }
+}
+
+TEST(ChNarrowphase, coherence_reuse) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto coll = chrono_types::make_shared<ChCollisionSystemChrono>();
+    sys.SetCollisionSystem(coll);
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreatePile(sys, bodies);
+
+    while (sys.GetChTime() < 0.2)
+        sys.DoStepDynamics(1e-3);
+
+    // Reference contacts, without cache
+    sys.ComputeCollisions();
+    auto num_contacts = sys.GetNcontacts();
+    auto num_pairs = coll->GetOverlappingPairs().size();
+    ASSERT_GT(num_contacts, 0);
+
+    // First pass fills the cache, second pass must reuse all cached results
+    coll->EnableNarrowphaseCoherence(true);
+    sys.ComputeCollisions();
+    ASSERT_EQ(coll->GetNumNarrowphaseReusedPairs(), 0);
+    ASSERT_EQ(sys.GetNcontacts(), num_contacts);
+
+    sys.ComputeCollisions();
+    ASSERT_EQ(coll->GetNumNarrowphaseReusedPairs(), num_pairs);
+    ASSERT_EQ(sys.GetNcontacts(), num_contacts);
+
+    // Rigidly moving the entire system does not invalidate the cache
+    for (auto body : sys.Get_bodylist()) {
+        body->SetPos(body->GetPos() + ChVector<>(1, 2, 3));
+    }
+    sys.ComputeCollisions();
+    ASSERT_EQ(coll->GetNumNarrowphaseReusedPairs(), num_pairs);
+    ASSERT_EQ(sys.GetNcontacts(), num_contacts);
+
+    // Moving a single body invalidates all pairs involving that body
+    bodies[0]->SetPos(bodies[0]->GetPos() + ChVector<>(0, 0.01, 0));
+    sys.ComputeCollisions();
+    ASSERT_LT(coll->GetNumNarrowphaseReusedPairs(), num_pairs);
+}
@@ -0,0 +1,100 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for bulk insertion of SMC contacts reported by the Chrono collision
+// system. A pile of spheres settles in a fixed box; the simulation is run with
+// a single thread (contacts added one at a time) and with multiple threads
+// (contact forces evaluated in parallel). Contacts and final states must agree.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+struct PileResults {
+    int num_contacts;
+    std::vector<ChVector<>> pos;
+    std::vector<ChVector<>> force;
+};
+
+static PileResults SimulatePile(int num_threads, bool stiff_contact) {
+    ChSystemSMC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.SetCollisionSystem(chrono_types::make_shared<ChCollisionSystemChrono>());
+    sys.SetNumThreads(num_threads);
+    sys.SetStiffContact(stiff_contact);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetYoungModulus(1e7f);
+    mat->SetFriction(0.4f);
+    mat->SetRestitution(0.1f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(2, 0.2, 2, 1000, mat, ChCollisionSystemType::CHRONO);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> balls;
+    for (int i = 0; i < 125; i++) {
+        auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.05, 1000, mat, ChCollisionSystemType::CHRONO);
+        ball->SetPos(ChVector<>(-0.2 + 0.1 * (i % 5) + 0.01 * (i / 25), 0.06 + 0.099 * (i / 25),
+                                -0.2 + 0.1 * ((i / 5) % 5)));
+        sys.AddBody(ball);
+        balls.push_back(ball);
+    }
+
+    while (sys.GetChTime() < 0.1)
+        sys.DoStepDynamics(1e-4);
+
+    PileResults res;
+    res.num_contacts = sys.GetNcontacts();
+    sys.GetContactContainer()->ComputeContactForces();
+    for (const auto& ball : balls) {
+        res.pos.push_back(ball->GetPos());
+        res.force.push_back(sys.GetContactContainer()->GetContactableForce(ball.get()));
+    }
+
+    return res;
+}
+
+static void CompareResults(const PileResults& ref, const PileResults& par) {
+    ASSERT_GT(ref.num_contacts, 0);
+    ASSERT_EQ(ref.num_contacts, par.num_contacts);
+    for (size_t i = 0; i < ref.pos.size(); i++) {
+        ASSERT_NEAR(ref.pos[i].x(), par.pos[i].x(), 1e-6);
+        ASSERT_NEAR(ref.pos[i].y(), par.pos[i].y(), 1e-6);
+        ASSERT_NEAR(ref.pos[i].z(), par.pos[i].z(), 1e-6);
+        ASSERT_NEAR(ref.force[i].Length(), par.force[i].Length(), 1e-3 * (1 + ref.force[i].Length()));
+    }
+}
+
+TEST(ChContactContainerSMC, bulk_contacts) {
+    auto ref = SimulatePile(1, false);
+    auto par = SimulatePile(4, false);
+    CompareResults(ref, par);
+}
+
+TEST(ChContactContainerSMC, bulk_contacts_stiff) {
+    auto ref = SimulatePile(1, true);
+    auto par = SimulatePile(4, true);
+    CompareResults(ref, par);
+}
@@ -0,0 +1,186 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for serialization of arrays of doubles (Eigen matrices and
+// std::vector<double>). Binary archives write such arrays as contiguous blocks;
+// the result must be identical to element-by-element serialization. Round
+// trips are tested with binary and JSON archives.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChMatrix.h"
+#include "chrono/core/ChMatrix33.h"
+#include "chrono/core/ChQuaternion.h"
+#include "chrono/core/ChVector.h"
+#include "chrono/serialization/ChArchiveBinary.h"
+#include "chrono/serialization/ChArchiveJSON.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+struct ArchiveData {
+    ArchiveData() : vec_dyn(7), mat_dyn(3, 5), vec_std(11) {}
+
+    void Fill() {
+        for (int i = 0; i < vec_dyn.size(); i++)
+            vec_dyn(i) = 0.1 * i - 0.3;
+        for (int i = 0; i < mat_dyn.rows(); i++)
+            for (int j = 0; j < mat_dyn.cols(); j++)
+                mat_dyn(i, j) = 10.0 * i + j + 0.25;
+        mat33 = ChMatrix33<>(ChQuaternion<>(0.5, 0.5, 0.5, 0.5));
+        vec3 = ChVector<>(1.5, -2.5, 3.5);
+        for (size_t i = 0; i < vec_std.size(); i++)
+            vec_std[i] = 1.0 / (i + 1.0);
+        vec_int = {3, 1, 4, 1, 5};
+        name = "archive";
+    }
+
+    void ArchiveOUT(ChArchiveOut& marchive) {
+        marchive << CHNVP(vec_dyn);
+        marchive << CHNVP(mat_dyn);
+        marchive << CHNVP(mat33);
+        marchive << CHNVP(vec3);
+        marchive << CHNVP(vec_std);
+        marchive << CHNVP(vec_int);
+        marchive << CHNVP(name);
+    }
+
+    void ArchiveIN(ChArchiveIn& marchive) {
+        marchive >> CHNVP(vec_dyn);
+        marchive >> CHNVP(mat_dyn);
+        marchive >> CHNVP(mat33);
+        marchive >> CHNVP(vec3);
+        marchive >> CHNVP(vec_std);
+        marchive >> CHNVP(vec_int);
+        marchive >> CHNVP(name);
+    }
+
+    ChVectorDynamic<> vec_dyn;
+    ChMatrixDynamic<> mat_dyn;
+    ChMatrix33<> mat33;
+    ChVector<> vec3;
+    std::vector<double> vec_std;
+    std::vector<int> vec_int;
+    std::string name;
+};
+
+static void Compare(const ArchiveData& a, const ArchiveData& b) {
+    ASSERT_EQ(a.vec_dyn, b.vec_dyn);
+    ASSERT_EQ(a.mat_dyn.rows(), b.mat_dyn.rows());
+    ASSERT_EQ(a.mat_dyn.cols(), b.mat_dyn.cols());
+    ASSERT_EQ(a.mat_dyn, b.mat_dyn);
+    ASSERT_EQ(a.mat33, b.mat33);
+    ASSERT_EQ(a.vec3, b.vec3);
+    ASSERT_EQ(a.vec_std, b.vec_std);
+    ASSERT_EQ(a.vec_int, b.vec_int);
+    ASSERT_EQ(a.name, b.name);
+}
+
+TEST(ChArchive, binary_block) {
+    // A std::vector<double> (written as a block) and a fixed-size array (written element by element)
+    std::vector<double> vec_std = {1.0, -2.0, 3.5, 1e-20, 7e30};
+    double vec_arr[5] = {1.0, -2.0, 3.5, 1e-20, 7e30};
+
+    std::vector<char> buffer_std;
+    std::vector<char> buffer_arr;
+    {
+        ChStreamOutBinaryVector stream_std(&buffer_std);
+        ChArchiveOutBinary archive_std(stream_std);
+        archive_std << CHNVP(vec_std);
+
+        ChStreamOutBinaryVector stream_arr(&buffer_arr);
+        ChArchiveOutBinary archive_arr(stream_arr);
+        archive_arr << CHNVP(vec_arr);
+    }
+
+    ASSERT_EQ(buffer_std, buffer_arr);
+}
+
+TEST(ChArchive, binary_roundtrip) {
+    ArchiveData out;
+    out.Fill();
+
+    std::vector<char> buffer;
+    {
+        ChStreamOutBinaryVector stream(&buffer);
+        ChArchiveOutBinary archive(stream);
+        out.ArchiveOUT(archive);
+    }
+
+    ArchiveData in;
+    {
+        ChStreamInBinaryVector stream(&buffer);
+        ChArchiveInBinary archive(stream);
+        in.ArchiveIN(archive);
+    }
+
+    Compare(out, in);
+}
+
+TEST(ChArchive, binary_file_roundtrip) {
+    const std::string filename = "archive_test.dat";
+
+    ArchiveData out;
+    out.Fill();
+    {
+        ChStreamOutBinaryFile stream(filename.c_str());
+        ChArchiveOutBinary archive(stream);
+        out.ArchiveOUT(archive);
+    }
+
+    ArchiveData in;
+    {
+        ChStreamInBinaryFile stream(filename.c_str());
+        ChArchiveInBinary archive(stream);
+        in.ArchiveIN(archive);
+    }
+
+    std::remove(filename.c_str());
+
+    Compare(out, in);
+}
+
+TEST(ChArchive, json_roundtrip) {
+    const std::string filename = "archive_test.json";
+
+    ArchiveData out;
+    out.Fill();
+    {
+        ChStreamOutAsciiFile stream(filename.c_str());
+        stream.SetNumFormat("%.17g");
+        ChArchiveOutJSON archive(stream);
+        out.ArchiveOUT(archive);
+    }
+
+    ArchiveData in;
+    {
+        ChStreamInAsciiFile stream(filename.c_str());
+        ChArchiveInJSON archive(stream);
+        in.ArchiveIN(archive);
+    }
+
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(out.vec_std.size(), in.vec_std.size());
+    for (size_t i = 0; i < out.vec_std.size(); i++)
+        ASSERT_NEAR(out.vec_std[i], in.vec_std[i], 1e-12);
+    ASSERT_TRUE(out.mat_dyn.equals(in.mat_dyn, 1e-12));
+    ASSERT_TRUE(out.vec_dyn.equals(in.vec_dyn, 1e-12));
+    ASSERT_EQ(out.vec_int, in.vec_int);
+}
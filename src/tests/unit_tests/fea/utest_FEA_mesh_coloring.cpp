@@ -0,0 +1,99 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the colored (lock-free) multithreaded element loops in ChMesh.
+// The residual terms F (internal and gravity forces) and M*w of a deformed ANCF
+// shell plate are loaded serially and with multiple threads; results must agree
+// up to round-off (contributions are accumulated in a different order).
+//
+// =============================================================================
+
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono/fea/ChElementShellANCF_3423.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+TEST(ChMesh, element_coloring) {
+    const int num_x = 12;
+    const int num_y = 8;
+    const double dx = 0.1;
+    const double dy = 0.1;
+
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    for (int j = 0; j <= num_y; j++) {
+        for (int i = 0; i <= num_x; i++) {
+            // Perturb node positions and directions, so that internal forces are not zero
+            ChVector<> pos(i * dx, j * dy, 0.01 * std::sin(1.0 * i + 2.0 * j));
+            ChVector<> dir(0.05 * std::cos(3.0 * i), 0.05 * std::sin(2.0 * j), 1);
+            auto node = chrono_types::make_shared<ChNodeFEAxyzD>(pos, dir.GetNormalized());
+            node->SetPos_dt(ChVector<>(0.1 * i, -0.2 * j, 0.3));
+            if (i == 0)
+                node->SetFixed(true);
+            mesh->AddNode(node);
+        }
+    }
+
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+
+    for (int j = 0; j < num_y; j++) {
+        for (int i = 0; i < num_x; i++) {
+            int n0 = j * (num_x + 1) + i;
+            auto element = chrono_types::make_shared<ChElementShellANCF_3423>();
+            element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0 + 1)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0 + num_x + 2)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0 + num_x + 1)));
+            element->SetDimensions(dx, dy);
+            element->AddLayer(0.01, 0, mat);
+            element->SetAlphaDamp(0.05);
+            mesh->AddElement(element);
+        }
+    }
+
+    sys.Add(mesh);
+    sys.Setup();
+    sys.Update();
+
+    // Quadrilateral elements of a structured grid require exactly 4 colors
+    ASSERT_EQ(mesh->GetNumElementColors(), 4);
+
+    int n = sys.GetNcoords_w();
+    ChVectorDynamic<> w(n);
+    for (int k = 0; k < n; k++)
+        w(k) = std::sin(0.3 * k);
+
+    ChVectorDynamic<> F[2];
+    ChVectorDynamic<> Mw[2];
+    int nthreads[2] = {1, 4};
+    for (int k = 0; k < 2; k++) {
+        sys.SetNumThreads(nthreads[k]);
+        F[k].setZero(n);
+        sys.LoadResidual_F(F[k], 1.0);
+        Mw[k].setZero(n);
+        sys.LoadResidual_Mv(Mw[k], w, 1.0);
+    }
+
+    ASSERT_GT(F[0].norm(), 0.0);
+    ASSERT_GT(Mw[0].norm(), 0.0);
+    ASSERT_LE((F[0] - F[1]).norm(), 1e-12 * F[0].norm());
+    ASSERT_LE((Mw[0] - Mw[1]).norm(), 1e-12 * Mw[0].norm());
+}
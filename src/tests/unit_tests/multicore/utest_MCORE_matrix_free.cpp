@@ -0,0 +1,115 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Chrono::Multicore unit test for the matrix-free contact Jacobian (NSC).
+// A pile of balls, one of them attached to ground through a revolute joint,
+// is simulated with the assembled and with the matrix-free contact Jacobian,
+// for all solver modes. Body states and contact forces must match.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_multicore/physics/ChSystemMulticore.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+
+struct PileState {
+    std::vector<ChVector<>> pos;
+    std::vector<ChVector<>> vel;
+    ChVector<> ground_force;
+};
+
+static PileState SimulatePile(SolverMode mode, bool matrix_free) {
+    ChSystemMulticoreNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.GetSettings()->solver.solver_mode = mode;
+    sys.GetSettings()->solver.max_iteration_normal = (mode == SolverMode::NORMAL) ? 100 : 0;
+    sys.GetSettings()->solver.max_iteration_sliding = (mode == SolverMode::SLIDING) ? 100 : 0;
+    sys.GetSettings()->solver.max_iteration_spinning = (mode == SolverMode::SPINNING) ? 100 : 0;
+    sys.GetSettings()->solver.max_iteration_bilateral = 50;
+    sys.GetSettings()->solver.tolerance = 1e-8;
+    sys.GetSettings()->solver.matrix_free = matrix_free;
+    sys.ChangeSolverType(SolverType::APGD);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+    mat->SetRollingFriction(0.01f);
+    mat->SetSpinningFriction(0.01f);
+
+    auto ground = utils::CreateBoxContainer(&sys, 0, mat, ChVector<>(4, 4, 2), 0.1, ChVector<>(0, 0, 0),
+                                            ChQuaternion<>(1, 0, 0, 0), true, true, false, false);
+
+    double radius = 0.25;
+    std::vector<std::shared_ptr<ChBody>> balls;
+    for (int ix = 0; ix < 3; ix++) {
+        for (int iz = 0; iz < 3; iz++) {
+            for (int iy = 0; iy < 2; iy++) {
+                auto ball = std::shared_ptr<ChBody>(sys.NewBody());
+                ball->SetMass(1);
+                ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetPos(ChVector<>(0.6 * ix + 0.05 * iy, 0.3 + 0.55 * iy, 0.6 * iz + 0.02 * ix));
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), mat, radius);
+                ball->GetCollisionModel()->BuildModel();
+                sys.AddBody(ball);
+                balls.push_back(ball);
+            }
+        }
+    }
+
+    // Attach the last ball to ground so that bilateral constraints are also present
+    auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+    joint->Initialize(balls.back(), ground, ChCoordsys<>(balls.back()->GetPos() + ChVector<>(0.4, 0, 0)));
+    sys.AddLink(joint);
+
+    while (sys.GetChTime() < 0.2) {
+        sys.DoStepDynamics(1e-3);
+    }
+
+    PileState state;
+    for (const auto& ball : balls) {
+        state.pos.push_back(ball->GetPos());
+        state.vel.push_back(ball->GetPos_dt());
+    }
+    sys.GetContactContainer()->ComputeContactForces();
+    state.ground_force = ground->GetContactForce();
+
+    return state;
+}
+
+class MatrixFreeTest : public ::testing::TestWithParam<SolverMode> {};
+
+TEST_P(MatrixFreeTest, simulate) {
+    auto ref = SimulatePile(GetParam(), false);
+    auto test = SimulatePile(GetParam(), true);
+
+    ASSERT_EQ(ref.pos.size(), test.pos.size());
+    for (size_t i = 0; i < ref.pos.size(); i++) {
+        Assert_near(ref.pos[i], test.pos[i], 1e-6);
+        Assert_near(ref.vel[i], test.vel[i], 1e-5);
+    }
+    ASSERT_GT(ref.ground_force.Length(), 0);
+    ASSERT_LT((ref.ground_force - test.ground_force).Length(), 1e-4 * ref.ground_force.Length());
+}
+
+INSTANTIATE_TEST_SUITE_P(ChronoMulticore,
+                         MatrixFreeTest,
+                         ::testing::Values(SolverMode::NORMAL, SolverMode::SLIDING, SolverMode::SPINNING));
@@ -0,0 +1,101 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Chrono::Multicore unit test for the mixed-precision Schur product (NSC).
+// A pile of balls is simulated with double and mixed-precision solver products
+// and with different solvers. Body states must match to single precision and
+// the cumulative contact force on the container must balance the weight.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_multicore/physics/ChSystemMulticore.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+
+struct PileState {
+    std::vector<ChVector<>> pos;
+    ChVector<> ground_force;
+    double weight;
+};
+
+static PileState SimulatePile(SolverType type, bool mixed_precision) {
+    ChSystemMulticoreNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    sys.GetSettings()->solver.max_iteration_normal = 0;
+    sys.GetSettings()->solver.max_iteration_sliding = 100;
+    sys.GetSettings()->solver.max_iteration_spinning = 0;
+    sys.GetSettings()->solver.tolerance = 1e-6;
+    sys.GetSettings()->solver.mixed_precision = mixed_precision;
+    sys.ChangeSolverType(type);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = utils::CreateBoxContainer(&sys, 0, mat, ChVector<>(4, 4, 2), 0.1, ChVector<>(0, 0, 0),
+                                            ChQuaternion<>(1, 0, 0, 0), true, true, false, false);
+
+    double radius = 0.25;
+    std::vector<std::shared_ptr<ChBody>> balls;
+    for (int ix = 0; ix < 4; ix++) {
+        for (int iz = 0; iz < 4; iz++) {
+            auto ball = std::shared_ptr<ChBody>(sys.NewBody());
+            ball->SetMass(1);
+            ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+            ball->SetPos(ChVector<>(0.6 * ix, 0.3 + 0.05 * iz, 0.6 * iz));
+            ball->SetCollide(true);
+            ball->GetCollisionModel()->ClearModel();
+            utils::AddSphereGeometry(ball.get(), mat, radius);
+            ball->GetCollisionModel()->BuildModel();
+            sys.AddBody(ball);
+            balls.push_back(ball);
+        }
+    }
+
+    while (sys.GetChTime() < 0.5) {
+        sys.DoStepDynamics(1e-3);
+    }
+
+    PileState state;
+    for (const auto& ball : balls)
+        state.pos.push_back(ball->GetPos());
+    sys.GetContactContainer()->ComputeContactForces();
+    state.ground_force = ground->GetContactForce();
+    state.weight = 9.81 * balls.size();
+
+    return state;
+}
+
+class MixedPrecisionTest : public ::testing::TestWithParam<SolverType> {};
+
+TEST_P(MixedPrecisionTest, simulate) {
+    auto ref = SimulatePile(GetParam(), false);
+    auto test = SimulatePile(GetParam(), true);
+
+    ASSERT_EQ(ref.pos.size(), test.pos.size());
+    for (size_t i = 0; i < ref.pos.size(); i++) {
+        Assert_near(ref.pos[i], test.pos[i], 1e-4);
+    }
+    ASSERT_NEAR(test.ground_force.y(), -test.weight, 1e-3 * test.weight);
+}
+
+INSTANTIATE_TEST_SUITE_P(ChronoMulticore,
+                         MixedPrecisionTest,
+                         ::testing::Values(SolverType::APGD, SolverType::BB));
@@ -0,0 +1,149 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Chrono::Multicore unit test for NUMA-aware placement of host arrays.
+// Array contents must be preserved by placement, including after reallocation,
+// resizing, or a change in the number of threads, for arrays smaller and larger
+// than a memory page. Arrays must not be placed again when resized within
+// their capacity. Thread pinning must leave the calling thread unpinned and
+// unpinning must restore the original affinity of all threads.
+//
+// =============================================================================
+
+#include <vector>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "chrono/multicore_math/real3.h"
+
+#include "chrono_multicore/ChNUMAPlacement.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static std::vector<real3> CreateArray(size_t n) {
+    std::vector<real3> v(n);
+    for (size_t i = 0; i < n; i++)
+        v[i] = real3(real(i), real(2 * i), real(3 * i));
+    return v;
+}
+
+static void CheckArray(const std::vector<real3>& v) {
+    for (size_t i = 0; i < v.size(); i++) {
+        ASSERT_EQ(v[i].x, real(i)) << "element " << i;
+        ASSERT_EQ(v[i].y, real(2 * i)) << "element " << i;
+        ASSERT_EQ(v[i].z, real(3 * i)) << "element " << i;
+    }
+}
+
+TEST(ChNUMAPlacement, contents) {
+    ChNUMAPlacement placement;
+
+    for (size_t n : {0, 5, 1000, 123457}) {
+        auto v = CreateArray(n);
+        placement.Place(v, 4);
+        CheckArray(v);
+    }
+
+    std::vector<double> w(100000, 1.5);
+    placement.Place(&w, w.data(), w.capacity(), sizeof(double), 4);
+    for (size_t i = 0; i < w.size(); i++)
+        ASSERT_EQ(w[i], 1.5);
+}
+
+TEST(ChNUMAPlacement, reallocation) {
+    ChNUMAPlacement placement;
+
+    auto v = CreateArray(20000);
+    placement.Place(v, 4);
+    CheckArray(v);
+
+    // Placing again without reallocation leaves the array unchanged
+    ASSERT_FALSE(placement.Place(v, 4));
+    CheckArray(v);
+
+    // Grow the array (reallocation) and place again
+    v.reserve(3 * v.capacity());
+    for (size_t i = v.size(); i < 50000; i++)
+        v.push_back(real3(real(i), real(2 * i), real(3 * i)));
+    placement.Place(v, 4);
+    CheckArray(v);
+}
+
+TEST(ChNUMAPlacement, resize) {
+    ChNUMAPlacement placement;
+
+    auto v = CreateArray(20000);
+    v.reserve(60000);
+    placement.Place(v, 4);
+    CheckArray(v);
+
+    // Grow and shrink the array within its capacity (no reallocation): it is not placed again
+    for (size_t i = v.size(); i < 50000; i++)
+        v.push_back(real3(real(i), real(2 * i), real(3 * i)));
+    ASSERT_FALSE(placement.Place(v, 4));
+    CheckArray(v);
+
+    v.resize(30000);
+    ASSERT_FALSE(placement.Place(v, 4));
+    CheckArray(v);
+
+    // Place for a different number of threads
+#ifdef __linux__
+    ASSERT_TRUE(placement.Place(v, 3));
+#else
+    placement.Place(v, 3);
+#endif
+    CheckArray(v);
+}
+
+#if defined(__linux__) && defined(_OPENMP)
+
+static bool SameAffinity(const cpu_set_t& a, const cpu_set_t& b) {
+    return CPU_EQUAL(&a, &b) != 0;
+}
+
+TEST(ChNUMAPlacement, pinning) {
+    cpu_set_t original;
+    CPU_ZERO(&original);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(original), &original), 0);
+
+    ASSERT_TRUE(ChNUMAPlacement::PinThreads(4));
+
+    // The calling thread keeps its affinity
+    cpu_set_t current;
+    CPU_ZERO(&current);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(current), &current), 0);
+    ASSERT_TRUE(SameAffinity(original, current));
+
+    // Unpinning restores the original affinity of all threads
+    ASSERT_TRUE(ChNUMAPlacement::UnpinThreads(4));
+    bool restored = true;
+#pragma omp parallel num_threads(4) reduction(&& : restored)
+    {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        restored = sched_getaffinity(0, sizeof(mask), &mask) == 0 && SameAffinity(original, mask);
+    }
+    ASSERT_TRUE(restored);
+}
+
+#endif
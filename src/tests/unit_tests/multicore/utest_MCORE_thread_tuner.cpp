@@ -0,0 +1,93 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Chrono::Multicore unit test for the per-phase thread tuner.
+// Synthetic phase timings with a known optimum are fed to the tuner, which must
+// select the fastest thread count for each phase. The tuned profile is written
+// to file and read back in a new tuner.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "chrono_multicore/ChThreadTuner.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Synthetic phase time, minimal for the specified optimal number of threads
+static double PhaseTime(int nthreads, int optimal) {
+    return 1e-3 * (1 + std::abs(std::log2((double)nthreads / optimal)));
+}
+
+TEST(ChThreadTuner, tuning) {
+    const int optimal[ChThreadTuner::NUM_PHASES] = {4, 1, 8, 2};
+
+    ChThreadTuner tuner;
+    tuner.Initialize(1, 8, 5);
+    ASSERT_FALSE(tuner.IsTuned());
+
+    int steps = 0;
+    while (!tuner.IsTuned()) {
+        for (int i = 0; i < ChThreadTuner::NUM_PHASES; i++) {
+            auto phase = static_cast<ChThreadTuner::Phase>(i);
+            tuner.AddSample(phase, PhaseTime(tuner.GetNumThreads(phase), optimal[i]));
+        }
+        ASSERT_LT(++steps, 100);
+    }
+
+    // 4 candidates (1, 2, 4, 8), each with one warm-up and 5 timed steps
+    ASSERT_EQ(steps, 24);
+    for (int i = 0; i < ChThreadTuner::NUM_PHASES; i++) {
+        ASSERT_EQ(tuner.GetNumThreads(static_cast<ChThreadTuner::Phase>(i)), optimal[i]);
+    }
+
+    // Save the profile and load it in a new tuner
+    const char* filename = "thread_profile.txt";
+    ASSERT_TRUE(tuner.WriteProfile(filename));
+
+    ChThreadTuner other;
+    other.Initialize(1, 16);
+    ASSERT_TRUE(other.ReadProfile(filename));
+    std::remove(filename);
+
+    ASSERT_TRUE(other.IsTuned());
+    for (int i = 0; i < ChThreadTuner::NUM_PHASES; i++) {
+        ASSERT_EQ(other.GetNumThreads(static_cast<ChThreadTuner::Phase>(i)), optimal[i]);
+    }
+}
+
+TEST(ChThreadTuner, incomplete_profile) {
+    const char* filename = "thread_profile_incomplete.txt";
+    {
+        std::ofstream file(filename);
+        file << "update 4" << std::endl;
+        file << "broadphase 2" << std::endl;
+    }
+
+    ChThreadTuner tuner;
+    tuner.Initialize(2, 6);
+    ASSERT_FALSE(tuner.ReadProfile(filename));
+    std::remove(filename);
+
+    // A tuner that failed to load a profile is still tuning, starting at the lower limit
+    ASSERT_FALSE(tuner.IsTuned());
+    ASSERT_FALSE(tuner.WriteProfile(filename));
+    for (int i = 0; i < ChThreadTuner::NUM_PHASES; i++) {
+        ASSERT_EQ(tuner.GetNumThreads(static_cast<ChThreadTuner::Phase>(i)), 2);
+    }
+}
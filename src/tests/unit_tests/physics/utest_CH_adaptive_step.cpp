@@ -0,0 +1,114 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the error-based adaptive step size control of the HHT and Euler
+// implicit integrators. A mass-spring oscillator is integrated with large output
+// steps and compared against the analytical solution; at rest, each output step
+// must be covered by a single internal step.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Spring stiffness (unit mass), natural frequency, and initial elongation
+static const double k = 100;
+static const double omega = 10;
+
+static void Oscillator(ChSystemNSC& sys, double elongation, std::shared_ptr<ChBody>& body) {
+    sys.Set_G_acc(ChVector<>(0, 0, 0));
+    sys.SetSolver(chrono_types::make_shared<ChSolverSparseQR>());
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    body = chrono_types::make_shared<ChBody>();
+    body->SetMass(1);
+    body->SetPos(ChVector<>(1 + elongation, 0, 0));
+    sys.AddBody(body);
+
+    auto spring = chrono_types::make_shared<ChLinkTSDA>();
+    spring->Initialize(ground, body, false, ChVector<>(0, 0, 0), body->GetPos());
+    spring->SetRestLength(1);
+    spring->SetSpringCoefficient(k);
+    sys.AddLink(spring);
+}
+
+template <typename Integrator>
+static void CheckAdaptive(std::shared_ptr<Integrator> integrator) {
+    const double dt = 0.05;
+    const double A = 0.1;
+
+    // Oscillator: compare against analytical solution x(t) = 1 + A*cos(omega*t)
+    {
+        ChSystemNSC sys;
+        std::shared_ptr<ChBody> body;
+        Oscillator(sys, A, body);
+        integrator->SetIntegrable(&sys);
+        integrator->SetAdaptiveStepControl(true);
+        integrator->SetAdaptiveTolerances(1e-4, 1e-7);
+        sys.SetTimestepper(integrator);
+
+        int num_steps = 0;
+        while (sys.GetChTime() < 1.0 - 1e-8) {
+            sys.DoStepDynamics(dt);
+            num_steps += integrator->GetNumAcceptedSteps();
+            ASSERT_NEAR(sys.GetChTime(), dt * std::round(sys.GetChTime() / dt), 1e-12);
+            ASSERT_NEAR(body->GetPos().x(), 1 + A * std::cos(omega * sys.GetChTime()), 2e-3);
+        }
+
+        // The output step is too large for the requested accuracy
+        ASSERT_GT(num_steps, 20);
+    }
+
+    // Oscillator at rest: the error controller must reach the output step size
+    {
+        ChSystemNSC sys;
+        std::shared_ptr<ChBody> body;
+        Oscillator(sys, 0, body);
+        integrator->SetIntegrable(&sys);
+        integrator->SetAdaptiveStepControl(true);
+        sys.SetTimestepper(integrator);
+
+        for (int i = 0; i < 20; i++) {
+            sys.DoStepDynamics(dt);
+            ASSERT_EQ(integrator->GetNumRejectedSteps(), 0);
+            if (i > 0)
+                ASSERT_EQ(integrator->GetNumAcceptedSteps(), 1);
+        }
+    }
+}
+
+TEST(ChTimestepper, adaptive_HHT) {
+    auto integrator = chrono_types::make_shared<ChTimestepperHHT>();
+    integrator->SetAlpha(0);
+    integrator->SetStepControl(false);
+    CheckAdaptive(integrator);
+}
+
+TEST(ChTimestepper, adaptive_EulerImplicit) {
+    auto integrator = chrono_types::make_shared<ChTimestepperEulerImplicit>();
+    integrator->SetMaxiters(10);
+    integrator->SetAbsTolerances(1e-12);
+    CheckAdaptive(integrator);
+}
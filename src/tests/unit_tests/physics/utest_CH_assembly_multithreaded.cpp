@@ -0,0 +1,85 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the multithreaded per-item loops in ChAssembly. A system with a
+// long chain of bodies connected by spherical joints and a set of free bodies
+// with applied forces is simulated with one and with multiple threads; since
+// each item only accesses its own data, the results must be identical.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static std::vector<ChVector<>> Simulate(int nthreads) {
+    ChSystemNSC sys;
+    sys.SetNumThreads(nthreads);
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto prev = ground;
+    for (int i = 0; i < 1200; i++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(i + 1.0, 0, 0));
+        body->SetMass(1.0 + 0.001 * i);
+        sys.AddBody(body);
+
+        auto joint = chrono_types::make_shared<ChLinkLockSpherical>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(i + 0.5, 0, 0)));
+        sys.AddLink(joint);
+
+        prev = body;
+    }
+
+    for (int i = 0; i < 1200; i++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(i, 5, 0));
+        body->SetWvel_loc(ChVector<>(0.01 * i, 1, 0));
+        body->Accumulate_force(ChVector<>(0, 0, 0.01 * i), body->GetPos(), false);
+        sys.AddBody(body);
+    }
+
+    EXPECT_GT((int)sys.Get_bodylist().size(), sys.GetAssembly().GetParallelThreshold());
+    EXPECT_GT((int)sys.Get_linklist().size(), sys.GetAssembly().GetParallelThreshold());
+
+    for (int i = 0; i < 20; i++)
+        sys.DoStepDynamics(1e-3);
+
+    std::vector<ChVector<>> pos;
+    for (const auto& body : sys.Get_bodylist())
+        pos.push_back(body->GetPos());
+
+    return pos;
+}
+
+TEST(ChAssembly, multithreaded) {
+    auto pos1 = Simulate(1);
+    auto pos4 = Simulate(4);
+
+    ASSERT_EQ(pos1.size(), pos4.size());
+    for (size_t i = 0; i < pos1.size(); i++) {
+        ASSERT_EQ(pos1[i].x(), pos4[i].x());
+        ASSERT_EQ(pos1[i].y(), pos4[i].y());
+        ASSERT_EQ(pos1[i].z(), pos4[i].z());
+    }
+}
@@ -0,0 +1,169 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for binary checkpoint/restart of the system state. A checkpoint
+// is written half-way through a simulation and a second, identically
+// constructed system is restarted from it; continuing both simulations must
+// produce identical results. This is checked for a pendulum chain, with the
+// Euler linearized integrator and with HHT, and for spheres sliding on the
+// ground, with a warm-started iterative solver.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static const int num_links = 4;
+static const double step = 1e-3;
+
+static void CreateChain(ChSystemNSC& sys, bool hht) {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    if (hht) {
+        sys.SetSolver(chrono_types::make_shared<ChSolverSparseQR>());
+        auto integrator = chrono_types::make_shared<ChTimestepperHHT>(&sys);
+        integrator->SetAlpha(-0.2);
+        integrator->SetAdaptiveStepControl(true);
+        integrator->SetAdaptiveTolerances(1e-4, 1e-6);
+        sys.SetTimestepper(integrator);
+    } else {
+        auto solver = chrono_types::make_shared<ChSolverPSOR>();
+        solver->SetMaxIterations(50);
+        solver->SetTolerance(0);
+        solver->EnableWarmStart(true);
+        sys.SetSolver(solver);
+    }
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto prev = ground;
+    for (int il = 0; il < num_links; il++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(il + 1.0, 0, 0));
+        body->SetMass(1.0 + 0.2 * il);
+        sys.AddBody(body);
+
+        auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(il + 0.5, 0, 0)));
+        sys.AddLink(joint);
+
+        prev = body;
+    }
+}
+
+static void CreateSpheres(ChSystemNSC& sys) {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(20);
+    solver->SetTolerance(0);
+    solver->EnableWarmStart(true);
+    sys.SetSolver(solver);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int is = 0; is < 3; is++) {
+        auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.2, 1000, false, true, mat);
+        sphere->SetPos(ChVector<>(is - 1.0, 0.2, 0));
+        sphere->SetPos_dt(ChVector<>(1.0, 0, 0.5 * is));
+        sys.AddBody(sphere);
+    }
+}
+
+static void CheckRestart(std::function<void(ChSystemNSC&)> create, const std::string& filename) {
+    // Reference simulation, with a checkpoint half-way
+    ChSystemNSC sys;
+    create(sys);
+    for (int i = 0; i < 200; i++)
+        sys.DoStepDynamics(step);
+    ASSERT_TRUE(utils::WriteCheckpointBinary(&sys, filename));
+    double time_checkpoint = sys.GetChTime();
+    for (int i = 0; i < 200; i++)
+        sys.DoStepDynamics(step);
+
+    // Restarted simulation
+    ChSystemNSC sys_restart;
+    create(sys_restart);
+    ASSERT_TRUE(utils::ReadCheckpointBinary(&sys_restart, filename));
+    ASSERT_EQ(sys_restart.GetChTime(), time_checkpoint);
+    for (int i = 0; i < 200; i++)
+        sys_restart.DoStepDynamics(step);
+
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(sys.GetChTime(), sys_restart.GetChTime());
+    ASSERT_EQ(sys.GetStepcount(), sys_restart.GetStepcount());
+    ASSERT_EQ(sys.GetNcontacts(), sys_restart.GetNcontacts());
+    for (size_t i = 0; i < sys.Get_bodylist().size(); i++) {
+        auto body = sys.Get_bodylist()[i];
+        auto body_restart = sys_restart.Get_bodylist()[i];
+        ASSERT_EQ(body->GetPos(), body_restart->GetPos());
+        ASSERT_EQ(body->GetRot(), body_restart->GetRot());
+        ASSERT_EQ(body->GetPos_dt(), body_restart->GetPos_dt());
+        ASSERT_EQ(body->GetContactForce(), body_restart->GetContactForce());
+    }
+    for (size_t i = 0; i < sys.Get_linklist().size(); i++) {
+        ASSERT_EQ(sys.Get_linklist()[i]->Get_react_force(), sys_restart.Get_linklist()[i]->Get_react_force());
+    }
+}
+
+TEST(ChSystem, checkpoint_euler) {
+    CheckRestart([](ChSystemNSC& sys) { CreateChain(sys, false); }, "checkpoint_euler.dat");
+}
+
+TEST(ChSystem, checkpoint_hht) {
+    CheckRestart([](ChSystemNSC& sys) { CreateChain(sys, true); }, "checkpoint_hht.dat");
+}
+
+TEST(ChSystem, checkpoint_contacts) {
+    CheckRestart(CreateSpheres, "checkpoint_contacts.dat");
+}
+
+TEST(ChSystem, checkpoint_inconsistent) {
+    const std::string filename = "checkpoint_inconsistent.dat";
+
+    ChSystemNSC sys;
+    CreateChain(sys, false);
+    sys.DoStepDynamics(step);
+    ASSERT_TRUE(utils::WriteCheckpointBinary(&sys, filename));
+
+    // A system with a different configuration cannot be restarted from this checkpoint
+    ChSystemNSC sys_other;
+    CreateChain(sys_other, false);
+    sys_other.AddBody(chrono_types::make_shared<ChBody>());
+    ASSERT_FALSE(utils::ReadCheckpointBinary(&sys_other, filename));
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,118 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the pooled NSC contact container. A pile of spheres is settled
+// on a fixed box, once with the default (list-based) contact container and once
+// with the pooled container. Since contacts are stored in the same order, the
+// two simulations must produce identical results.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSCpooled.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+struct PileResults {
+    std::vector<ChVector<>> pos;
+    std::vector<int> ncontacts;
+    ChVector<> ground_force;
+};
+
+static PileResults SettlePile(bool pooled) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    if (pooled)
+        sys.SetContactContainer(chrono_types::make_shared<ChContactContainerNSCpooled>());
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> spheres;
+    for (int ix = 0; ix < 3; ix++) {
+        for (int iy = 0; iy < 3; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.1, 1000, false, true, mat);
+                sphere->SetPos(ChVector<>(-0.2 + 0.21 * ix + 0.01 * iy, 0.1 + 0.21 * iy, -0.2 + 0.21 * iz));
+                sys.AddBody(sphere);
+                spheres.push_back(sphere);
+            }
+        }
+    }
+
+    PileResults res;
+    while (sys.GetChTime() < 0.5) {
+        sys.DoStepDynamics(1e-3);
+        res.ncontacts.push_back(sys.GetNcontacts());
+    }
+
+    for (const auto& sphere : spheres)
+        res.pos.push_back(sphere->GetPos());
+    res.ground_force = sys.GetContactContainer()->GetContactableForce(ground.get());
+
+    return res;
+}
+
+TEST(ChContactContainerNSCpooled, consistency) {
+    auto res_list = SettlePile(false);
+    auto res_pool = SettlePile(true);
+
+    ASSERT_EQ(res_list.ncontacts, res_pool.ncontacts);
+
+    for (size_t i = 0; i < res_list.pos.size(); i++) {
+        ASSERT_EQ(res_list.pos[i].x(), res_pool.pos[i].x());
+        ASSERT_EQ(res_list.pos[i].y(), res_pool.pos[i].y());
+        ASSERT_EQ(res_list.pos[i].z(), res_pool.pos[i].z());
+    }
+
+    // Contact forces are accumulated in a different order
+    ASSERT_NEAR(res_list.ground_force.y(), res_pool.ground_force.y(), 1e-8 * std::abs(res_list.ground_force.y()));
+}
+
+TEST(ChContactContainerNSCpooled, contact_data) {
+    ChSystemNSC sys;
+    auto container = chrono_types::make_shared<ChContactContainerNSCpooled>();
+    sys.SetContactContainer(container);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.1, 1000, false, true, mat);
+    sphere->SetPos(ChVector<>(0, 0.099, 0));
+    sys.AddBody(sphere);
+
+    sys.DoStepDynamics(1e-3);
+
+    const auto& data = container->GetContactData();
+    ASSERT_EQ(container->GetNcontacts(), 1);
+    ASSERT_EQ(data.p1.size(), 1);
+    ASSERT_EQ(data.offset_L[0], 0);
+    ASSERT_NEAR(std::abs(data.normal[0].y()), 1.0, 1e-6);
+    ASSERT_LT(data.distance[0], 0.0);
+    ASSERT_GT(data.force[0].x(), 0.0);
+}
@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the capture and replay of solver problems. A pile of boxes on a
+// fixed ground is settled (with PSOR) and the problem of one step, solved with
+// the solver under test, is captured to a file.
+// The problem read back from file is solved with the same solver settings and
+// the solution must match the one obtained in the simulation.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <string>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDescriptorCapture.h"
+#include "chrono/solver/ChSolverAPGD.h"
+#include "chrono/solver/ChSolverBB.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static void CreatePile(ChSystemNSC& sys) {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int ix = 0; ix < 3; ix++) {
+        for (int iy = 0; iy < 3; iy++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.2, 0.2, 1000, false, true, mat);
+            box->SetPos(ChVector<>(-0.25 + 0.25 * ix + 0.02 * iy, 0.1 + 0.21 * iy, 0.01 * ix));
+            box->SetRot(Q_from_AngY(0.1 * (ix + iy)));
+            sys.AddBody(box);
+        }
+    }
+}
+
+template <typename SOLVER>
+static void CheckReplay(const std::string& name) {
+    ChSystemNSC sys;
+    auto settle_solver = chrono_types::make_shared<ChSolverPSOR>();
+    settle_solver->SetMaxIterations(50);
+    sys.SetSolver(settle_solver);
+    CreatePile(sys);
+
+    while (sys.GetChTime() < 0.2)
+        sys.DoStepDynamics(1e-3);
+
+    // Capture the problem of the next step, solved with the solver under test
+    auto solver = chrono_types::make_shared<SOLVER>();
+    solver->SetMaxIterations(50);
+    sys.SetSolver(solver);
+    sys.EnableSolverProblemCapture(true, ".");
+    sys.DoStepDynamics(1e-3);
+    sys.EnableSolverProblemCapture(false);
+
+    std::string filename = "problem_" + std::to_string(sys.GetStepcount()) + "_0.dat";
+
+    ChVectorDynamic<> x_sim;
+    sys.GetSystemDescriptor()->FromUnknownsToVector(x_sim);
+
+    // Read back the captured problem and solve it with a new solver with the same settings
+    ChDescriptorCapture capture;
+    capture.Read(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(capture.GetNumVariables(), 9);
+    ASSERT_EQ(capture.GetNumConstraints(), sys.GetSystemDescriptor()->CountActiveConstraints());
+    ASSERT_GT(capture.GetNumContacts(), 0);
+    ASSERT_EQ(capture.GetNumConstraints(), 3 * capture.GetNumContacts());
+
+    auto replay_solver = chrono_types::make_shared<SOLVER>();
+    replay_solver->SetMaxIterations(50);
+    replay_solver->Setup(capture.GetDescriptor());
+    replay_solver->Solve(capture.GetDescriptor());
+
+    ChVectorDynamic<> x_replay;
+    capture.GetDescriptor().FromUnknownsToVector(x_replay);
+
+    ASSERT_EQ(x_sim.size(), x_replay.size());
+    double scale = x_sim.lpNorm<Eigen::Infinity>();
+    for (int i = 0; i < x_sim.size(); i++)
+        ASSERT_NEAR(x_sim[i], x_replay[i], 1e-6 * scale) << name << " unknown " << i;
+
+    // Solving again from the captured warm start must reproduce the same solution
+    capture.Reset(true);
+    replay_solver->Solve(capture.GetDescriptor());
+    ChVectorDynamic<> x_again;
+    capture.GetDescriptor().FromUnknownsToVector(x_again);
+    ASSERT_TRUE(x_again.isApprox(x_replay));
+}
+
+TEST(ChDescriptorCapture, PSOR) {
+    CheckReplay<ChSolverPSOR>("PSOR");
+}
+
+TEST(ChDescriptorCapture, APGD) {
+    CheckReplay<ChSolverAPGD>("APGD");
+}
+
+TEST(ChDescriptorCapture, BB) {
+    CheckReplay<ChSolverBB>("BB");
+}
@@ -0,0 +1,206 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the deterministic mode. The same models are simulated with a
+// different number of threads and the results must be bit-for-bit identical.
+// - pile of boxes with SMC contact (contact force accumulation)
+// - pile of boxes with NSC contact and the multithreaded PSOR solver
+// - plate of ANCF shell elements (mesh internal force accumulation)
+// The piles of boxes are simulated with the Bullet collision system and, if
+// available, with the Chrono collision system (grid broadphase for SMC; AABB
+// tree broadphase and contact persistence for NSC).
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/ChConfig.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "chrono/fea/ChElementShellANCF_3423.h"
+#include "chrono/fea/ChMesh.h"
+
+#ifdef CHRONO_COLLISION
+    #include "chrono/collision/ChCollisionSystemChrono.h"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace chrono::collision;
+
+// Set the collision system of the given type. With the Chrono collision system, use the given broadphase method and
+// enable contact persistence if requested. Collision detection uses the same number of threads as the system.
+static void SetCollisionSystem(ChSystem& sys,
+                               int nthreads,
+                               ChCollisionSystemType type,
+                               bool tree_broadphase,
+                               bool persistence) {
+#ifdef CHRONO_COLLISION
+    if (type == ChCollisionSystemType::CHRONO) {
+        auto coll = chrono_types::make_shared<ChCollisionSystemChrono>();
+        coll->SetBroadphaseGridResolution(ChVector<int>(4, 2, 4));
+        if (tree_broadphase)
+            coll->SetBroadphaseMethod(ChBroadphase::Method::AABB_TREE);
+        coll->EnableContactPersistence(persistence);
+        sys.SetCollisionSystem(coll);
+        sys.SetNumThreads(nthreads, nthreads, 1);
+        return;
+    }
+#endif
+    sys.SetNumThreads(nthreads, 1, 1);
+}
+
+static void CreatePile(ChSystem& sys, std::shared_ptr<ChMaterialSurface> mat, ChCollisionSystemType type) {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, mat, type);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int ix = 0; ix < 3; ix++) {
+        for (int iy = 0; iy < 3; iy++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.2, 0.2, 1000, mat, type);
+            box->SetPos(ChVector<>(-0.25 + 0.25 * ix + 0.02 * iy, 0.1 + 0.21 * iy, 0.01 * ix));
+            box->SetRot(Q_from_AngY(0.1 * (ix + iy)));
+            sys.AddBody(box);
+        }
+    }
+}
+
+static ChVectorDynamic<> SimulatePileSMC(int nthreads, ChCollisionSystemType type) {
+    ChSystemSMC sys;
+    SetCollisionSystem(sys, nthreads, type, false, false);
+    sys.EnableDeterministicMode(true);
+    CreatePile(sys, chrono_types::make_shared<ChMaterialSurfaceSMC>(), type);
+
+    while (sys.GetChTime() < 0.1)
+        sys.DoStepDynamics(1e-4);
+
+    ChState x(sys.GetNcoords_x(), &sys);
+    ChStateDelta v(sys.GetNcoords_w(), &sys);
+    double t;
+    sys.StateGather(x, v, t);
+    return x;
+}
+
+static ChVectorDynamic<> SimulatePileNSC(int nthreads, ChCollisionSystemType type) {
+    ChSystemNSC sys;
+    SetCollisionSystem(sys, nthreads, type, true, true);
+    sys.EnableDeterministicMode(true);
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(50);
+    solver->EnableMultithreading(true);
+    solver->EnableWarmStart(true);
+    sys.SetSolver(solver);
+    CreatePile(sys, chrono_types::make_shared<ChMaterialSurfaceNSC>(), type);
+
+    while (sys.GetChTime() < 0.2)
+        sys.DoStepDynamics(1e-3);
+
+    ChState x(sys.GetNcoords_x(), &sys);
+    ChStateDelta v(sys.GetNcoords_w(), &sys);
+    double t;
+    sys.StateGather(x, v, t);
+    return x;
+}
+
+static ChVectorDynamic<> SimulatePlate(int nthreads) {
+    ChSystemSMC sys;
+    sys.SetNumThreads(nthreads, 1, 1);
+    sys.EnableDeterministicMode(true);
+    sys.SetSolver(chrono_types::make_shared<ChSolverMINRES>());
+
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(500, 2.1e7, 0.3);
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    sys.Add(mesh);
+
+    int N = 8;
+    double dx = 1.0 / N;
+    std::vector<std::shared_ptr<ChNodeFEAxyzD>> nodes;
+    for (int iz = 0; iz <= N; iz++) {
+        for (int ix = 0; ix <= N; ix++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(ix * dx, 0, iz * dx), ChVector<>(0, 1, 0));
+            node->SetFixed(ix == 0);
+            mesh->AddNode(node);
+            nodes.push_back(node);
+        }
+    }
+    for (int iz = 0; iz < N; iz++) {
+        for (int ix = 0; ix < N; ix++) {
+            int n0 = iz * (N + 1) + ix;
+            auto element = chrono_types::make_shared<ChElementShellANCF_3423>();
+            element->SetNodes(nodes[n0], nodes[n0 + N + 1], nodes[n0 + N + 2], nodes[n0 + 1]);
+            element->SetDimensions(dx, dx);
+            element->AddLayer(0.01, 0, mat);
+            element->SetAlphaDamp(0.01);
+            mesh->AddElement(element);
+        }
+    }
+
+    for (int i = 0; i < 20; i++)
+        sys.DoStepDynamics(1e-3);
+
+    ChState x(sys.GetNcoords_x(), &sys);
+    ChStateDelta v(sys.GetNcoords_w(), &sys);
+    double t;
+    sys.StateGather(x, v, t);
+    return x;
+}
+
+static void CheckIdentical(const ChVectorDynamic<>& x1, const ChVectorDynamic<>& x2) {
+    ASSERT_EQ(x1.size(), x2.size());
+    for (int i = 0; i < x1.size(); i++)
+        ASSERT_EQ(x1[i], x2[i]) << "coordinate " << i;
+}
+
+TEST(ChSystem, deterministic_SMC) {
+    auto x1 = SimulatePileSMC(1, ChCollisionSystemType::BULLET);
+    auto x4 = SimulatePileSMC(4, ChCollisionSystemType::BULLET);
+    CheckIdentical(x1, x4);
+}
+
+TEST(ChSystem, deterministic_PSOR) {
+    auto x1 = SimulatePileNSC(1, ChCollisionSystemType::BULLET);
+    auto x4 = SimulatePileNSC(4, ChCollisionSystemType::BULLET);
+    CheckIdentical(x1, x4);
+}
+
+#ifdef CHRONO_COLLISION
+
+TEST(ChSystem, deterministic_SMC_chrono_collision) {
+    auto x1 = SimulatePileSMC(1, ChCollisionSystemType::CHRONO);
+    auto x4 = SimulatePileSMC(4, ChCollisionSystemType::CHRONO);
+    CheckIdentical(x1, x4);
+}
+
+TEST(ChSystem, deterministic_PSOR_chrono_collision) {
+    auto x1 = SimulatePileNSC(1, ChCollisionSystemType::CHRONO);
+    auto x4 = SimulatePileNSC(4, ChCollisionSystemType::CHRONO);
+    CheckIdentical(x1, x4);
+}
+
+#endif
+
+TEST(ChSystem, deterministic_mesh) {
+    auto x1 = SimulatePlate(1);
+    auto x4 = SimulatePlate(4);
+    CheckIdentical(x1, x4);
+}
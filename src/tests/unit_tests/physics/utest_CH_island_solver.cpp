@@ -0,0 +1,108 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the island solver. A system with several independent pendulum
+// chains attached to ground and one free body is simulated with the PSOR solver
+// applied to the entire system descriptor and to each island separately. With a
+// fixed number of solver iterations, the Gauss-Seidel sweeps over independent
+// islands are equivalent and the results must match.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static const int num_chains = 5;
+static const int num_links = 4;
+
+static std::vector<ChVector<>> Simulate(bool islands, int nthreads) {
+    ChSystemNSC sys;
+    sys.SetNumThreads(nthreads);
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.EnableIslandSolver(islands);
+
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(100);
+    solver->SetTolerance(0);
+    sys.SetSolver(solver);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int ic = 0; ic < num_chains; ic++) {
+        auto prev = ground;
+        for (int il = 0; il < num_links; il++) {
+            auto body = chrono_types::make_shared<ChBody>();
+            body->SetPos(ChVector<>(il + 1.0, 0, 2.0 * ic));
+            body->SetMass(1.0 + 0.1 * ic);
+            sys.AddBody(body);
+
+            auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+            joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(il + 0.5, 0, 2.0 * ic)));
+            sys.AddLink(joint);
+
+            prev = body;
+        }
+    }
+
+    auto free_body = chrono_types::make_shared<ChBody>();
+    free_body->SetPos(ChVector<>(0, 5, 0));
+    free_body->SetWvel_loc(ChVector<>(0, 1, 0));
+    sys.AddBody(free_body);
+
+    for (int i = 0; i < 100; i++) {
+        sys.DoStepDynamics(1e-3);
+        if (islands) {
+            // one island per chain, plus one island for the free body
+            EXPECT_EQ(sys.GetNumIslands(), num_chains + 1);
+        } else {
+            EXPECT_EQ(sys.GetNumIslands(), 0);
+        }
+    }
+
+    std::vector<ChVector<>> pos;
+    for (const auto& body : sys.Get_bodylist())
+        pos.push_back(body->GetPos());
+
+    return pos;
+}
+
+static void Compare(const std::vector<ChVector<>>& ref, const std::vector<ChVector<>>& pos) {
+    ASSERT_EQ(ref.size(), pos.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        ASSERT_NEAR(ref[i].x(), pos[i].x(), 1e-10);
+        ASSERT_NEAR(ref[i].y(), pos[i].y(), 1e-10);
+        ASSERT_NEAR(ref[i].z(), pos[i].z(), 1e-10);
+    }
+}
+
+TEST(ChSystem, island_solver) {
+    auto ref = Simulate(false, 1);
+    auto pos = Simulate(true, 1);
+    Compare(ref, pos);
+}
+
+TEST(ChSystem, island_solver_multithreaded) {
+    auto ref = Simulate(false, 1);
+    auto pos = Simulate(true, 4);
+    Compare(ref, pos);
+}
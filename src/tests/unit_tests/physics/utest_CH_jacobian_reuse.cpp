@@ -0,0 +1,110 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for reusing the Newton matrix across steps (AUTOMATIC Jacobian
+// update policy) in the HHT and Euler implicit integrators. A triple pendulum
+// is simulated with the default policy and with Jacobian reuse; results must
+// agree up to the Newton tolerance, while the number of factorizations in the
+// direct linear solver must decrease.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+using JacobianUpdate = ChImplicitIterativeTimestepper::JacobianUpdate;
+
+struct PendulumResults {
+    std::vector<ChVector<>> pos;
+    int num_setups;
+    int num_reuses;
+};
+
+template <typename Integrator>
+static PendulumResults SimulatePendulum(std::shared_ptr<Integrator> integrator, JacobianUpdate method) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto solver = chrono_types::make_shared<ChSolverSparseLU>();
+    sys.SetSolver(solver);
+
+    integrator->SetIntegrable(&sys);
+    integrator->SetJacobianUpdateMethod(method);
+    integrator->SetMaxiters(20);
+    integrator->SetRelTolerance(1e-6);
+    integrator->SetAbsTolerances(1e-8);
+    sys.SetTimestepper(integrator);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> links;
+    auto prev = ground;
+    for (int i = 0; i < 3; i++) {
+        auto link = chrono_types::make_shared<ChBody>();
+        link->SetPos(ChVector<>(i + 0.5, 0, 0));
+        link->SetMass(1);
+        link->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        sys.AddBody(link);
+        links.push_back(link);
+
+        auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(prev, link, ChCoordsys<>(ChVector<>(i, 0, 0)));
+        sys.AddLink(joint);
+
+        prev = link;
+    }
+
+    while (sys.GetChTime() < 1.0)
+        sys.DoStepDynamics(1e-3);
+
+    PendulumResults res;
+    for (const auto& link : links)
+        res.pos.push_back(link->GetPos());
+    res.num_setups = solver->GetNumSetupCalls();
+    res.num_reuses = solver->GetNumFactorizationReuses();
+
+    return res;
+}
+
+template <typename Integrator>
+static void CheckReuse(JacobianUpdate ref_method) {
+    auto ref = SimulatePendulum(chrono_types::make_shared<Integrator>(), ref_method);
+    auto reuse = SimulatePendulum(chrono_types::make_shared<Integrator>(), JacobianUpdate::AUTOMATIC);
+
+    ASSERT_LT(reuse.num_setups, ref.num_setups);
+    ASSERT_GT(reuse.num_reuses, 0);
+
+    for (size_t i = 0; i < ref.pos.size(); i++) {
+        ASSERT_NEAR(ref.pos[i].x(), reuse.pos[i].x(), 1e-4);
+        ASSERT_NEAR(ref.pos[i].y(), reuse.pos[i].y(), 1e-4);
+    }
+}
+
+TEST(ChTimestepper, jacobian_reuse_HHT) {
+    CheckReuse<ChTimestepperHHT>(JacobianUpdate::EVERY_STEP);
+}
+
+TEST(ChTimestepper, jacobian_reuse_EulerImplicit) {
+    CheckReuse<ChTimestepperEulerImplicit>(JacobianUpdate::EVERY_ITERATION);
+}
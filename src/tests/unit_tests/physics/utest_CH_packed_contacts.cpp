@@ -0,0 +1,113 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the packed body-body contact kernels used by the PSOR, APGD and
+// BB solvers. A pile of boxes (with one fixed body, so that some contacts have
+// inactive variables) is settled with PSOR; a few steps are then taken with the
+// solver under test, with and without packed contacts, and the multipliers and
+// body states must agree up to round-off. A pile with rolling friction (whose
+// contacts must not be packed) is also checked with the PSOR solver.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverAPGD.h"
+#include "chrono/solver/ChSolverBB.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static ChVectorDynamic<> SolvePile(std::shared_ptr<ChIterativeSolverVI> solver, bool packed, bool rolling) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+    if (rolling) {
+        mat->SetRollingFriction(0.01f);
+        mat->SetSpinningFriction(0.01f);
+    }
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int ix = 0; ix < 3; ix++) {
+        for (int iy = 0; iy < 3; iy++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.2, 0.2, 1000, false, true, mat);
+            box->SetPos(ChVector<>(-0.25 + 0.25 * ix + 0.02 * iy, 0.1 + 0.21 * iy, 0.01 * ix));
+            box->SetRot(Q_from_AngY(0.1 * (ix + iy)));
+            sys.AddBody(box);
+        }
+    }
+
+    // Settle the pile with the generic PSOR solver
+    auto settle_solver = chrono_types::make_shared<ChSolverPSOR>();
+    settle_solver->SetMaxIterations(50);
+    sys.SetSolver(settle_solver);
+    while (sys.GetChTime() < 0.1)
+        sys.DoStepDynamics(1e-3);
+
+    // Take a few steps with the solver under test
+    solver->SetMaxIterations(50);
+    sys.SetSolver(solver);
+    sys.GetSystemDescriptor()->EnablePackedContacts(packed);
+    for (int i = 0; i < 5; i++)
+        sys.DoStepDynamics(1e-3);
+
+    // Multipliers of the last step, followed by the body states
+    ChVectorDynamic<> l;
+    sys.GetSystemDescriptor()->FromConstraintsToVector(l);
+    ChState x(sys.GetNcoords_x(), &sys);
+    ChStateDelta v(sys.GetNcoords_w(), &sys);
+    double t;
+    sys.StateGather(x, v, t);
+
+    ChVectorDynamic<> result(l.size() + x.size() + v.size());
+    result << l, x, v;
+    return result;
+}
+
+template <typename SOLVER>
+static void CheckPacked(bool rolling = false) {
+    ChVectorDynamic<> res_generic = SolvePile(chrono_types::make_shared<SOLVER>(), false, rolling);
+    ChVectorDynamic<> res_packed = SolvePile(chrono_types::make_shared<SOLVER>(), true, rolling);
+
+    ASSERT_EQ(res_generic.size(), res_packed.size());
+    double scale = res_generic.lpNorm<Eigen::Infinity>();
+    for (int i = 0; i < res_generic.size(); i++)
+        ASSERT_NEAR(res_generic[i], res_packed[i], 1e-10 * scale) << "entry " << i;
+}
+
+TEST(ChPackedContactBlock, PSOR) {
+    CheckPacked<ChSolverPSOR>();
+}
+
+TEST(ChPackedContactBlock, PSOR_rolling) {
+    CheckPacked<ChSolverPSOR>(true);
+}
+
+TEST(ChPackedContactBlock, APGD) {
+    CheckPacked<ChSolverAPGD>();
+}
+
+TEST(ChPackedContactBlock, BB) {
+    CheckPacked<ChSolverBB>();
+}
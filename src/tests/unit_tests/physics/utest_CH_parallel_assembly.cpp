@@ -0,0 +1,80 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the multithreaded assembly of the system matrix in
+// ChSystemDescriptor::ConvertToMatrixForm. The matrix of a long chain of bodies
+// connected by spherical joints is assembled serially and in parallel (both in
+// an empty matrix and in a matrix with a learned sparsity pattern); the results
+// must be identical.
+//
+// =============================================================================
+
+#include "chrono/core/ChSparsityPatternLearner.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static ChSparseMatrix Assemble(ChSystemDescriptor& sysd, int nthreads, bool learn) {
+    sysd.SetNumThreads(nthreads);
+    int n = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
+
+    ChSparseMatrix Z;
+    if (learn) {
+        ChSparsityPatternLearner pattern(n, n);
+        sysd.ConvertToMatrixForm(&pattern, nullptr);
+        pattern.Apply(Z);
+    } else {
+        Z.resize(n, n);
+    }
+    sysd.ConvertToMatrixForm(&Z, nullptr);
+    Z.makeCompressed();
+
+    return Z;
+}
+
+TEST(ChSystemDescriptor, parallel_assembly) {
+    ChSystemNSC sys;
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto prev = ground;
+    for (int i = 0; i < 400; i++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(i + 1.0, 0, 0));
+        body->SetMass(1.0 + 0.01 * i);
+        sys.AddBody(body);
+
+        auto joint = chrono_types::make_shared<ChLinkLockSpherical>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(i + 0.5, 0, 0)));
+        sys.AddLink(joint);
+
+        prev = body;
+    }
+
+    sys.DoStepDynamics(1e-3);
+    auto& sysd = *sys.GetSystemDescriptor();
+
+    for (bool learn : {false, true}) {
+        ChSparseMatrix Z1 = Assemble(sysd, 1, learn);
+        ChSparseMatrix Z4 = Assemble(sysd, 4, learn);
+
+        ASSERT_EQ(Z1.nonZeros(), Z4.nonZeros());
+        ASSERT_EQ((Z1 - Z4).norm(), 0.0);
+    }
+}
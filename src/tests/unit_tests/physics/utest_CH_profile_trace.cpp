@@ -0,0 +1,125 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the ChProfileTrace recorder. Pendulum chains are simulated with
+// the island solver, using multiple threads; the zones recorded during the
+// simulation are checked and exported in the Chrome trace event format.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChProfiler.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+static const int num_chains = 4;
+
+static void CreateChains(ChSystemNSC& sys) {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.SetNumThreads(4);
+    sys.EnableIslandSolver(true);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int ic = 0; ic < num_chains; ic++) {
+        auto prev = ground;
+        for (int il = 0; il < 3; il++) {
+            auto body = chrono_types::make_shared<ChBody>();
+            body->SetPos(ChVector<>(il + 1.0, 0, 2.0 * ic));
+            sys.AddBody(body);
+
+            auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+            joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(il + 0.5, 0, 2.0 * ic)));
+            sys.AddLink(joint);
+
+            prev = body;
+        }
+    }
+}
+
+TEST(ChProfileTrace, zones) {
+    ChSystemNSC sys;
+    CreateChains(sys);
+
+    // Nothing is recorded while the trace is disabled
+    ChProfileTrace::Disable();
+    ChProfileTrace::Clear();
+    sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(ChProfileTrace::GetNumThreads(), 0);
+
+    const int num_steps = 10;
+    ChProfileTrace::Enable();
+    for (int i = 0; i < num_steps; i++)
+        sys.DoStepDynamics(1e-3);
+    ChProfileTrace::Disable();
+
+    ASSERT_GE(ChProfileTrace::GetNumThreads(), 1);
+
+    auto stats = ChProfileTrace::GetStatistics();
+    ASSERT_EQ(stats["System_step"].calls, num_steps);
+    ASSERT_EQ(stats["Integrate_Y"].calls, num_steps);
+    ASSERT_EQ(stats["Solver_solve"].calls, num_steps);
+    ASSERT_EQ(stats["Solver_island"].calls, num_steps * num_chains);
+    ASSERT_GE(stats["System_step"].total, stats["Integrate_Y"].total);
+    ASSERT_GE(stats["System_step"].total, stats["System_step"].max);
+
+    // Zones on the main thread are nested
+    auto events = ChProfileTrace::GetEvents(0);
+    ASSERT_FALSE(events.empty());
+    for (const auto& e : events) {
+        if (std::string(e.name) == "System_step")
+            ASSERT_EQ(e.depth, 0);
+        if (std::string(e.name) == "Integrate_Y")
+            ASSERT_EQ(e.depth, 1);
+        ASSERT_GE(e.duration, 0);
+    }
+
+    // Export
+    const std::string filename = "profile_trace.json";
+    ASSERT_TRUE(ChProfileTrace::WriteChromeTrace(filename));
+    std::ifstream file(filename);
+    std::string header;
+    file >> header;
+    ASSERT_EQ(header.substr(0, 15), "{\"traceEvents\":");
+    file.close();
+    std::remove(filename.c_str());
+}
+
+TEST(ChProfileTrace, ring_buffer) {
+    ChSystemNSC sys;
+    CreateChains(sys);
+    sys.SetNumThreads(1);
+
+    // Only the most recent events are kept
+    ChProfileTrace::Enable(4);
+    for (int i = 0; i < 10; i++)
+        sys.DoStepDynamics(1e-3);
+    ChProfileTrace::Disable();
+
+    auto events = ChProfileTrace::GetEvents(0);
+    ASSERT_EQ(events.size(), 4);
+    ASSERT_EQ(std::string(events.back().name), "System_step");
+    for (size_t i = 1; i < events.size(); i++)
+        ASSERT_GE(events[i].start + events[i].duration, events[i - 1].start + events[i - 1].duration);
+}
@@ -0,0 +1,106 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the multithreaded (graph-colored) PSOR and PJacobi solvers.
+// A pile of spheres is settled on a fixed box. We check that the results of
+// the multithreaded sweep do not depend on the number of threads and that they
+// are consistent with those of the serial sweep.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPJacobi.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Settle a pile of spheres and return the final sphere positions.
+static std::vector<ChVector<>> SettlePile(std::shared_ptr<ChIterativeSolverVI> solver, int nthreads) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.SetNumThreads(nthreads, 1, 1);
+    sys.SetSolver(solver);
+    solver->SetMaxIterations(100);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> spheres;
+    for (int ix = 0; ix < 4; ix++) {
+        for (int iy = 0; iy < 3; iy++) {
+            for (int iz = 0; iz < 4; iz++) {
+                auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.1, 1000, false, true, mat);
+                sphere->SetPos(ChVector<>(-0.3 + 0.21 * ix + 0.01 * iy, 0.1 + 0.21 * iy, -0.3 + 0.21 * iz));
+                sys.AddBody(sphere);
+                spheres.push_back(sphere);
+            }
+        }
+    }
+
+    while (sys.GetChTime() < 0.5)
+        sys.DoStepDynamics(1e-3);
+
+    std::vector<ChVector<>> pos;
+    for (const auto& sphere : spheres)
+        pos.push_back(sphere->GetPos());
+
+    return pos;
+}
+
+template <typename SOLVER>
+static std::shared_ptr<SOLVER> CreateSolver(bool multithreading) {
+    auto solver = chrono_types::make_shared<SOLVER>();
+    solver->EnableMultithreading(multithreading);
+    return solver;
+}
+
+TEST(ChSolverPSOR, multithreaded) {
+    auto pos_serial = SettlePile(CreateSolver<ChSolverPSOR>(false), 1);
+    auto pos_2 = SettlePile(CreateSolver<ChSolverPSOR>(true), 2);
+    auto pos_4 = SettlePile(CreateSolver<ChSolverPSOR>(true), 4);
+
+    for (size_t i = 0; i < pos_serial.size(); i++) {
+        // The colored sweep is independent of the number of threads
+        ASSERT_EQ(pos_2[i].x(), pos_4[i].x());
+        ASSERT_EQ(pos_2[i].y(), pos_4[i].y());
+        ASSERT_EQ(pos_2[i].z(), pos_4[i].z());
+
+        // The colored sweep settles the pile like the serial sweep
+        ASSERT_NEAR(pos_2[i].y(), pos_serial[i].y(), 1e-2);
+    }
+}
+
+TEST(ChSolverPJacobi, multithreaded) {
+    auto pos_serial = SettlePile(CreateSolver<ChSolverPJacobi>(false), 1);
+    auto pos_2 = SettlePile(CreateSolver<ChSolverPJacobi>(true), 2);
+    auto pos_4 = SettlePile(CreateSolver<ChSolverPJacobi>(true), 4);
+
+    for (size_t i = 0; i < pos_serial.size(); i++) {
+        ASSERT_EQ(pos_2[i].x(), pos_4[i].x());
+        ASSERT_EQ(pos_2[i].y(), pos_4[i].y());
+        ASSERT_EQ(pos_2[i].z(), pos_4[i].z());
+
+        ASSERT_NEAR(pos_2[i].y(), pos_serial[i].y(), 1e-2);
+    }
+}
@@ -0,0 +1,91 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for island-level body sleeping. Two separate stacks of boxes settle
+// on a fixed ground box and fall asleep. A force applied to the top box of one
+// stack wakes up that entire stack in the same step (even though no contacts are
+// generated between sleeping boxes), while the other stack remains asleep.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static const int num_levels = 5;  // number of boxes in each stack
+
+TEST(ChSystem, island_sleeping) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.SetUseSleeping(true);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 0.2, 4, 1000, mat, ChCollisionSystemType::BULLET);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::shared_ptr<ChBody> stacks[2][num_levels];
+    for (int is = 0; is < 2; is++) {
+        for (int ib = 0; ib < num_levels; ib++) {
+            auto box =
+                chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.2, 0.4, 1000, mat, ChCollisionSystemType::BULLET);
+            box->SetPos(ChVector<>(-2.0 + 4.0 * is, 0.1 + 0.2 * ib, 0));
+            sys.AddBody(box);
+            stacks[is][ib] = box;
+        }
+    }
+
+    // Let both stacks settle and fall asleep
+    while (sys.GetChTime() < 1.5)
+        sys.DoStepDynamics(1e-3);
+
+    ASSERT_EQ(sys.GetNbodiesSleeping(), 2 * num_levels);
+    ASSERT_EQ(sys.GetNbodies(), 0);
+
+    // Sleeping bodies do not move
+    auto top = num_levels - 1;
+    auto pos = stacks[1][top]->GetPos();
+    for (int i = 0; i < 10; i++)
+        sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(stacks[1][top]->GetPos(), pos);
+
+    // A force on the top box of the first stack wakes up the whole stack, in the same step
+    stacks[0][top]->Accumulate_force(ChVector<>(0.1, 0, 0), stacks[0][top]->GetPos(), false);
+    sys.DoStepDynamics(1e-3);
+
+    for (int ib = 0; ib < num_levels; ib++) {
+        ASSERT_FALSE(stacks[0][ib]->GetSleeping()) << "box " << ib;
+        ASSERT_TRUE(stacks[1][ib]->GetSleeping()) << "box " << ib;
+    }
+    ASSERT_EQ(sys.GetNbodiesSleeping(), num_levels);
+
+    for (int i = 0; i < 5; i++)
+        sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(sys.GetNbodiesSleeping(), num_levels);
+    ASSERT_EQ(stacks[1][top]->GetPos(), pos);
+
+    // Once the force is removed, the first stack comes to rest and falls asleep again
+    stacks[0][top]->Empty_forces_accumulators();
+    while (sys.GetChTime() < 3.0)
+        sys.DoStepDynamics(1e-3);
+
+    ASSERT_EQ(sys.GetNbodiesSleeping(), 2 * num_levels);
+}